@@ -0,0 +1,12 @@
+
+
+#ifndef ARABIC_CONFIG_H
+#define ARABIC_CONFIG_H
+
+/**
+ * @brief Character shown for code points the font does not cover, and for
+ *        letters that could not get a CGRAM slot.
+ */
+#define ARABIC_FALLBACK_CHAR    '?'
+
+#endif /**< ARABIC_CONFIG_H */
@@ -0,0 +1,173 @@
+
+
+#ifndef ARABIC_FONT_H
+#define ARABIC_FONT_H
+
+/**< Generated by tools/glyphc.py from fonts/arabic_5x8.txt, do not edit. */
+
+/**
+ * @brief 105 packed 5x8 glyphs (495 bytes, 840 unpacked), decoded by CGRAM_UnpackGlyph.
+ */
+static const uint8_t ARABIC_PackedGlyphs[495] PROGMEM = {
+    105, 0x01, /**< Glyph count, flags */
+    0x1E, 0x00, 0x47, 0x00, 0x65, 0x00, 0x82, 0x00, /**< Offsets of every 8th glyph */
+    0xA9, 0x00, 0xD0, 0x00, 0xF4, 0x00, 0x10, 0x01,
+    0x36, 0x01, 0x5E, 0x01, 0x83, 0x01, 0xAD, 0x01,
+    0xC9, 0x01, 0xEA, 0x01,
+    0x78, 0x64, 0x1D, 0x80, /**<   0: HAMZA isolated, advance 4 */
+    0x3F, 0x71, 0x08, 0x42, 0x10, /**<   1: ALEF WITH MADDA ABOVE isolated, advance 3 */
+    0x3F, 0x71, 0x08, 0x42, 0x14, /**<   2: ALEF WITH MADDA ABOVE final, advance 4 */
+    0x3F, 0x61, 0x08, 0x42, 0x10, /**<   3: ALEF WITH HAMZA ABOVE isolated, advance 2 */
+    0x3F, 0x61, 0x08, 0x42, 0x14, /**<   4: ALEF WITH HAMZA ABOVE final, advance 4 */
+    0xFA, 0x31, 0x8A, 0x31, 0x30, /**<   5: WAW WITH HAMZA ABOVE isolated, advance 4 */
+    0xBF, 0x21, 0x08, 0x42, 0x11, 0x80, /**<   6: ALEF WITH HAMZA BELOW isolated, advance 2 */
+    0xBF, 0x21, 0x08, 0x42, 0x15, 0x80, /**<   7: ALEF WITH HAMZA BELOW final, advance 4 */
+    0x7E, 0x30, 0xC8, 0x28, 0xB8, /**<   8: YEH WITH HAMZA ABOVE isolated, advance 5 */
+    0x32, 0x31, 0x3C, /**<   9: YEH WITH HAMZA ABOVE initial, advance 4 */
+    0x32, 0x31, 0x3E, /**<  10: YEH WITH HAMZA ABOVE medial, advance 5 */
+    0x3F, 0x21, 0x08, 0x42, 0x10, /**<  11: ALEF isolated, advance 1 */
+    0x3F, 0x21, 0x08, 0x42, 0x14, /**<  12: ALEF final, advance 3 */
+    0xB0, 0x8B, 0x88, /**<  13: BEH isolated, advance 5 */
+    0xB0, 0x8B, 0xC8, /**<  14: BEH final, advance 5 */
+    0xB0, 0x27, 0x88, /**<  15: BEH initial, advance 4 */
+    0xB0, 0x27, 0xC8, /**<  16: BEH medial, advance 5 */
+    0x3D, 0x53, 0x25, 0x26, 0x00, /**<  17: TEH MARBUTA isolated, advance 4 */
+    0x3D, 0x29, 0xD0, 0x93, 0x00, /**<  18: TEH MARBUTA final, advance 4 */
+    0x34, 0x54, 0x5C, /**<  19: TEH isolated, advance 5 */
+    0x34, 0x54, 0x5E, /**<  20: TEH final, advance 5 */
+    0x34, 0x51, 0x3C, /**<  21: TEH initial, advance 4 */
+    0x34, 0x51, 0x3E, /**<  22: TEH medial, advance 5 */
+    0x36, 0x22, 0xA2, 0xE0, /**<  23: THEH isolated, advance 5 */
+    0x36, 0x22, 0xA2, 0xF0, /**<  24: THEH final, advance 5 */
+    0x36, 0x22, 0x89, 0xE0, /**<  25: THEH initial, advance 4 */
+    0x36, 0x22, 0x89, 0xF0, /**<  26: THEH medial, advance 5 */
+    0xFE, 0xE1, 0x11, 0x08, 0x3C, 0x80, /**<  27: JEEM isolated, advance 5 */
+    0xFE, 0xE1, 0x11, 0x08, 0xBC, 0x80, /**<  28: JEEM final, advance 5 */
+    0xBC, 0xE1, 0x11, 0xE2, 0x00, /**<  29: JEEM initial, advance 4 */
+    0xBC, 0xE1, 0x11, 0xF2, 0x00, /**<  30: JEEM medial, advance 5 */
+    0x7E, 0xE1, 0x11, 0x08, 0x3C, /**<  31: HAH isolated, advance 5 */
+    0x7E, 0xE1, 0x11, 0x08, 0xBC, /**<  32: HAH final, advance 5 */
+    0x3C, 0xE1, 0x11, 0xE0, /**<  33: HAH initial, advance 4 */
+    0x3C, 0xE1, 0x11, 0xF0, /**<  34: HAH medial, advance 5 */
+    0x7F, 0x47, 0x08, 0x88, 0x41, 0xE0, /**<  35: KHAH isolated, advance 5 */
+    0x7F, 0x47, 0x08, 0x88, 0x45, 0xE0, /**<  36: KHAH final, advance 5 */
+    0x3D, 0x47, 0x08, 0x8F, 0x00, /**<  37: KHAH initial, advance 4 */
+    0x3D, 0x47, 0x08, 0x8F, 0x80, /**<  38: KHAH medial, advance 5 */
+    0x3C, 0x20, 0x84, 0xE0, /**<  39: DAL isolated, advance 3 */
+    0x3C, 0x20, 0x84, 0xF0, /**<  40: DAL final, advance 4 */
+    0x3D, 0x21, 0x04, 0x27, 0x00, /**<  41: THAL isolated, advance 3 */
+    0x3D, 0x21, 0x04, 0x27, 0x80, /**<  42: THAL final, advance 4 */
+    0xF0, 0x10, 0x89, 0x80, /**<  43: REH isolated, advance 4 */
+    0xF0, 0x10, 0xC9, 0x80, /**<  44: REH final, advance 5 */
+    0xF4, 0x10, 0x84, 0x4C, 0x00, /**<  45: ZAIN isolated, advance 4 */
+    0xF4, 0x10, 0x86, 0x4C, 0x00, /**<  46: ZAIN final, advance 5 */
+    0x78, 0x2D, 0xE2, 0xE0, /**<  47: SEEN isolated, advance 5 */
+    0xE0, 0xF8, 0x98, /**<  48: SEEN initial, advance 5 */
+    0x30, 0xAF, 0xC0, /**<  49: SEEN medial, advance 5 */
+    0x7A, 0x51, 0x6F, 0x17, 0x00, /**<  50: SHEEN isolated, advance 5 */
+    0x32, 0x55, 0x7C, /**<  51: SHEEN initial, advance 5 */
+    0x32, 0x55, 0x7E, /**<  52: SHEEN medial, advance 5 */
+    0xF8, 0x32, 0x7F, 0x07, 0x00, /**<  53: SAD isolated, advance 5 */
+    0x38, 0x32, 0x7C, /**<  54: SAD initial, advance 5 */
+    0x38, 0x32, 0x7E, /**<  55: SAD medial, advance 5 */
+    0xFA, 0x21, 0x93, 0xF8, 0x38, /**<  56: DAD isolated, advance 5 */
+    0x3A, 0x21, 0x93, 0xE0, /**<  57: DAD initial, advance 5 */
+    0x3A, 0x21, 0x93, 0xF0, /**<  58: DAD medial, advance 5 */
+    0x3E, 0x42, 0x1C, 0x97, 0x80, /**<  59: TAH isolated, advance 4 */
+    0x3E, 0x42, 0x1C, 0x9F, 0x00, /**<  60: TAH initial, advance 5 */
+    0x3E, 0x42, 0x1C, 0x9F, 0x80, /**<  61: TAH medial, advance 5 */
+    0x3E, 0x52, 0x1C, 0x97, 0x80, /**<  62: ZAH isolated, advance 4 */
+    0x3E, 0x52, 0x1C, 0x9F, 0x00, /**<  63: ZAH initial, advance 5 */
+    0x3E, 0x52, 0x1C, 0x9F, 0x80, /**<  64: ZAH medial, advance 5 */
+    0xFC, 0x32, 0x0E, 0x88, 0x3C, /**<  65: AIN isolated, advance 5 */
+    0xFC, 0x32, 0x0E, 0x98, 0x3C, /**<  66: AIN final, advance 5 */
+    0x3C, 0x72, 0x89, 0xE0, /**<  67: AIN initial, advance 4 */
+    0x3C, 0x72, 0x89, 0xF0, /**<  68: AIN medial, advance 5 */
+    0xFD, 0x21, 0x90, 0x74, 0x41, 0xE0, /**<  69: GHAIN isolated, advance 5 */
+    0xFD, 0x21, 0x90, 0x74, 0xC1, 0xE0, /**<  70: GHAIN final, advance 5 */
+    0x3D, 0x23, 0x94, 0x4F, 0x00, /**<  71: GHAIN initial, advance 4 */
+    0x3D, 0x23, 0x94, 0x4F, 0x80, /**<  72: GHAIN medial, advance 5 */
+    0x7A, 0x10, 0xE7, 0x17, 0x00, /**<  73: FEH isolated, advance 5 */
+    0x3A, 0x11, 0x8B, 0xE0, /**<  74: FEH initial, advance 5 */
+    0x3A, 0x11, 0x8B, 0xF0, /**<  75: FEH medial, advance 5 */
+    0xFA, 0x29, 0x8D, 0x18, 0xB8, /**<  76: QAF isolated, advance 5 */
+    0x3A, 0x29, 0x8B, 0xE0, /**<  77: QAF initial, advance 5 */
+    0x3A, 0x29, 0x8B, 0xF0, /**<  78: QAF medial, advance 5 */
+    0x7F, 0x08, 0x4A, 0x90, 0xC5, 0xC0, /**<  79: KAF isolated, advance 5 */
+    0x3F, 0x11, 0x04, 0x10, 0xF8, /**<  80: KAF initial, advance 5 */
+    0x3F, 0x11, 0x04, 0x10, 0xFC, /**<  81: KAF medial, advance 5 */
+    0x7F, 0x10, 0x84, 0x29, 0x49, 0x80, /**<  82: LAM isolated, advance 4 */
+    0x7F, 0x10, 0x84, 0x29, 0x4D, 0x80, /**<  83: LAM final, advance 5 */
+    0x3E, 0x10, 0x84, 0x2F, 0x00, /**<  84: LAM initial, advance 4 */
+    0xBE, 0x10, 0xA5, 0x2F, 0x88, /**<  85: LAM medial, advance 5 */
+    0xF8, 0x31, 0xBC, 0x84, 0x00, /**<  86: MEEM isolated, advance 4 */
+    0xF8, 0x31, 0xBE, 0x84, 0x00, /**<  87: MEEM final, advance 5 */
+    0x38, 0x31, 0xBC, /**<  88: MEEM initial, advance 4 */
+    0x38, 0x31, 0xBE, /**<  89: MEEM medial, advance 5 */
+    0x3C, 0x24, 0x62, 0xE0, /**<  90: NOON isolated, advance 5 */
+    0x3C, 0x24, 0x62, 0xF0, /**<  91: NOON final, advance 5 */
+    0x34, 0x21, 0x3C, /**<  92: NOON initial, advance 4 */
+    0x34, 0x21, 0x3E, /**<  93: NOON medial, advance 5 */
+    0x78, 0x64, 0xA4, 0xC0, /**<  94: HEH isolated, advance 4 */
+    0x78, 0x64, 0xA6, 0xC0, /**<  95: HEH final, advance 5 */
+    0x78, 0x22, 0xBC, 0x40, /**<  96: HEH initial, advance 4 */
+    0xF8, 0xC1, 0x3E, 0x4C, 0x00, /**<  97: HEH medial, advance 5 */
+    0xF8, 0x31, 0x46, 0x26, 0x00, /**<  98: WAW isolated, advance 4 */
+    0x7C, 0x19, 0x05, 0x17, 0x00, /**<  99: ALEF MAKSURA isolated, advance 5 */
+    0x30, 0x27, 0x80, /**< 100: ALEF MAKSURA initial, advance 4 */
+    0x30, 0x27, 0xC0, /**< 101: ALEF MAKSURA medial, advance 5 */
+    0xFC, 0x19, 0x05, 0x17, 0x28, /**< 102: YEH isolated, advance 5 */
+    0xB0, 0x27, 0x94, /**< 103: YEH initial, advance 4 */
+    0xF8, 0x0C, 0xBE, 0x28, 0x80 /**< 104: YEH medial, advance 5 */
+};
+
+/**
+ * @brief Joining class and glyph IDs of U+0621 to U+064A, indexed by
+ *        (code point - 0x0621).
+ */
+static const ARABIC_Letter_t ARABIC_Letters[42] PROGMEM = {
+    {ARABIC_JOIN_NONE,  {  0,   0,   0,   0}}, /**< U+0621 HAMZA */
+    {ARABIC_JOIN_RIGHT, {  1,   2,   1,   2}}, /**< U+0622 ALEF WITH MADDA ABOVE */
+    {ARABIC_JOIN_RIGHT, {  3,   4,   3,   4}}, /**< U+0623 ALEF WITH HAMZA ABOVE */
+    {ARABIC_JOIN_RIGHT, {  5,   5,   5,   5}}, /**< U+0624 WAW WITH HAMZA ABOVE */
+    {ARABIC_JOIN_RIGHT, {  6,   7,   6,   7}}, /**< U+0625 ALEF WITH HAMZA BELOW */
+    {ARABIC_JOIN_DUAL,  {  8,   8,   9,  10}}, /**< U+0626 YEH WITH HAMZA ABOVE */
+    {ARABIC_JOIN_RIGHT, { 11,  12,  11,  12}}, /**< U+0627 ALEF */
+    {ARABIC_JOIN_DUAL,  { 13,  14,  15,  16}}, /**< U+0628 BEH */
+    {ARABIC_JOIN_RIGHT, { 17,  18,  17,  18}}, /**< U+0629 TEH MARBUTA */
+    {ARABIC_JOIN_DUAL,  { 19,  20,  21,  22}}, /**< U+062A TEH */
+    {ARABIC_JOIN_DUAL,  { 23,  24,  25,  26}}, /**< U+062B THEH */
+    {ARABIC_JOIN_DUAL,  { 27,  28,  29,  30}}, /**< U+062C JEEM */
+    {ARABIC_JOIN_DUAL,  { 31,  32,  33,  34}}, /**< U+062D HAH */
+    {ARABIC_JOIN_DUAL,  { 35,  36,  37,  38}}, /**< U+062E KHAH */
+    {ARABIC_JOIN_RIGHT, { 39,  40,  39,  40}}, /**< U+062F DAL */
+    {ARABIC_JOIN_RIGHT, { 41,  42,  41,  42}}, /**< U+0630 THAL */
+    {ARABIC_JOIN_RIGHT, { 43,  44,  43,  44}}, /**< U+0631 REH */
+    {ARABIC_JOIN_RIGHT, { 45,  46,  45,  46}}, /**< U+0632 ZAIN */
+    {ARABIC_JOIN_DUAL,  { 47,  47,  48,  49}}, /**< U+0633 SEEN */
+    {ARABIC_JOIN_DUAL,  { 50,  50,  51,  52}}, /**< U+0634 SHEEN */
+    {ARABIC_JOIN_DUAL,  { 53,  53,  54,  55}}, /**< U+0635 SAD */
+    {ARABIC_JOIN_DUAL,  { 56,  56,  57,  58}}, /**< U+0636 DAD */
+    {ARABIC_JOIN_DUAL,  { 59,  59,  60,  61}}, /**< U+0637 TAH */
+    {ARABIC_JOIN_DUAL,  { 62,  62,  63,  64}}, /**< U+0638 ZAH */
+    {ARABIC_JOIN_DUAL,  { 65,  66,  67,  68}}, /**< U+0639 AIN */
+    {ARABIC_JOIN_DUAL,  { 69,  70,  71,  72}}, /**< U+063A GHAIN */
+    {ARABIC_JOIN_NONE,  {255, 255, 255, 255}}, /**< U+063B (not supported) */
+    {ARABIC_JOIN_NONE,  {255, 255, 255, 255}}, /**< U+063C (not supported) */
+    {ARABIC_JOIN_NONE,  {255, 255, 255, 255}}, /**< U+063D (not supported) */
+    {ARABIC_JOIN_NONE,  {255, 255, 255, 255}}, /**< U+063E (not supported) */
+    {ARABIC_JOIN_NONE,  {255, 255, 255, 255}}, /**< U+063F (not supported) */
+    {ARABIC_JOIN_NONE,  {255, 255, 255, 255}}, /**< U+0640 (not supported) */
+    {ARABIC_JOIN_DUAL,  { 73,  73,  74,  75}}, /**< U+0641 FEH */
+    {ARABIC_JOIN_DUAL,  { 76,  76,  77,  78}}, /**< U+0642 QAF */
+    {ARABIC_JOIN_DUAL,  { 79,  79,  80,  81}}, /**< U+0643 KAF */
+    {ARABIC_JOIN_DUAL,  { 82,  83,  84,  85}}, /**< U+0644 LAM */
+    {ARABIC_JOIN_DUAL,  { 86,  87,  88,  89}}, /**< U+0645 MEEM */
+    {ARABIC_JOIN_DUAL,  { 90,  91,  92,  93}}, /**< U+0646 NOON */
+    {ARABIC_JOIN_DUAL,  { 94,  95,  96,  97}}, /**< U+0647 HEH */
+    {ARABIC_JOIN_RIGHT, { 98,  98,  98,  98}}, /**< U+0648 WAW */
+    {ARABIC_JOIN_DUAL,  { 99,  99, 100, 101}}, /**< U+0649 ALEF MAKSURA */
+    {ARABIC_JOIN_DUAL,  {102, 102, 103, 104}}  /**< U+064A YEH */
+};
+
+#endif /**< ARABIC_FONT_H */
@@ -0,0 +1,56 @@
+
+
+#ifndef ARABIC_INTERFACE_H
+#define ARABIC_INTERFACE_H
+
+/**
+ * @brief Initializes the Arabic text engine.
+ *
+ * Sets up the CGRAM cache with the flash-resident Arabic font as its glyph
+ * source. Call it once after LCD_Init.
+ *
+ * @param[in] lcdConfig Pointer to the LCD configuration structure.
+ * @return E_OK on success, E_NOT_OK if lcdConfig is NULL.
+ */
+Std_ReturnType ARABIC_Init(const LCD_Config_t *lcdConfig);
+
+/**
+ * @brief Displays a UTF-8 Arabic string right-to-left.
+ *
+ * Each letter is shaped into its isolated, initial, medial or final form from
+ * its neighbours, and the cells are filled from the given column towards the
+ * left using the controller's decrement entry mode, so the cursor is only
+ * repositioned after a CGRAM upload. Glyphs are loaded into CGRAM on demand
+ * through the CGRAM cache. Numbers and Latin words (ASCII letters and digits,
+ * Arabic-Indic digits shown as ASCII) keep their left-to-right order. Shaping
+ * needs one code point of lookahead, so it runs in a single linear pass
+ * without any buffer.
+ *
+ * Example usage:
+ * @code
+ * ARABIC_Init(&lcd1);
+ * ARABIC_DisplayString(LCD_ROW_1, LCD_COLUMN_16, (const uint8_t *)"سهيلة");
+ * @endcode
+ *
+ * @param[in] row The row (LCD_ROW_1 or LCD_ROW_2).
+ * @param[in] column The rightmost column, where the first logical character goes.
+ * @param[in] text The null-terminated UTF-8 string in SRAM.
+ * @return E_OK if the whole string was shown, E_NOT_OK if it was clipped at
+ *         the left edge, contained characters the font does not cover, or
+ *         needed more than 8 distinct glyphs on screen.
+ */
+Std_ReturnType ARABIC_DisplayString(uint8_t row, uint8_t column, const uint8_t *text);
+
+/**
+ * @brief Displays a UTF-8 Arabic string stored in program memory right-to-left.
+ *
+ * Same as ARABIC_DisplayString, but text is read with pgm_read_byte.
+ *
+ * @param[in] row The row (LCD_ROW_1 or LCD_ROW_2).
+ * @param[in] column The rightmost column, where the first logical character goes.
+ * @param[in] text The null-terminated UTF-8 string in program memory.
+ * @return E_OK if the whole string was shown, E_NOT_OK otherwise.
+ */
+Std_ReturnType ARABIC_DisplayString_P(uint8_t row, uint8_t column, const uint8_t *text);
+
+#endif /**< ARABIC_INTERFACE_H */
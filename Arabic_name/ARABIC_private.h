@@ -0,0 +1,92 @@
+
+
+#ifndef ARABIC_PRIVATE_H
+#define ARABIC_PRIVATE_H
+
+/*****************************< Private Macros *****************************/
+#define _ARABIC_FIRST_LETTER        0x0621  // First code point covered by the font (HAMZA).
+#define _ARABIC_LAST_LETTER         0x064A  // Last code point covered by the font (YEH).
+#define _ARABIC_FIRST_DIGIT         0x0660  // ARABIC-INDIC DIGIT ZERO, shown as ASCII '0'.
+#define _ARABIC_LAST_DIGIT          0x0669  // ARABIC-INDIC DIGIT NINE, shown as ASCII '9'.
+#define _ARABIC_INVALID_CODE_POINT  0xFFFD  // Returned by the UTF-8 decoder for malformed input.
+
+/**
+ * @brief Joining classes of the letters (Unicode ArabicShaping.txt).
+ */
+#define ARABIC_JOIN_NONE            0     // Never connects (HAMZA) or not an Arabic letter.
+#define ARABIC_JOIN_RIGHT           1     // Connects only to the preceding letter (ALEF, DAL, REH, WAW, ...).
+#define ARABIC_JOIN_DUAL            2     // Connects to the preceding and the following letter.
+
+/**
+ * @brief Index of each contextual form in ARABIC_Letter_t.forms.
+ */
+#define _ARABIC_FORM_ISOLATED       0
+#define _ARABIC_FORM_FINAL          1
+#define _ARABIC_FORM_INITIAL        2
+#define _ARABIC_FORM_MEDIAL         3
+
+/*****************************< Private Types *****************************/
+/**
+ * @brief Font entry of one Arabic letter.
+ */
+typedef struct {
+    uint8_t joining;    /**< ARABIC_JOIN_NONE, ARABIC_JOIN_RIGHT or ARABIC_JOIN_DUAL */
+    uint8_t forms[4];   /**< Glyph IDs of the isolated, final, initial and medial forms */
+} ARABIC_Letter_t;
+
+/*****************************< Private function prototypes *****************************/
+/**
+ * @brief Shapes a UTF-8 string and lays it out right-to-left.
+ *
+ * @param[in] row The row to write.
+ * @param[in] column The rightmost column, where the first logical character goes.
+ * @param[in] text The UTF-8 string.
+ * @param[in] fromFlash 1 if text is in program memory, 0 if it is in SRAM.
+ * @return E_OK if everything was shown, E_NOT_OK otherwise.
+ */
+static Std_ReturnType ARABIC_Layout(uint8_t row, uint8_t column, const uint8_t *text, uint8_t fromFlash);
+
+/**
+ * @brief Decodes the next code point of a UTF-8 string and advances past it.
+ *
+ * @param[in,out] text Pointer to the current position in the string.
+ * @param[in] fromFlash 1 if the string is in program memory, 0 if it is in SRAM.
+ * @return The code point, 0 at the end of the string, or _ARABIC_INVALID_CODE_POINT.
+ */
+static u16 ARABIC_NextCodePoint(const uint8_t **text, uint8_t fromFlash);
+
+/**
+ * @brief Measures a left-to-right run (numbers, Latin words) inside Arabic text.
+ *
+ * The run extends over strong left-to-right characters and over the ASCII
+ * neutrals between them; trailing neutrals stay with the Arabic text.
+ *
+ * @param[in] text Pointer to the first code point of the run.
+ * @param[in] fromFlash 1 if the string is in program memory, 0 if it is in SRAM.
+ * @return Number of code points in the run.
+ */
+static uint8_t ARABIC_MeasureLtrRun(const uint8_t *text, uint8_t fromFlash);
+
+/**
+ * @brief Returns 1 for code points written left-to-right (ASCII letters and digits, Arabic-Indic digits).
+ */
+static uint8_t ARABIC_IsLtr(u16 codePoint);
+
+/**
+ * @brief Maps a non-letter code point to the LCD character shown for it.
+ *
+ * @return The ASCII character, or ARABIC_FALLBACK_CHAR if it cannot be shown.
+ */
+static uint8_t ARABIC_ToAscii(u16 codePoint);
+
+/**
+ * @brief Returns the joining class of a code point.
+ */
+static uint8_t ARABIC_GetJoining(u16 codePoint);
+
+/**
+ * @brief Supplies glyph patterns from the flash font to the CGRAM cache.
+ */
+static void ARABIC_GlyphLoader(uint8_t glyphId, uint8_t pattern[8]);
+
+#endif /**< ARABIC_PRIVATE_H */
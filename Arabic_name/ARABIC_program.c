@@ -0,0 +1,272 @@
+
+
+/*****************************< LIB *****************************/
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+#include <avr/pgmspace.h>
+/*****************************< HAL *****************************/
+#include "CLCD_interface.h"
+#include "CGRAM_interface.h"
+#include "ARABIC_interface.h"
+#include "ARABIC_private.h"
+#include "ARABIC_config.h"
+#include "ARABIC_font.h"
+
+/*****************************< Private Variables *****************************/
+static const LCD_Config_t *ARABIC_LcdConfig = NULL; /**< LCD the engine writes to */
+
+/*****************************< Function Implementations *****************************/
+Std_ReturnType ARABIC_Init(const LCD_Config_t *lcdConfig)
+{
+    if (lcdConfig == NULL)
+    {
+        return E_NOT_OK;
+    }
+
+    ARABIC_LcdConfig = lcdConfig;
+
+    return CGRAM_Init(lcdConfig, ARABIC_GlyphLoader);
+}
+
+Std_ReturnType ARABIC_DisplayString(uint8_t row, uint8_t column, const uint8_t *text)
+{
+    return ARABIC_Layout(row, column, text, 0);
+}
+
+Std_ReturnType ARABIC_DisplayString_P(uint8_t row, uint8_t column, const uint8_t *text)
+{
+    return ARABIC_Layout(row, column, text, 1);
+}
+
+/*****************************< Private helper functions *****************************/
+static Std_ReturnType ARABIC_Layout(uint8_t row, uint8_t column, const uint8_t *text, uint8_t fromFlash)
+{
+    Std_ReturnType Local_State = E_OK;
+    uint8_t Local_PreviousIsDual = 0;
+    uint8_t Local_CursorValid = 0;
+    s8 Local_Column = (s8)column;
+    const uint8_t *Local_After;
+    u16 Local_Current;
+
+    if ((ARABIC_LcdConfig == NULL) || (text == NULL))
+    {
+        return E_NOT_OK;
+    }
+
+    /**< The address counter moves left by itself, so cells are written in logical order */
+    LCD_SetTextDirection(ARABIC_LcdConfig, LCD_DIRECTION_RTL);
+
+    while (1)
+    {
+        Local_After = text;
+        Local_Current = ARABIC_NextCodePoint(&Local_After, fromFlash);
+
+        if (Local_Current == 0)
+        {
+            break;
+        }
+        if (Local_Column < 0)
+        {
+            Local_State = E_NOT_OK; /**< Clipped at the left edge */
+            break;
+        }
+
+        if (ARABIC_IsLtr(Local_Current))
+        {
+            /**< Numbers and Latin words keep their left-to-right order inside Arabic text */
+            uint8_t Local_RunLength = ARABIC_MeasureLtrRun(text, fromFlash);
+            s8 Local_RunStart = Local_Column - (s8)Local_RunLength + 1;
+
+            if (Local_RunStart < 0)
+            {
+                Local_State = E_NOT_OK;
+                break;
+            }
+
+            LCD_GoToXYPos(ARABIC_LcdConfig, row, (uint8_t)Local_RunStart);
+            LCD_SetTextDirection(ARABIC_LcdConfig, LCD_DIRECTION_LTR);
+            for (uint8_t i = 0; i < Local_RunLength; i++)
+            {
+                CGRAM_ReleaseCell(row, (uint8_t)(Local_RunStart + i));
+                LCD_SendChar(ARABIC_LcdConfig, ARABIC_ToAscii(ARABIC_NextCodePoint(&text, fromFlash)));
+            }
+            LCD_SetTextDirection(ARABIC_LcdConfig, LCD_DIRECTION_RTL);
+
+            Local_Column = Local_RunStart - 1;
+            Local_CursorValid = 0;
+            Local_PreviousIsDual = 0;
+            continue;
+        }
+
+        uint8_t Local_Joining = ARABIC_GetJoining(Local_Current);
+        uint8_t Local_Character;
+
+        if ((Local_Current >= _ARABIC_FIRST_LETTER) && (Local_Current <= _ARABIC_LAST_LETTER) &&
+            (pgm_read_byte(&ARABIC_Letters[Local_Current - _ARABIC_FIRST_LETTER].forms[0]) != CGRAM_NO_GLYPH))
+        {
+            /**< One code point of lookahead decides whether this letter joins to the next one */
+            const uint8_t *Local_Peek = Local_After;
+            u16 Local_Next = ARABIC_NextCodePoint(&Local_Peek, fromFlash);
+            uint8_t Local_JoinsPrevious = Local_PreviousIsDual && (Local_Joining != ARABIC_JOIN_NONE);
+            uint8_t Local_JoinsNext = (Local_Joining == ARABIC_JOIN_DUAL) &&
+                                      (ARABIC_GetJoining(Local_Next) != ARABIC_JOIN_NONE);
+            uint8_t Local_Form;
+
+            if (Local_JoinsPrevious)
+            {
+                Local_Form = Local_JoinsNext ? _ARABIC_FORM_MEDIAL : _ARABIC_FORM_FINAL;
+            }
+            else
+            {
+                Local_Form = Local_JoinsNext ? _ARABIC_FORM_INITIAL : _ARABIC_FORM_ISOLATED;
+            }
+
+            uint8_t Local_Glyph = pgm_read_byte(&ARABIC_Letters[Local_Current - _ARABIC_FIRST_LETTER].forms[Local_Form]);
+
+            /**< A CGRAM upload moves the address counter away from DDRAM */
+            if (!CGRAM_IsResident(Local_Glyph))
+            {
+                Local_CursorValid = 0;
+            }
+
+            if (CGRAM_AssignCell(row, (uint8_t)Local_Column, Local_Glyph, &Local_Character) != E_OK)
+            {
+                /**< More than 8 distinct glyphs on screen */
+                Local_Character = ARABIC_FALLBACK_CHAR;
+                Local_State = E_NOT_OK;
+            }
+        }
+        else
+        {
+            Local_Character = ARABIC_ToAscii(Local_Current);
+            if (Local_Character == ARABIC_FALLBACK_CHAR)
+            {
+                Local_State = E_NOT_OK;
+            }
+            CGRAM_ReleaseCell(row, (uint8_t)Local_Column);
+        }
+
+        if (!Local_CursorValid)
+        {
+            LCD_GoToXYPos(ARABIC_LcdConfig, row, (uint8_t)Local_Column);
+            Local_CursorValid = 1;
+        }
+        LCD_SendChar(ARABIC_LcdConfig, Local_Character);
+
+        Local_PreviousIsDual = (Local_Joining == ARABIC_JOIN_DUAL);
+        Local_Column--;
+        text = Local_After;
+    }
+
+    LCD_SetTextDirection(ARABIC_LcdConfig, LCD_DIRECTION_LTR);
+
+    return Local_State;
+}
+
+static uint8_t ARABIC_MeasureLtrRun(const uint8_t *text, uint8_t fromFlash)
+{
+    uint8_t Local_Length = 0;
+    uint8_t Local_StrongLength = 0;
+    u16 Local_CodePoint = ARABIC_NextCodePoint(&text, fromFlash);
+
+    /**< Neutrals belong to the run only if another left-to-right character follows them */
+    while (ARABIC_IsLtr(Local_CodePoint) ||
+           ((Local_CodePoint >= ' ') && (Local_CodePoint < 0x7F)))
+    {
+        Local_Length++;
+        if (ARABIC_IsLtr(Local_CodePoint))
+        {
+            Local_StrongLength = Local_Length;
+        }
+        Local_CodePoint = ARABIC_NextCodePoint(&text, fromFlash);
+    }
+
+    return Local_StrongLength;
+}
+
+static uint8_t ARABIC_IsLtr(u16 codePoint)
+{
+    return ((codePoint >= '0') && (codePoint <= '9')) ||
+           ((codePoint >= 'A') && (codePoint <= 'Z')) ||
+           ((codePoint >= 'a') && (codePoint <= 'z')) ||
+           ((codePoint >= _ARABIC_FIRST_DIGIT) && (codePoint <= _ARABIC_LAST_DIGIT));
+}
+
+static uint8_t ARABIC_ToAscii(u16 codePoint)
+{
+    if ((codePoint > 0) && (codePoint < 0x80))
+    {
+        return (uint8_t)codePoint;
+    }
+    else if ((codePoint >= _ARABIC_FIRST_DIGIT) && (codePoint <= _ARABIC_LAST_DIGIT))
+    {
+        return '0' + (uint8_t)(codePoint - _ARABIC_FIRST_DIGIT);
+    }
+
+    return ARABIC_FALLBACK_CHAR;
+}
+
+static u16 ARABIC_NextCodePoint(const uint8_t **text, uint8_t fromFlash)
+{
+    const uint8_t *Local_Text = *text;
+    uint8_t Local_Bytes[3];
+    uint8_t Local_Length;
+    u16 Local_CodePoint;
+
+    Local_Bytes[0] = fromFlash ? pgm_read_byte(Local_Text) : *Local_Text;
+
+    if (Local_Bytes[0] == '\0')
+    {
+        return 0; /**< End of string, do not advance */
+    }
+    else if (Local_Bytes[0] < 0x80)
+    {
+        *text = Local_Text + 1;
+        return Local_Bytes[0];
+    }
+    else if ((Local_Bytes[0] & 0xE0) == 0xC0)
+    {
+        Local_Length = 2;
+        Local_CodePoint = Local_Bytes[0] & 0x1F;
+    }
+    else if ((Local_Bytes[0] & 0xF0) == 0xE0)
+    {
+        Local_Length = 3;
+        Local_CodePoint = Local_Bytes[0] & 0x0F;
+    }
+    else
+    {
+        *text = Local_Text + 1;
+        return _ARABIC_INVALID_CODE_POINT; /**< Stray continuation byte or 4-byte sequence */
+    }
+
+    for (uint8_t i = 1; i < Local_Length; i++)
+    {
+        Local_Bytes[i] = fromFlash ? pgm_read_byte(Local_Text + i) : Local_Text[i];
+
+        if ((Local_Bytes[i] & 0xC0) != 0x80)
+        {
+            *text = Local_Text + i; /**< Truncated sequence, resume at the offending byte */
+            return _ARABIC_INVALID_CODE_POINT;
+        }
+        Local_CodePoint = (Local_CodePoint << 6) | (Local_Bytes[i] & 0x3F);
+    }
+
+    *text = Local_Text + Local_Length;
+    return Local_CodePoint;
+}
+
+static uint8_t ARABIC_GetJoining(u16 codePoint)
+{
+    if ((codePoint < _ARABIC_FIRST_LETTER) || (codePoint > _ARABIC_LAST_LETTER))
+    {
+        return ARABIC_JOIN_NONE;
+    }
+
+    return pgm_read_byte(&ARABIC_Letters[codePoint - _ARABIC_FIRST_LETTER].joining);
+}
+
+static void ARABIC_GlyphLoader(uint8_t glyphId, uint8_t pattern[8])
+{
+    CGRAM_UnpackGlyph(ARABIC_PackedGlyphs, glyphId, pattern);
+}
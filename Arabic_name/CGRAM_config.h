@@ -0,0 +1,16 @@
+
+
+#ifndef CGRAM_CONFIG_H
+#define CGRAM_CONFIG_H
+
+/**
+ * @brief Number of display rows tracked by the on-screen glyph map.
+ */
+#define CGRAM_SCREEN_ROWS       2
+
+/**
+ * @brief Number of display columns tracked by the on-screen glyph map.
+ */
+#define CGRAM_SCREEN_COLUMNS    16
+
+#endif /**< CGRAM_CONFIG_H */
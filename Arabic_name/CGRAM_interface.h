@@ -0,0 +1,159 @@
+
+
+#ifndef CGRAM_INTERFACE_H
+#define CGRAM_INTERFACE_H
+
+/**
+ * @brief Glyph ID meaning "no glyph".
+ */
+#define CGRAM_NO_GLYPH          0xFF
+
+/**
+ * @brief Callback that supplies the 5x8 pattern of a glyph.
+ *
+ * The cache calls it only on a miss, so the pattern can come from any source:
+ * a PROGMEM table, a packed font, a generated header, ...
+ *
+ * @param[in] glyphId The glyph being loaded.
+ * @param[out] pattern The 8 pattern rows of the glyph.
+ */
+typedef void (*CGRAM_GlyphLoader_t)(uint8_t glyphId, uint8_t pattern[8]);
+
+/**
+ * @brief Hit/miss counters of the CGRAM cache.
+ */
+typedef struct {
+    u16 hits;       /**< Requests served by a glyph that was already resident */
+    u16 misses;     /**< Requests that uploaded a glyph into CGRAM */
+    u16 evictions;  /**< Misses that replaced a previously loaded glyph */
+    u16 failures;   /**< Requests refused because all 8 slots were on screen */
+} CGRAM_Stats_t;
+
+/**
+ * @brief Initializes the CGRAM cache.
+ *
+ * Forgets every resident glyph, clears the on-screen glyph map and the
+ * statistics. Call it after LCD_Init and whenever CGRAM was written behind the
+ * cache's back.
+ *
+ * @param[in] lcdConfig Pointer to the LCD configuration structure.
+ * @param[in] loader Callback returning the pattern of a glyph ID.
+ * @return E_OK on success, E_NOT_OK if an argument is NULL.
+ */
+Std_ReturnType CGRAM_Init(const LCD_Config_t *lcdConfig, CGRAM_GlyphLoader_t loader);
+
+/**
+ * @brief Makes a glyph resident in CGRAM and takes a reference on it.
+ *
+ * If the glyph is already loaded no LCD traffic happens (hit). Otherwise it is
+ * uploaded with LCD_DefineCustomChar into an empty slot or into the least
+ * recently used slot that no cell on screen refers to (miss). A miss leaves the
+ * LCD address counter in CGRAM, so reposition the cursor before writing text.
+ *
+ * Every successful call must be balanced by CGRAM_Release. CGRAM_PutGlyph does
+ * this bookkeeping automatically per screen cell.
+ *
+ * @param[in] glyphId The glyph to load.
+ * @param[out] slot The character code (0-7) to send to DDRAM for this glyph.
+ * @return E_OK on success, E_NOT_OK if every slot is referenced on screen or
+ *         an argument is invalid.
+ */
+Std_ReturnType CGRAM_Acquire(uint8_t glyphId, uint8_t *slot);
+
+/**
+ * @brief Drops a reference taken with CGRAM_Acquire.
+ *
+ * The glyph stays resident, so acquiring it again later is a hit, but its slot
+ * becomes a candidate for eviction once no references remain.
+ *
+ * @param[in] slot The slot returned by CGRAM_Acquire.
+ */
+void CGRAM_Release(uint8_t slot);
+
+/**
+ * @brief Shows a glyph at a screen position.
+ *
+ * Releases the glyph previously shown in that cell, acquires the new one and
+ * writes its slot code to DDRAM.
+ *
+ * @param[in] row The row (LCD_ROW_1 or LCD_ROW_2).
+ * @param[in] column The column (LCD_COLUMN_1 to LCD_COLUMN_16).
+ * @param[in] glyphId The glyph to show.
+ * @return E_OK on success, E_NOT_OK if the position is outside the screen or no
+ *         slot could be freed.
+ */
+Std_ReturnType CGRAM_PutGlyph(uint8_t row, uint8_t column, uint8_t glyphId);
+
+/**
+ * @brief Records that a cell is about to show a glyph, without writing DDRAM.
+ *
+ * Does the same bookkeeping as CGRAM_PutGlyph but leaves the DDRAM write to the
+ * caller, so text can be streamed without repositioning the cursor for every
+ * cell. Use CGRAM_IsResident beforehand to know whether the call will upload
+ * to CGRAM and therefore move the LCD address counter.
+ *
+ * @param[in] row The row (LCD_ROW_1 or LCD_ROW_2).
+ * @param[in] column The column (LCD_COLUMN_1 to LCD_COLUMN_16).
+ * @param[in] glyphId The glyph the cell will show.
+ * @param[out] slot The character code (0-7) to write to the cell.
+ * @return E_OK on success, E_NOT_OK if the position is outside the screen or no
+ *         slot could be freed.
+ */
+Std_ReturnType CGRAM_AssignCell(uint8_t row, uint8_t column, uint8_t glyphId, uint8_t *slot);
+
+/**
+ * @brief Checks whether a glyph is currently loaded in CGRAM.
+ *
+ * @param[in] glyphId The glyph to look up.
+ * @return 1 if acquiring the glyph would be a hit, 0 if it would upload.
+ */
+uint8_t CGRAM_IsResident(uint8_t glyphId);
+
+/**
+ * @brief Tells the cache that a cell no longer shows a glyph.
+ *
+ * Call it when plain text overwrites a cell written by CGRAM_PutGlyph.
+ *
+ * @param[in] row The row (LCD_ROW_1 or LCD_ROW_2).
+ * @param[in] column The column (LCD_COLUMN_1 to LCD_COLUMN_16).
+ */
+void CGRAM_ReleaseCell(uint8_t row, uint8_t column);
+
+/**
+ * @brief Tells the cache that the whole screen was cleared (e.g. LCD_Clear).
+ *
+ * All on-screen references are dropped but the glyphs stay resident, so
+ * redrawing the same text afterwards costs no CGRAM uploads.
+ */
+void CGRAM_ReleaseScreen(void);
+
+/**
+ * @brief Decodes one glyph of a packed flash font into its 8 pattern rows.
+ *
+ * Packed fonts are produced by tools/glyphc.py. Rows are stored as 5-bit
+ * fields instead of full bytes and, unless the font was compiled with
+ * --fixed, blank rows are skipped through a per-glyph row mask. A masked font
+ * keeps the offset of every 8th glyph, so at most 7 records are skipped to
+ * reach a glyph. Meant to be called from a CGRAM_GlyphLoader_t.
+ *
+ * @param[in] font Pointer to the packed font in program memory.
+ * @param[in] glyphId The glyph to decode.
+ * @param[out] pattern The 8 pattern rows of the glyph.
+ * @return E_OK on success, E_NOT_OK if the glyph is not in the font or an
+ *         argument is NULL.
+ */
+Std_ReturnType CGRAM_UnpackGlyph(const uint8_t *font, uint8_t glyphId, uint8_t pattern[8]);
+
+/**
+ * @brief Reads the hit/miss counters.
+ *
+ * @param[out] stats Where the counters are copied.
+ */
+void CGRAM_GetStats(CGRAM_Stats_t *stats);
+
+/**
+ * @brief Resets the hit/miss counters to zero.
+ */
+void CGRAM_ResetStats(void);
+
+#endif /**< CGRAM_INTERFACE_H */
@@ -0,0 +1,42 @@
+
+
+#ifndef CGRAM_PRIVATE_H
+#define CGRAM_PRIVATE_H
+
+/*****************************< Private Macros *****************************/
+#define _CGRAM_SLOTS            8     // Number of custom character slots in the HD44780 CGRAM.
+#define _CGRAM_EMPTY            0xFF  // Marks a slot with no glyph loaded, or a cell showing no glyph.
+#define _CGRAM_PATTERN_ROWS     8     // Rows in a 5x8 character pattern.
+#define _CGRAM_ROW_BITS         5     // Pixels (bits) in a pattern row.
+#define _CGRAM_PACK_HEADER      2     // Glyph count and flags bytes at the start of a packed font.
+#define _CGRAM_PACK_MASKED      0x01  // Flag: glyphs start with a mask of their non-blank rows.
+#define _CGRAM_PACK_BLOCK       8     // Glyphs per entry of a masked font's offset index.
+#define _CGRAM_PACK_FIXED_SIZE  5     // Bytes per glyph in a font without row masks (40 bits).
+
+/*****************************< Private function prototypes *****************************/
+/**
+ * @brief Finds the slot that should receive a glyph which is not resident.
+ *
+ * Empty slots are used first. Otherwise the least recently used slot that is
+ * not referenced by any cell on screen is chosen.
+ *
+ * @return The slot index (0-7), or _CGRAM_EMPTY if every slot is on screen.
+ */
+static uint8_t CGRAM_FindVictimSlot(void);
+
+/**
+ * @brief Drops one on-screen reference from a slot.
+ *
+ * @param[in] slot The slot index (0-7), or _CGRAM_EMPTY to do nothing.
+ */
+static void CGRAM_ReleaseSlot(uint8_t slot);
+
+/**
+ * @brief Returns the size of a masked packed glyph record.
+ *
+ * @param[in] mask The record's first byte, one bit per non-blank row.
+ * @return Bytes in the record, mask byte included.
+ */
+static uint8_t CGRAM_PackedRecordSize(uint8_t mask);
+
+#endif /**< CGRAM_PRIVATE_H */
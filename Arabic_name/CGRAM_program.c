@@ -0,0 +1,288 @@
+
+
+/*****************************< LIB *****************************/
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+#include <avr/pgmspace.h>
+/*****************************< HAL *****************************/
+#include "CLCD_interface.h"
+#include "CGRAM_interface.h"
+#include "CGRAM_private.h"
+#include "CGRAM_config.h"
+
+/*****************************< Private Variables *****************************/
+static const LCD_Config_t *CGRAM_LcdConfig = NULL;           /**< LCD the cache uploads to */
+static CGRAM_GlyphLoader_t CGRAM_Loader = NULL;              /**< Pattern source for misses */
+static uint8_t CGRAM_SlotGlyph[_CGRAM_SLOTS];                /**< Glyph ID loaded in each slot */
+static uint8_t CGRAM_SlotRefCount[_CGRAM_SLOTS];             /**< Number of references (cells on screen) per slot */
+static u16 CGRAM_SlotLastUse[_CGRAM_SLOTS];                  /**< Access stamp of each slot, for LRU */
+static u16 CGRAM_UseCounter = 0;                             /**< Source of access stamps */
+static uint8_t CGRAM_Screen[CGRAM_SCREEN_ROWS][CGRAM_SCREEN_COLUMNS]; /**< Slot shown in each cell */
+static CGRAM_Stats_t CGRAM_Stats;                            /**< Hit/miss counters */
+
+/*****************************< Function Implementations *****************************/
+Std_ReturnType CGRAM_Init(const LCD_Config_t *lcdConfig, CGRAM_GlyphLoader_t loader)
+{
+    if ((lcdConfig == NULL) || (loader == NULL))
+    {
+        return E_NOT_OK;
+    }
+
+    CGRAM_LcdConfig = lcdConfig;
+    CGRAM_Loader = loader;
+
+    for (uint8_t slot = 0; slot < _CGRAM_SLOTS; slot++)
+    {
+        CGRAM_SlotGlyph[slot] = CGRAM_NO_GLYPH;
+        CGRAM_SlotRefCount[slot] = 0;
+        CGRAM_SlotLastUse[slot] = 0;
+    }
+
+    for (uint8_t row = 0; row < CGRAM_SCREEN_ROWS; row++)
+    {
+        for (uint8_t column = 0; column < CGRAM_SCREEN_COLUMNS; column++)
+        {
+            CGRAM_Screen[row][column] = _CGRAM_EMPTY;
+        }
+    }
+
+    CGRAM_UseCounter = 0;
+    CGRAM_ResetStats();
+
+    return E_OK;
+}
+
+Std_ReturnType CGRAM_Acquire(uint8_t glyphId, uint8_t *slot)
+{
+    CustomChar_t Local_Glyph;
+    uint8_t Local_Slot;
+
+    if ((slot == NULL) || (glyphId == CGRAM_NO_GLYPH) || (CGRAM_Loader == NULL))
+    {
+        return E_NOT_OK;
+    }
+
+    /**< Hit: the glyph is already in CGRAM */
+    for (Local_Slot = 0; Local_Slot < _CGRAM_SLOTS; Local_Slot++)
+    {
+        if (CGRAM_SlotGlyph[Local_Slot] == glyphId)
+        {
+            CGRAM_Stats.hits++;
+            break;
+        }
+    }
+
+    /**< Miss: upload it into a free or least recently used slot */
+    if (Local_Slot == _CGRAM_SLOTS)
+    {
+        Local_Slot = CGRAM_FindVictimSlot();
+        if (Local_Slot == _CGRAM_EMPTY)
+        {
+            CGRAM_Stats.failures++;
+            return E_NOT_OK;
+        }
+
+        if (CGRAM_SlotGlyph[Local_Slot] != CGRAM_NO_GLYPH)
+        {
+            CGRAM_Stats.evictions++;
+        }
+        CGRAM_Stats.misses++;
+
+        CGRAM_Loader(glyphId, Local_Glyph.pattern);
+        Local_Glyph.charIndex = Local_Slot;
+        LCD_DefineCustomChar(CGRAM_LcdConfig, &Local_Glyph);
+        CGRAM_SlotGlyph[Local_Slot] = glyphId;
+    }
+
+    CGRAM_SlotRefCount[Local_Slot]++;
+    CGRAM_SlotLastUse[Local_Slot] = ++CGRAM_UseCounter;
+    *slot = Local_Slot;
+
+    return E_OK;
+}
+
+void CGRAM_Release(uint8_t slot)
+{
+    CGRAM_ReleaseSlot(slot);
+}
+
+Std_ReturnType CGRAM_PutGlyph(uint8_t row, uint8_t column, uint8_t glyphId)
+{
+    uint8_t Local_Slot;
+
+    if (CGRAM_AssignCell(row, column, glyphId, &Local_Slot) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    LCD_GoToXYPos(CGRAM_LcdConfig, row, column);
+    LCD_SendChar(CGRAM_LcdConfig, Local_Slot);
+
+    return E_OK;
+}
+
+Std_ReturnType CGRAM_AssignCell(uint8_t row, uint8_t column, uint8_t glyphId, uint8_t *slot)
+{
+    if ((row >= CGRAM_SCREEN_ROWS) || (column >= CGRAM_SCREEN_COLUMNS) || (slot == NULL))
+    {
+        return E_NOT_OK;
+    }
+
+    /**< Release first so the cell's own slot can be reused when CGRAM is full */
+    CGRAM_ReleaseCell(row, column);
+
+    if (CGRAM_Acquire(glyphId, slot) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    CGRAM_Screen[row][column] = *slot;
+
+    return E_OK;
+}
+
+uint8_t CGRAM_IsResident(uint8_t glyphId)
+{
+    for (uint8_t slot = 0; slot < _CGRAM_SLOTS; slot++)
+    {
+        if (CGRAM_SlotGlyph[slot] == glyphId)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void CGRAM_ReleaseCell(uint8_t row, uint8_t column)
+{
+    if ((row < CGRAM_SCREEN_ROWS) && (column < CGRAM_SCREEN_COLUMNS))
+    {
+        CGRAM_ReleaseSlot(CGRAM_Screen[row][column]);
+        CGRAM_Screen[row][column] = _CGRAM_EMPTY;
+    }
+}
+
+void CGRAM_ReleaseScreen(void)
+{
+    for (uint8_t row = 0; row < CGRAM_SCREEN_ROWS; row++)
+    {
+        for (uint8_t column = 0; column < CGRAM_SCREEN_COLUMNS; column++)
+        {
+            CGRAM_ReleaseCell(row, column);
+        }
+    }
+}
+
+Std_ReturnType CGRAM_UnpackGlyph(const uint8_t *font, uint8_t glyphId, uint8_t pattern[8])
+{
+    const uint8_t *Local_Record;
+    uint8_t Local_Mask = 0xFF;      /**< Every row present unless the font says otherwise */
+    u16 Local_Bits = 0;
+    uint8_t Local_BitCount = 0;
+
+    if ((font == NULL) || (pattern == NULL) || (glyphId >= pgm_read_byte(&font[0])))
+    {
+        return E_NOT_OK;
+    }
+
+    if (pgm_read_byte(&font[1]) & _CGRAM_PACK_MASKED)
+    {
+        /**< Jump to the glyph's block, then walk the variable-size records in it */
+        Local_Record = font + pgm_read_word(&font[_CGRAM_PACK_HEADER + 2 * (glyphId / _CGRAM_PACK_BLOCK)]);
+        for (uint8_t skip = glyphId % _CGRAM_PACK_BLOCK; skip > 0; skip--)
+        {
+            Local_Record += CGRAM_PackedRecordSize(pgm_read_byte(Local_Record));
+        }
+        Local_Mask = pgm_read_byte(Local_Record++);
+    }
+    else
+    {
+        Local_Record = font + _CGRAM_PACK_HEADER + (u16)glyphId * _CGRAM_PACK_FIXED_SIZE;
+    }
+
+    for (uint8_t row = 0; row < _CGRAM_PATTERN_ROWS; row++)
+    {
+        if (GET_BIT(Local_Mask, row))
+        {
+            if (Local_BitCount < _CGRAM_ROW_BITS)
+            {
+                Local_Bits = (Local_Bits << 8) | pgm_read_byte(Local_Record++);
+                Local_BitCount += 8;
+            }
+            Local_BitCount -= _CGRAM_ROW_BITS;
+            pattern[row] = (uint8_t)(Local_Bits >> Local_BitCount) & 0x1F;
+        }
+        else
+        {
+            pattern[row] = 0x00;
+        }
+    }
+
+    return E_OK;
+}
+
+void CGRAM_GetStats(CGRAM_Stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = CGRAM_Stats;
+    }
+}
+
+void CGRAM_ResetStats(void)
+{
+    CGRAM_Stats.hits = 0;
+    CGRAM_Stats.misses = 0;
+    CGRAM_Stats.evictions = 0;
+    CGRAM_Stats.failures = 0;
+}
+
+/*****************************< Private helper functions *****************************/
+static uint8_t CGRAM_FindVictimSlot(void)
+{
+    uint8_t Local_Victim = _CGRAM_EMPTY;
+    u16 Local_OldestAge = 0;
+
+    for (uint8_t slot = 0; slot < _CGRAM_SLOTS; slot++)
+    {
+        if (CGRAM_SlotGlyph[slot] == CGRAM_NO_GLYPH)
+        {
+            return slot; /**< Empty slot, nothing gets evicted */
+        }
+
+        if (CGRAM_SlotRefCount[slot] == 0)
+        {
+            /**< Age survives wrap-around of the 16-bit stamp counter */
+            u16 Local_Age = (u16)(CGRAM_UseCounter - CGRAM_SlotLastUse[slot]);
+
+            if ((Local_Victim == _CGRAM_EMPTY) || (Local_Age > Local_OldestAge))
+            {
+                Local_Victim = slot;
+                Local_OldestAge = Local_Age;
+            }
+        }
+    }
+
+    return Local_Victim;
+}
+
+static void CGRAM_ReleaseSlot(uint8_t slot)
+{
+    if ((slot < _CGRAM_SLOTS) && (CGRAM_SlotRefCount[slot] > 0))
+    {
+        CGRAM_SlotRefCount[slot]--;
+    }
+}
+
+static uint8_t CGRAM_PackedRecordSize(uint8_t mask)
+{
+    uint8_t Local_Rows = 0;
+
+    for (; mask != 0; mask >>= 1)
+    {
+        Local_Rows += mask & 1;
+    }
+
+    return 1 + (Local_Rows * _CGRAM_ROW_BITS + 7) / 8;
+}
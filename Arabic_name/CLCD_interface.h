@@ -45,6 +45,14 @@ typedef struct {
     uint8_t charIndex;  /**< Index of the custom character (0-7) */
 } CustomChar_t;
 
+/**
+ * @brief Enum defining the direction the cursor moves after each character.
+ */
+typedef enum {
+    LCD_DIRECTION_LTR = 0, /**< Left-to-right: entry mode increment */
+    LCD_DIRECTION_RTL = 1  /**< Right-to-left: entry mode decrement */
+} LCD_Direction_t;
+
 /**
  * @brief Enum defining LCD operation modes.
  */
@@ -130,6 +138,24 @@ void LCD_SendChar(const LCD_Config_t *config, uint8_t character);
  */
 void LCD_SendString(const LCD_Config_t *config, const uint8_t *string);
 
+/**
+ * @brief Sends a null-terminated string stored in program memory to the LCD.
+ *
+ * Same as LCD_SendString, but the characters are read with pgm_read_byte so the
+ * string can live in flash (PROGMEM / PSTR) instead of being copied to SRAM at
+ * startup.
+ *
+ * Example usage:
+ * @code
+ * LCD_SendString_P(&lcd1, (const uint8_t *)PSTR("Hello"));
+ * @endcode
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] string Pointer to the null-terminated string in program memory.
+ * @note This function assumes that the required GPIO module and LCD character functions have been initialized separately.
+ */
+void LCD_SendString_P(const LCD_Config_t *config, const uint8_t *string);
+
 /**
  * @brief Displays a double-precision floating-point number on the LCD.
  *
@@ -206,6 +232,27 @@ void LCD_SendIntegerPart(const LCD_Config_t *config, s32 number);
  */
 Std_ReturnType LCD_DefineCustomChar(const LCD_Config_t *lcdConfig, const CustomChar_t *customChar);
 
+/**
+ * @brief Defines a custom character stored in program memory on the LCD.
+ *
+ * Same as LCD_DefineCustomChar, but the whole CustomChar_t (pattern and index)
+ * is read from flash with pgm_read_byte, so glyph tables declared with PROGMEM
+ * never occupy SRAM.
+ *
+ * @code
+ * static const CustomChar_t myGlyph PROGMEM = {
+ *     .pattern = {0x00, 0x0A, 0x00, 0x11, 0x0E, 0x00, 0x00, 0x00},
+ *     .charIndex = 0
+ * };
+ * LCD_DefineCustomChar_P(&lcdConfig, &myGlyph);
+ * @endcode
+ *
+ * @param[in] lcdConfig Pointer to the LCD configuration structure.
+ * @param[in] customChar Custom character in program memory.
+ * @return E_OK if the custom character was successfully defined, E_NOT_OK otherwise.
+ */
+Std_ReturnType LCD_DefineCustomChar_P(const LCD_Config_t *lcdConfig, const CustomChar_t *customChar);
+
 /**
  * @brief Displays a custom character on the LCD at a specified position.
  *
@@ -245,5 +292,45 @@ void LCD_Clear(const LCD_Config_t *config);
  */
 void LCD_GoToXYPos(const LCD_Config_t *config, uint8_t row, uint8_t column);
 
+/**
+ * @brief Sets the direction the cursor moves after each character.
+ *
+ * Switches the controller between the increment and decrement entry modes, so
+ * right-to-left text can be streamed in logical order without moving the cursor
+ * by hand. LCD_Init leaves the display in LCD_DIRECTION_LTR.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] direction LCD_DIRECTION_LTR or LCD_DIRECTION_RTL.
+ */
+void LCD_SetTextDirection(const LCD_Config_t *config, LCD_Direction_t direction);
+
+/**
+ * @brief Sends a string in logical order in the given direction.
+ *
+ * For LCD_DIRECTION_LTR the string starts at (row, column) and grows to the
+ * right, like LCD_SendString. For LCD_DIRECTION_RTL it starts at (row, column)
+ * and grows to the left using the decrement entry mode, in one pass. Runs of
+ * ASCII letters and digits inside right-to-left text (numbers, Latin words,
+ * together with the spaces and punctuation between them) keep their
+ * left-to-right visual order: each run is measured, written in increment mode
+ * and skipped over, so only one cursor move per run is needed. The entry mode
+ * is back to LCD_DIRECTION_LTR when the function returns.
+ *
+ * Example usage:
+ * @code
+ * /// CGRAM glyphs 0-4 followed by a number, shown from the right edge
+ * LCD_SendStringDirectional(&lcd1, LCD_ROW_1, LCD_COLUMN_16, (const uint8_t *)"\x04\x03\x02 2024", LCD_DIRECTION_RTL);
+ * @endcode
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] row The row (LCD_ROW_1 or LCD_ROW_2).
+ * @param[in] column The column of the first logical character.
+ * @param[in] string Pointer to the null-terminated string.
+ * @param[in] direction LCD_DIRECTION_LTR or LCD_DIRECTION_RTL.
+ * @return E_OK on success, E_NOT_OK if an argument is invalid or the string
+ *         runs past the edge of the display (the visible part is still written).
+ */
+Std_ReturnType LCD_SendStringDirectional(const LCD_Config_t *config, uint8_t row, uint8_t column, const uint8_t *string, LCD_Direction_t direction);
+
 #endif /**< CLCD_INTERFACE_H */
 
@@ -11,6 +11,8 @@
 #define _LCD_ENTRY_MODE_INC_SHIFT_OFF   0x06  // Sets entry mode to increment cursor position without display shift.
 
 #define _LCD_ENTRY_MODE_INC_SHIFT_ON    0x07  // Sets entry mode to increment cursor position with display shift.
+#define _LCD_ENTRY_MODE_MASK            0xFC  // Bits that identify an entry mode command.
+#define _LCD_ENTRY_MODE_INCREMENT_BIT   1     // I/D bit of the entry mode command, set for increment.
 #define _LCD_CURSOR_MOVE_SHIFT_LEFT     0x10  // Moves cursor/display left without changing DDRAM address.
 #define _LCD_CURSOR_MOVE_SHIFT_RIGHT    0x14  // Moves cursor/display right without changing DDRAM address.
 #define _LCD_DISPLAY_SHIFT_LEFT         0x18  // Shifts the display to the left.
@@ -26,6 +28,18 @@
 #define _LCD_CGRAM_START                0x40  // Start address for Character Generator RAM (CGRAM) in the LCD.
 #define _LCD_DDRAM_START                0x80  // Start address for Display Data RAM (DDRAM) in the LCD.
 
+#define _LCD_COLUMNS                    16    // Number of visible columns per row.
+
+/**
+ * @brief Characters with a strong left-to-right direction inside right-to-left text.
+ */
+#define _LCD_IS_LTR_CHAR(c)   ((((c) >= '0') && ((c) <= '9')) || (((c) >= 'A') && ((c) <= 'Z')) || (((c) >= 'a') && ((c) <= 'z')))
+
+/**
+ * @brief Neutral characters (space and ASCII punctuation) that take the direction of their surroundings.
+ */
+#define _LCD_IS_NEUTRAL_CHAR(c)  (((c) >= ' ') && ((c) < 0x7F) && !_LCD_IS_LTR_CHAR(c))
+
 /*****************************< Private function prototypes *****************************/ 
 /**
  * @brief Sends 4-bit data to the LCD.
@@ -53,5 +67,17 @@ static void HAL_LCD_Send4Bits(const LCD_Config_t *config, uint8_t value);
  */
 static void HAL_LCD_Send8Bits(const LCD_Config_t *config, uint8_t value);
 
+/**
+ * @brief Measures a left-to-right run inside right-to-left text.
+ *
+ * The run starts at a strong LTR character and extends over further LTR
+ * characters and over neutrals that are followed by another LTR character.
+ * Trailing neutrals are left to the surrounding right-to-left text.
+ *
+ * @param[in] string Pointer to the first character of the run.
+ * @return Number of characters in the run.
+ */
+static uint8_t HAL_LCD_MeasureLtrRun(const uint8_t *string);
+
 
 #endif /**< CLCD_PRIVATE_H */
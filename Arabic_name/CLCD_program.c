@@ -6,11 +6,16 @@
 /*****************************< MCAL *****************************/
 #include "DIO_interface.h"
 #include <util/delay.h>
+#include <avr/pgmspace.h>
 /*****************************< HAL *****************************/
 #include "CLCD_interface.h"
 #include "CLCD_private.h"
 #include "CLCD_config.h"
 
+/*****************************< Private Variables *****************************/
+static const LCD_Config_t *LCD_EntryModeOwner = NULL;      /**< Display whose entry mode LCD_EntryMode holds, NULL if none */
+static uint8_t LCD_EntryMode = _LCD_ENTRY_MODE_INC_SHIFT_OFF;  /**< Last entry mode command sent to LCD_EntryModeOwner */
+
 /*****************************< Function Implementations *****************************/
 void LCD_Init(const LCD_Config_t *config) 
 {
@@ -64,6 +69,13 @@ void LCD_Init(const LCD_Config_t *config)
 
 void LCD_SendCommand(const LCD_Config_t *config, uint8_t command) 
 {
+    /**< Remember the entry mode, LCD_DefineCustomChar needs it to restore the text direction */
+    if((command & _LCD_ENTRY_MODE_MASK) == _LCD_ENTRY_MODE_DEC_SHIFT_OFF)
+    {
+        LCD_EntryModeOwner = config;
+        LCD_EntryMode = command;
+    }
+
     /**< Set RS pin to low for command --> RS = 0 */
     DIO_SetPinValue(config->rsPin.LCD_PortId, config->rsPin.LCD_PinId, DIO_LOW);
     /**< Set RW pin to low for write  --> RW = 0 */
@@ -115,6 +127,18 @@ void LCD_SendString(const LCD_Config_t *config, const uint8_t *string)
     }
 }
 
+void LCD_SendString_P(const LCD_Config_t *config, const uint8_t *string) 
+{
+    uint8_t Local_Character = pgm_read_byte(string);
+    
+    while(Local_Character != '\0')
+    {
+        LCD_SendChar(config, Local_Character);
+        string++;
+        Local_Character = pgm_read_byte(string);
+    }
+}
+
 void LCD_SendIntegerPart(const LCD_Config_t *config, s32 number) {
     u8 Local_Integer[11] = {0};
     s8 Local_Counter = 0;
@@ -185,6 +209,13 @@ Std_ReturnType LCD_DefineCustomChar(const LCD_Config_t *lcdConfig, const CustomC
     /**< Calculate the CGRAM address for the custom character */
     uint8_t address = _LCD_CGRAM_START + customChar->charIndex * 8;
 
+    /**< CGRAM rows go to ascending addresses; right-to-left mode would write them backwards into the previous slot */
+    uint8_t modeKnown = (LCD_EntryModeOwner == lcdConfig);
+    uint8_t previousMode = LCD_EntryMode;
+    if (!modeKnown || !GET_BIT(previousMode, _LCD_ENTRY_MODE_INCREMENT_BIT)) {
+        LCD_SendCommand(lcdConfig, _LCD_ENTRY_MODE_INC_SHIFT_OFF);
+    }
+
     /**< Send the command to set CGRAM address */
     LCD_SendCommand(lcdConfig, address);
 
@@ -193,6 +224,51 @@ Std_ReturnType LCD_DefineCustomChar(const LCD_Config_t *lcdConfig, const CustomC
         LCD_SendChar(lcdConfig, customChar->pattern[i]);
     }
 
+    /**< Back to the caller's direction; an unknown one is left at increment */
+    if (modeKnown && !GET_BIT(previousMode, _LCD_ENTRY_MODE_INCREMENT_BIT)) {
+        LCD_SendCommand(lcdConfig, previousMode);
+    }
+
+    return E_OK; /**< Return E_OK to indicate success */
+}
+
+Std_ReturnType LCD_DefineCustomChar_P(const LCD_Config_t *lcdConfig, const CustomChar_t *customChar) {
+    /**<  Check if lcdConfig is NULL */
+    if (lcdConfig == NULL) {
+        return E_NOT_OK; /**< Return E_NOT_OK to indicate failure */
+    }
+
+    /**< Check if customChar is NULL */
+    if (customChar == NULL) {
+        return E_NOT_OK; /**< Return E_NOT_OK to indicate failure */
+    }
+
+    /**< Read the index from program memory and check it is within the range (0-7) */
+    uint8_t charIndex = pgm_read_byte(&customChar->charIndex);
+    if (charIndex > 7) {
+        return E_NOT_OK; /**< Return E_NOT_OK to indicate failure */
+    }
+
+    /**< CGRAM rows go to ascending addresses, as in LCD_DefineCustomChar */
+    uint8_t modeKnown = (LCD_EntryModeOwner == lcdConfig);
+    uint8_t previousMode = LCD_EntryMode;
+    if (!modeKnown || !GET_BIT(previousMode, _LCD_ENTRY_MODE_INCREMENT_BIT)) {
+        LCD_SendCommand(lcdConfig, _LCD_ENTRY_MODE_INC_SHIFT_OFF);
+    }
+
+    /**< Send the command to set CGRAM address */
+    LCD_SendCommand(lcdConfig, _LCD_CGRAM_START + charIndex * 8);
+
+    /**< Stream the pattern data from program memory to CGRAM */
+    for (int i = 0; i < 8; ++i) {
+        LCD_SendChar(lcdConfig, pgm_read_byte(&customChar->pattern[i]));
+    }
+
+    /**< Back to the caller's direction; an unknown one is left at increment */
+    if (modeKnown && !GET_BIT(previousMode, _LCD_ENTRY_MODE_INCREMENT_BIT)) {
+        LCD_SendCommand(lcdConfig, previousMode);
+    }
+
     return E_OK; /**< Return E_OK to indicate success */
 }
 
@@ -260,6 +336,79 @@ void LCD_GoToXYPos(const LCD_Config_t *config, uint8_t row, uint8_t column) {
     }
 }
 
+void LCD_SetTextDirection(const LCD_Config_t *config, LCD_Direction_t direction)
+{
+    if (direction == LCD_DIRECTION_RTL)
+    {
+        LCD_SendCommand(config, _LCD_ENTRY_MODE_DEC_SHIFT_OFF);
+    }
+    else
+    {
+        LCD_SendCommand(config, _LCD_ENTRY_MODE_INC_SHIFT_OFF);
+    }
+}
+
+Std_ReturnType LCD_SendStringDirectional(const LCD_Config_t *config, uint8_t row, uint8_t column, const uint8_t *string, LCD_Direction_t direction)
+{
+    s8 Local_Column = (s8)column;
+
+    if ((config == NULL) || (string == NULL) || (row > 1) || (column >= _LCD_COLUMNS))
+    {
+        return E_NOT_OK;
+    }
+
+    LCD_GoToXYPos(config, row, column);
+
+    if (direction != LCD_DIRECTION_RTL)
+    {
+        LCD_SendString(config, string);
+        return E_OK;
+    }
+
+    LCD_SetTextDirection(config, LCD_DIRECTION_RTL);
+
+    while ((*string != '\0') && (Local_Column >= 0))
+    {
+        if (_LCD_IS_LTR_CHAR(*string))
+        {
+            uint8_t Local_RunLength = HAL_LCD_MeasureLtrRun(string);
+            s8 Local_RunStart = Local_Column - (s8)Local_RunLength + 1;
+
+            if (Local_RunStart < 0)
+            {
+                break; /**< The run does not fit, leave it out */
+            }
+
+            /**< Write the run left-to-right from its leftmost cell, then continue to its left */
+            LCD_GoToXYPos(config, row, (uint8_t)Local_RunStart);
+            LCD_SetTextDirection(config, LCD_DIRECTION_LTR);
+            for (uint8_t i = 0; i < Local_RunLength; i++)
+            {
+                LCD_SendChar(config, *string);
+                string++;
+            }
+            LCD_SetTextDirection(config, LCD_DIRECTION_RTL);
+
+            Local_Column = Local_RunStart - 1;
+            if (Local_Column >= 0)
+            {
+                LCD_GoToXYPos(config, row, (uint8_t)Local_Column);
+            }
+        }
+        else
+        {
+            /**< The address counter decrements by itself */
+            LCD_SendChar(config, *string);
+            string++;
+            Local_Column--;
+        }
+    }
+
+    LCD_SetTextDirection(config, LCD_DIRECTION_LTR);
+
+    return (*string == '\0') ? E_OK : E_NOT_OK;
+}
+
 /*****************************< Private helper function to send 4 bits *****************************/ 
 static void HAL_LCD_Send4Bits(const LCD_Config_t *config, uint8_t value) 
 {
@@ -309,3 +458,21 @@ static void HAL_LCD_Send8Bits(const LCD_Config_t *config, uint8_t value)
     /**< Set the enable pin to low */
     DIO_SetPinValue(config->enablePin.LCD_PortId, config->enablePin.LCD_PinId, DIO_LOW);
 }
+
+/*****************************< Private helper function to measure a left-to-right run *****************************/ 
+static uint8_t HAL_LCD_MeasureLtrRun(const uint8_t *string)
+{
+    uint8_t Local_Length = 0;
+    uint8_t Local_StrongLength = 0;
+
+    while ((_LCD_IS_LTR_CHAR(string[Local_Length])) || (_LCD_IS_NEUTRAL_CHAR(string[Local_Length])))
+    {
+        Local_Length++;
+        if (_LCD_IS_LTR_CHAR(string[Local_Length - 1]))
+        {
+            Local_StrongLength = Local_Length;
+        }
+    }
+
+    return Local_StrongLength;
+}
@@ -4,10 +4,12 @@
 #include "STD_TYPES.h"
 #include "BIT_MATH.h"
 #include "util/delay.h"
+#include <avr/pgmspace.h>
 /*****************************< MCAL *****************************/
 #include "DIO_interface.h"
 /*****************************< HAL *****************************/
 #include "CLCD_interface.h"
+#include "ARABIC_interface.h"
 /*****************************< APP *****************************/
 
 /*****************************< Business Logic *****************************/
@@ -46,43 +48,9 @@ int main(void) {
 	LCD_Clear(&lcd1);
 
 	/**-----------------------< Display "Suhaylla" in Arabic -----------------*/
-	/**---< Define the Arabic characters in Unicode values ---*/
-	/**< Define the CustomChar_t object for each character */
-	CustomChar_t seenChar = {
-		.pattern = {0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x02, 0x0C}, // "س"
-		.charIndex = 0
-	};
-	CustomChar_t hehChar = {
-		.pattern = {0x00, 0x00, 0x00, 0x18, 0x04, 0x1F, 0x04, 0x18},  // "ه"
-		.charIndex = 1
-	};
-	CustomChar_t yehChar = {
-		.pattern = {0x00, 0x00, 0x00, 0x01, 0x12, 0x01F, 0x02, 0x11},  // "ي"
-		.charIndex = 2
-	};
-	CustomChar_t lamChar = {
-		.pattern = {0x00, 0x02, 0x02, 0x12, 0x12, 0x1F, 0x00, 0x02},  // "ل"
-		.charIndex = 3
-	};
-	CustomChar_t tehMarbutaChar = {
-		.pattern = {0x05, 0x00, 0x07, 0x08, 0x09, 0x06, 0x00, 0x00}, // "ة"
-		.charIndex = 4
-	};
-
-	/**< Define the custom characters on the LCD */
-	LCD_DefineCustomChar(&lcd1, &seenChar);
-	LCD_DefineCustomChar(&lcd1, &hehChar);
-	LCD_DefineCustomChar(&lcd1, &yehChar);
-	LCD_DefineCustomChar(&lcd1, &lamChar);
-	LCD_DefineCustomChar(&lcd1, &tehMarbutaChar);
-
-	// Display the characters
-	LCD_GoToXYPos(&lcd1, LCD_ROW_1, LCD_COLUMN_1);
-	LCD_SendChar(&lcd1, 4); /**< Display "ة" */
-	LCD_SendChar(&lcd1, 3); /**< Display "ل" */
-	LCD_SendChar(&lcd1, 2); /**< Display "ي" */
-	LCD_SendChar(&lcd1, 1); /**< Display "ه" */
-	LCD_SendChar(&lcd1, 0); /**< Display "س" */
+	/**< Letters are shaped and placed right-to-left from the right edge, glyphs load on demand */
+	ARABIC_Init(&lcd1);
+	ARABIC_DisplayString_P(LCD_ROW_1, LCD_COLUMN_16, (const uint8_t *)PSTR("سهيلة"));
 	/*****************************< Loop indefinitely *****************************/
 	while(1) {
 
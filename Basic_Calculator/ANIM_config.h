@@ -0,0 +1,14 @@
+
+
+#ifndef ANIM_CONFIG_H_
+#define ANIM_CONFIG_H_
+
+/**
+ * @brief Maximum number of screen cells that show animated glyphs.
+ *
+ * Each cell costs 3 bytes of SRAM and one DDRAM write per frame.
+ */
+#define ANIM_MAX_CELLS          8
+
+
+#endif /**< ANIM_CONFIG_H_ */
@@ -0,0 +1,81 @@
+
+
+#ifndef ANIM_INTERFACE_H_
+#define ANIM_INTERFACE_H_
+
+/**
+ * @brief Maximum number of glyphs in one animation frame (half of CGRAM).
+ */
+#define ANIM_MAX_GLYPHS         4
+
+/**
+ * @brief Description of a custom-character animation.
+ *
+ * The frames live in program memory as frameCount blocks of glyphCount
+ * patterns of 8 rows each, e.g.
+ * @code
+ * static const uint8_t spinnerFrames[4][1][8] PROGMEM = { ... };
+ * ANIM_Animation_t spinner = {&spinnerFrames[0][0][0], 4, 1, 100};
+ * @endcode
+ */
+typedef struct {
+    const uint8_t *frames;  /**< Frame patterns in program memory */
+    uint8_t frameCount;     /**< Number of frames, played in a loop */
+    uint8_t glyphCount;     /**< Glyphs per frame, 1 to ANIM_MAX_GLYPHS */
+    u16 framePeriod;        /**< Timer0 ticks between two frames */
+} ANIM_Animation_t;
+
+/**
+ * @brief Starts an animation.
+ *
+ * CGRAM is split into two banks, slots 0-3 and 4-7. The screen always shows
+ * one bank while the next frame is written into the other one, then the
+ * animated cells are switched over to the new bank through the frame buffer.
+ * A slot is never rewritten while a cell displays it, so frames never tear.
+ * Frame 0 is uploaded here. Add the cells with ANIM_AddCell.
+ *
+ * The animation owns the whole CGRAM until it is stopped, so glyphs defined
+ * before (e.g. the big-digit segments) must be loaded again afterwards.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] animation The animation; it is copied, the frames are not.
+ * @return E_OK on success, E_NOT_OK if an argument is invalid.
+ */
+Std_ReturnType ANIM_Start(const LCD_Config_t *config, const ANIM_Animation_t *animation);
+
+/**
+ * @brief Makes a screen cell show one glyph of the running animation.
+ *
+ * The cell is written to the frame buffer; it appears on the next LCD_Flush or
+ * with the next frame.
+ *
+ * @param[in] x The column.
+ * @param[in] y The row.
+ * @param[in] glyph Which glyph of the frames the cell shows (0 to glyphCount - 1).
+ * @return E_OK on success, E_NOT_OK if no animation runs, the glyph is out of
+ *         range or ANIM_MAX_CELLS cells are already used.
+ */
+Std_ReturnType ANIM_AddCell(uint8_t x, uint8_t y, uint8_t glyph);
+
+/**
+ * @brief Shows the next frame when it is due.
+ *
+ * Call it from the main loop. When framePeriod ticks have passed since the
+ * previous frame, the next frame is uploaded into the hidden bank and the
+ * animated cells are switched to it. A frame costs at most 4 x 8 CGRAM writes
+ * plus one DDRAM write per cell, whatever the rest of the screen shows. The
+ * LCD cursor position is not preserved.
+ *
+ * @return E_OK if a new frame was shown, E_NOT_OK otherwise.
+ */
+Std_ReturnType ANIM_Update(void);
+
+/**
+ * @brief Stops the animation.
+ *
+ * The cells keep showing the last frame until they are overwritten.
+ */
+void ANIM_Stop(void);
+
+
+#endif /**< ANIM_INTERFACE_H_ */
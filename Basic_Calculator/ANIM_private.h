@@ -0,0 +1,30 @@
+
+
+#ifndef ANIM_PRIVATE_H_
+#define ANIM_PRIVATE_H_
+
+/*****************************< Private Macros *****************************/
+#define _ANIM_BANK_SIZE         4     // CGRAM slots per bank: bank 0 is slots 0-3, bank 1 is slots 4-7.
+#define _ANIM_PATTERN_ROWS      8     // Rows of one 5x8 glyph.
+
+/*****************************< Private Types *****************************/
+/**
+ * @brief A screen cell showing one glyph of the running animation.
+ */
+typedef struct {
+    uint8_t x;      /**< Column */
+    uint8_t y;      /**< Row */
+    uint8_t glyph;  /**< Glyph of the frame shown in the cell (0-3) */
+} ANIM_Cell_t;
+
+/*****************************< Private function prototypes *****************************/
+/**
+ * @brief Writes the glyphs of a frame into one CGRAM bank.
+ *
+ * @param[in] frame The frame to upload.
+ * @param[in] bank The bank (0 or 1) to write.
+ */
+static void ANIM_LoadFrame(uint8_t frame, uint8_t bank);
+
+
+#endif /**< ANIM_PRIVATE_H_ */
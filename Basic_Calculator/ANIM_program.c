@@ -0,0 +1,129 @@
+
+
+/*****************************< LIB *****************************/
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+#include <avr/pgmspace.h>
+/*****************************< MCAL *****************************/
+#include "TMR0_interface.h"
+/*****************************< HAL *****************************/
+#include "CLCD_interface.h"
+#include "ANIM_interface.h"
+#include "ANIM_private.h"
+#include "ANIM_config.h"
+
+/*****************************< Private Variables *****************************/
+static const LCD_Config_t *ANIM_LcdConfig = NULL;  /**< LCD the animation runs on, NULL when stopped */
+static ANIM_Animation_t ANIM_Animation;             /**< Running animation */
+static ANIM_Cell_t ANIM_Cells[ANIM_MAX_CELLS];      /**< Animated screen cells */
+static uint8_t ANIM_CellCount = 0;                  /**< Used entries of ANIM_Cells */
+static uint8_t ANIM_Frame = 0;                      /**< Frame currently on screen */
+static uint8_t ANIM_Bank = 0;                       /**< CGRAM bank currently on screen */
+static u32 ANIM_LastFrameTick = 0;                  /**< Tick at which the current frame was due */
+
+/*****************************< Function Implementations *****************************/
+Std_ReturnType ANIM_Start(const LCD_Config_t *config, const ANIM_Animation_t *animation)
+{
+    if ((config == NULL) || (animation == NULL) || (animation->frames == NULL) ||
+        (animation->frameCount == 0) || (animation->glyphCount == 0) ||
+        (animation->glyphCount > ANIM_MAX_GLYPHS))
+    {
+        return E_NOT_OK;
+    }
+
+    ANIM_LcdConfig = config;
+    ANIM_Animation = *animation;
+    ANIM_CellCount = 0;
+    ANIM_Frame = 0;
+    ANIM_Bank = 0;
+
+    ANIM_LoadFrame(ANIM_Frame, ANIM_Bank);
+    ANIM_LastFrameTick = TMR0_GetTicks();
+
+    return E_OK;
+}
+
+Std_ReturnType ANIM_AddCell(uint8_t x, uint8_t y, uint8_t glyph)
+{
+    if ((ANIM_LcdConfig == NULL) || (glyph >= ANIM_Animation.glyphCount) ||
+        (ANIM_CellCount >= ANIM_MAX_CELLS))
+    {
+        return E_NOT_OK;
+    }
+
+    ANIM_Cells[ANIM_CellCount].x = x;
+    ANIM_Cells[ANIM_CellCount].y = y;
+    ANIM_Cells[ANIM_CellCount].glyph = glyph;
+    ANIM_CellCount++;
+
+    LCD_BufferPutChar(x, y, ANIM_Bank * _ANIM_BANK_SIZE + glyph);
+
+    return E_OK;
+}
+
+Std_ReturnType ANIM_Update(void)
+{
+    u32 Local_Now;
+    uint8_t Local_Hidden;
+
+    if (ANIM_LcdConfig == NULL)
+    {
+        return E_NOT_OK;
+    }
+
+    Local_Now = TMR0_GetTicks();
+    if ((u32)(Local_Now - ANIM_LastFrameTick) < ANIM_Animation.framePeriod)
+    {
+        return E_NOT_OK;
+    }
+
+    /**< Keep a steady rate, but skip missed frames instead of bursting to catch up */
+    ANIM_LastFrameTick += ANIM_Animation.framePeriod;
+    if ((u32)(Local_Now - ANIM_LastFrameTick) >= ANIM_Animation.framePeriod)
+    {
+        ANIM_LastFrameTick = Local_Now;
+    }
+
+    ANIM_Frame++;
+    if (ANIM_Frame >= ANIM_Animation.frameCount)
+    {
+        ANIM_Frame = 0;
+    }
+
+    /**< Draw into the bank nobody looks at, then point the cells to it */
+    Local_Hidden = ANIM_Bank ^ 1;
+    ANIM_LoadFrame(ANIM_Frame, Local_Hidden);
+    ANIM_Bank = Local_Hidden;
+
+    for (uint8_t i = 0; i < ANIM_CellCount; i++)
+    {
+        LCD_BufferPutChar(ANIM_Cells[i].x, ANIM_Cells[i].y, ANIM_Bank * _ANIM_BANK_SIZE + ANIM_Cells[i].glyph);
+    }
+    LCD_Flush(ANIM_LcdConfig);
+
+    return E_OK;
+}
+
+void ANIM_Stop(void)
+{
+    ANIM_LcdConfig = NULL;
+    ANIM_CellCount = 0;
+}
+
+/*****************************< Private helper functions *****************************/
+static void ANIM_LoadFrame(uint8_t frame, uint8_t bank)
+{
+    CustomChar_t Local_Glyph;
+    const uint8_t *Local_Pattern = ANIM_Animation.frames +
+                                   (u16)frame * ANIM_Animation.glyphCount * _ANIM_PATTERN_ROWS;
+
+    for (uint8_t glyph = 0; glyph < ANIM_Animation.glyphCount; glyph++)
+    {
+        for (uint8_t row = 0; row < _ANIM_PATTERN_ROWS; row++)
+        {
+            Local_Glyph.pattern[row] = pgm_read_byte(Local_Pattern++);
+        }
+        Local_Glyph.charIndex = bank * _ANIM_BANK_SIZE + glyph;
+        LCD_DefineCustomChar(ANIM_LcdConfig, &Local_Glyph);
+    }
+}
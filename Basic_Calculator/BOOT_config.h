@@ -0,0 +1,15 @@
+
+
+#ifndef BOOT_CONFIG_H_
+#define BOOT_CONFIG_H_
+
+/**
+ * @brief Longest allowed time from reset to ready for input, in ms.
+ *
+ * Ready is when both the keypad is read and the LCD can show the key.
+ * BOOT_Check fails when a boot took longer.
+ */
+#define BOOT_READY_BUDGET_MS    50
+
+
+#endif /**< BOOT_CONFIG_H_ */
@@ -0,0 +1,60 @@
+
+
+#ifndef BOOT_INTERFACE_H_
+#define BOOT_INTERFACE_H_
+
+/**
+ * @brief Points of the boot, in the order main reaches them.
+ */
+typedef enum {
+    BOOT_TIMER_STARTED = 0,  /**< Timer0 runs, the time base of every other point */
+    BOOT_LCD_STARTED,        /**< The LCD initialization runs in the background */
+    BOOT_KEYPAD_READY,       /**< Keys are read */
+    BOOT_SERVICES_READY,     /**< UART, serial service, EEPROM and history are up */
+    BOOT_LCD_READY,          /**< The LCD initialization is over */
+    BOOT_SPLASH_SHOWN,       /**< The welcome screen is on the LCD */
+    BOOT_PHASES              /**< Number of points, not a point */
+} BOOT_Phase_t;
+
+/**
+ * @brief Timestamps a point of the boot.
+ *
+ * Only the first mark of each point counts. Uses TMR0_GetMicros, so
+ * Timer0 must be running; time before TMR0_Init (the C startup and the
+ * start of main) is not seen.
+ *
+ * @param[in] phase The point reached.
+ */
+void BOOT_Mark(BOOT_Phase_t phase);
+
+/**
+ * @brief Gets the time of a point of the boot.
+ *
+ * @param[in] phase The point.
+ * @return Microseconds since BOOT_TIMER_STARTED, 0 if the point was not reached.
+ */
+u32 BOOT_GetTime(BOOT_Phase_t phase);
+
+/**
+ * @brief Gets the time to ready for input, the later of BOOT_KEYPAD_READY and BOOT_LCD_READY.
+ *
+ * @return Microseconds since BOOT_TIMER_STARTED, 0 while not ready.
+ */
+u32 BOOT_GetTimeToReady(void);
+
+/**
+ * @brief Checks the time to ready against BOOT_READY_BUDGET_MS.
+ *
+ * @return E_OK if ready within the budget, E_NOT_OK if later or not ready yet.
+ */
+Std_ReturnType BOOT_Check(void);
+
+/**
+ * @brief Writes the boot times to the UART.
+ *
+ * Waits for room in the UART transmit buffer, so interrupts must be enabled.
+ */
+void BOOT_DumpUart(void);
+
+
+#endif /**< BOOT_INTERFACE_H_ */
@@ -0,0 +1,12 @@
+
+
+#ifndef BOOT_PRIVATE_H_
+#define BOOT_PRIVATE_H_
+
+/**
+ * @brief Time budget to ready in microseconds.
+ */
+#define _BOOT_READY_BUDGET_US   ((u32)BOOT_READY_BUDGET_MS * 1000UL)
+
+
+#endif /**< BOOT_PRIVATE_H_ */
@@ -0,0 +1,81 @@
+
+
+/*****************************< LIB *****************************/
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+#include <avr/pgmspace.h>
+/*****************************< MCAL *****************************/
+#include "TMR0_interface.h"
+#include "UART_interface.h"
+/*****************************< HAL *****************************/
+#include "BOOT_interface.h"
+#include "BOOT_config.h"
+#include "BOOT_private.h"
+
+/*****************************< Private Variables *****************************/
+static u32 BOOT_Points[BOOT_PHASES];    /**< TMR0_GetMicros at each point */
+static u8 BOOT_Reached = 0;             /**< Bit per point already marked */
+
+/*****************************< Function Implementations *****************************/
+void BOOT_Mark(BOOT_Phase_t phase)
+{
+    u32 Local_Now = TMR0_GetMicros();
+
+    if ((phase >= BOOT_PHASES) || GET_BIT(BOOT_Reached, phase))
+    {
+        return;
+    }
+
+    BOOT_Points[phase] = Local_Now;
+    SET_BIT(BOOT_Reached, phase);
+}
+
+u32 BOOT_GetTime(BOOT_Phase_t phase)
+{
+    if ((phase >= BOOT_PHASES) || !GET_BIT(BOOT_Reached, phase) || !GET_BIT(BOOT_Reached, BOOT_TIMER_STARTED))
+    {
+        return 0;
+    }
+
+    return BOOT_Points[phase] - BOOT_Points[BOOT_TIMER_STARTED];
+}
+
+u32 BOOT_GetTimeToReady(void)
+{
+    u32 Local_Keypad = BOOT_GetTime(BOOT_KEYPAD_READY);
+    u32 Local_Lcd = BOOT_GetTime(BOOT_LCD_READY);
+
+    if (!GET_BIT(BOOT_Reached, BOOT_KEYPAD_READY) || !GET_BIT(BOOT_Reached, BOOT_LCD_READY))
+    {
+        return 0;
+    }
+
+    return (Local_Keypad > Local_Lcd) ? Local_Keypad : Local_Lcd;
+}
+
+Std_ReturnType BOOT_Check(void)
+{
+    if (!GET_BIT(BOOT_Reached, BOOT_KEYPAD_READY) || !GET_BIT(BOOT_Reached, BOOT_LCD_READY))
+    {
+        return E_NOT_OK;
+    }
+
+    return (BOOT_GetTimeToReady() <= _BOOT_READY_BUDGET_US) ? E_OK : E_NOT_OK;
+}
+
+void BOOT_DumpUart(void)
+{
+    /**< "boot <time of each point>", 0 for points not reached */
+    UART_WriteStringWait_P(PSTR("boot"));
+    for (u8 i = 0; i < BOOT_PHASES; i++)
+    {
+        UART_WriteNumber(BOOT_GetTime((BOOT_Phase_t)i));
+    }
+    UART_WriteStringWait_P(PSTR("\n"));
+
+    /**< "ready <time to ready> <budget>", all in us */
+    UART_WriteStringWait_P(PSTR("ready"));
+    UART_WriteNumber(BOOT_GetTimeToReady());
+    UART_WriteNumber(_BOOT_READY_BUDGET_US);
+    UART_WriteStringWait_P(PSTR("\n"));
+}
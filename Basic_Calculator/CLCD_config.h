@@ -2,9 +2,84 @@
 #ifndef CLCD_CONFIG_H
 #define CLCD_CONFIG_H
 
+/**
+ * @brief Transport between the driver and the displays.
+ *
+ * - LCD_TRANSPORT_PARALLEL: data, RS and R/W on GPIO pins, 4 or 8-bit.
+ * - LCD_TRANSPORT_HC595: 74HC595 on three GPIO pins, 4-bit.
+ * - LCD_TRANSPORT_PCF8574: PCF8574 I2C backpack through the TWI driver, 4-bit.
+ */
+#define LCD_TRANSPORT           LCD_TRANSPORT_PARALLEL
 
+/**
+ * @brief Poll the busy flag instead of waiting the worst-case execution time.
+ *
+ * Needs R/W wired to the controller (parallel: rwPin, PCF8574: expander
+ * output LCD_EXPANDER_RW_BIT). The 74HC595 cannot read back.
+ */
+#define LCD_READ_BUSY           0
 
+/**
+ * @brief Expander outputs (74HC595 Qn / PCF8574 Pn) wired to RS, R/W and the
+ * backlight. D4-D7 are on outputs 4-7; the enable output of each display is
+ * given in its LCD_Config_t. These defaults match the common PCF8574 backpack.
+ */
+#define LCD_EXPANDER_RS_BIT         0
+#define LCD_EXPANDER_RW_BIT         1
+#define LCD_EXPANDER_BACKLIGHT_BIT  3
 
+/**
+ * @brief Geometry of the panel: visible rows and columns, and the DDRAM address
+ * of the first character of each row. Rows past LCD_ROWS are ignored.
+ *
+ * Checked at compile time: every row must lie inside one 40-character DDRAM
+ * line (0x00-0x27 or 0x40-0x67) and rows must not overlap.
+ *
+ * | Panel | LCD_ROWS | LCD_COLUMNS | Row starts             |
+ * |-------|----------|-------------|------------------------|
+ * | 16x1  | 1        | 16          | 0x00                   |
+ * | 16x2  | 2        | 16          | 0x00, 0x40             |
+ * | 20x2  | 2        | 20          | 0x00, 0x40             |
+ * | 20x4  | 4        | 20          | 0x00, 0x40, 0x14, 0x54 |
+ * | 40x2  | 2        | 40          | 0x00, 0x40             |
+ */
+#define LCD_ROWS                2
+#define LCD_COLUMNS             16
+#define LCD_ROW0_START          0x00
+#define LCD_ROW1_START          0x40
+#define LCD_ROW2_START          0x14
+#define LCD_ROW3_START          0x54
+
+/**
+ * @brief Upload the big-digit segment glyphs into CGRAM during LCD_Init.
+ *
+ * - 1: LCD_BufferPutBigNumber works right after LCD_Init.
+ * - 0: CGRAM is left free; call LCD_LoadBigDigitFont before drawing big digits.
+ */
+#define LCD_BIG_DIGITS          1
+
+/**
+ * @brief Drop commands that would not change the controller state.
+ *
+ * The driver tracks the address counter, entry mode, display control and
+ * display shift of the last configuration written to on each bus.
+ *
+ * - 1: redundant set address, entry mode, display control, return home and
+ *      clear commands are not sent.
+ * - 0: every command is sent; LCD_GetCommandStats still counts the redundant
+ *      ones, which shows what dropping them would save.
+ *
+ * Set it to 0 if something else writes to the displays behind the driver.
+ */
+#define LCD_ELIDE_COMMANDS      1
+
+/**
+ * @brief Script instructions LCD_ScriptUpdate plays per call, at most.
+ *
+ * Bounds the time one call takes from the main loop; a data instruction
+ * counts as one whatever its length.
+ */
+#define LCD_SCRIPT_STEPS        4
 
 
 
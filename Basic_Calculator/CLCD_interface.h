@@ -24,72 +24,275 @@ typedef struct {
     uint8_t :2;             /**< Padding */
 } LCD_PinConfig_t;
 
+/**
+ * @brief Transports the driver can be built for, selected with LCD_TRANSPORT in CLCD_config.h.
+ */
+#define LCD_TRANSPORT_PARALLEL  0   /**< Data, RS and R/W lines on GPIO pins */
+#define LCD_TRANSPORT_HC595     1   /**< 74HC595 shift register on three GPIO pins */
+#define LCD_TRANSPORT_PCF8574   2   /**< PCF8574 I2C backpack */
+
+/**
+ * @brief Maximum number of enable lines of one LCD configuration.
+ */
+#define LCD_MAX_ENABLES         4
+
+/**
+ * @brief Structure representing the lines shared by all LCDs on one data bus.
+ *
+ * The displays on a bus share the data, RS and R/W lines and differ only in
+ * their enable line. Fill in the mode and the fields of the transport the
+ * driver is built for; the remaining fields belong to the driver and are set
+ * up by LCD_BusInit. The 74HC595 and PCF8574 transports only support 4-bit
+ * mode, with D4-D7 on expander outputs 4-7.
+ */
+typedef struct {
+    uint8_t mode;                  /**< 8-bit or 4-bit mode indicator */
+    LCD_PinConfig_t dataPins[8];   /**< Parallel: maximum pins for 8-bit mode */
+    LCD_PinConfig_t rsPin;         /**< Parallel: RS pin */
+    LCD_PinConfig_t rwPin;         /**< Parallel: R/W pin, low except to read the busy flag */
+    LCD_PinConfig_t serialPin;     /**< 74HC595: serial data input (DS) */
+    LCD_PinConfig_t shiftClockPin; /**< 74HC595: shift register clock (SH_CP) */
+    LCD_PinConfig_t latchPin;      /**< 74HC595: storage register clock (ST_CP) */
+    uint8_t address;               /**< PCF8574: 7-bit I2C address (0x20-0x27, PCF8574A 0x38-0x3F) */
+    const void *volatile owner;    /**< LCD configuration holding the bus, NULL when free */
+    uint8_t latchedData;           /**< Levels the data pins (or expander outputs) are driven to */
+    uint8_t latchedRs;             /**< Level the RS pin is currently driven to */
+    uint8_t batchDepth;            /**< Nesting of the batch of writes in progress */
+    uint8_t batchClaimed;          /**< 1 if the batch claimed the bus and releases it when done */
+    const void *mirrorOwner;       /**< LCD configuration the controller state below describes, NULL when unknown */
+    uint8_t mirrorAddress;         /**< Set-address command matching the address counter, 0 when unknown */
+    uint8_t mirrorEntryMode;       /**< Entry mode set last, 0 when unknown */
+    uint8_t mirrorDisplay;         /**< Display control set last, 0 when unknown */
+    uint8_t mirrorFlags;           /**< DDRAM blank and display shift flags */
+} LCD_Bus_t;
+
 /**
  * @brief Structure representing LCD configuration.
+ *
+ * One enable line addresses one display. With several enable lines the
+ * configuration mirrors all of those displays: every byte is latched onto the
+ * bus once and each enable is pulsed in turn, so all functions of this driver
+ * write to the displays together. With the 74HC595 and PCF8574 transports an
+ * enable line is an expander output: only LCD_PinId (0-7) is used.
  */
 typedef struct {
-    uint8_t mode;                /**< 8-bit or 4-bit mode indicator */
-    LCD_PinConfig_t dataPins[8]; /**< Maximum pins for 8-bit mode */
-    LCD_PinConfig_t rsPin;       /**< RS pin */
-    LCD_PinConfig_t rwPin;       /**< R/W pin */
-    LCD_PinConfig_t enablePin;   /**< Enable pin */
+    LCD_Bus_t *bus;                              /**< Shared data, RS and R/W lines */
+    LCD_PinConfig_t enablePins[LCD_MAX_ENABLES]; /**< Enable pin (or expander output) of each display */
+    uint8_t enableCount;                         /**< Number of enable pins used (1 to LCD_MAX_ENABLES) */
 } LCD_Config_t;
 
+/**
+ * @brief Enum defining the direction of a display shift.
+ */
+typedef enum {
+    LCD_SHIFT_LEFT = 0,  /**< Content moves one column to the left */
+    LCD_SHIFT_RIGHT = 1  /**< Content moves one column to the right */
+} LCD_ShiftDirection_t;
+
+/**
+ * @brief Counters of the commands written to the displays and of those dropped
+ * because they would not have changed the controller state.
+ */
+typedef struct {
+    u16 sent;            /**< Commands written */
+    u16 address;         /**< Set address dropped: the address counter was there already */
+    u16 entryMode;       /**< Entry mode set dropped: same mode */
+    u16 displayControl;  /**< Display control dropped: same display, cursor and blink setting */
+    u16 home;            /**< Return home dropped: cursor at home and display not shifted */
+    u16 clear;           /**< Clear display dropped: DDRAM blank, cursor at home, display not shifted */
+} LCD_CommandStats_t;
+
+/**
+ * @brief Structure describing the geometry of the panel (see CLCD_config.h).
+ */
+typedef struct {
+    uint8_t rows;         /**< Visible rows (1 to 4) */
+    uint8_t columns;      /**< Visible columns of each row */
+    uint8_t rowStart[4];  /**< DDRAM address of the first character of each row */
+} LCD_Geometry_t;
+
+/**
+ * @brief Structure representing a custom character for LCD.
+ */
+typedef struct {
+    uint8_t pattern[8]; /**< Pattern data for the custom character */
+    uint8_t charIndex;  /**< Index of the custom character (0-7) */
+} CustomChar_t;
+
+/**
+ * @brief Opcodes of LCD scripts.
+ *
+ * A script is a byte string in program memory, played by LCD_ScriptRun or
+ * LCD_ScriptStart. Each instruction is an opcode followed by its operands:
+ *
+ * | Opcode                     | Operands             | Action                                              |
+ * |----------------------------|----------------------|-----------------------------------------------------|
+ * | LCD_SCRIPT_END             |                      | Ends the script                                     |
+ * | LCD_SCRIPT_RESET           |                      | 8-bit function set nibble of the reset sequence     |
+ * | LCD_SCRIPT_INTERFACE       |                      | Nibble switching a 4-bit bus to 4 bits              |
+ * | LCD_SCRIPT_FUNCTION_SET    | flags                | Function set for the bus width, LCD_FUNCTION_*      |
+ * | LCD_SCRIPT_GOTO            | x, y                 | LCD_GoToXYPos                                       |
+ * | LCD_SCRIPT_GLYPH           | slot, 8 rows         | LCD_DefineCustomChar; the address is left in CGRAM  |
+ * | LCD_SCRIPT_DELAY_MS        | n                    | Waits n ms                                          |
+ * | LCD_SCRIPT_DELAY_US        | n                    | Waits n x 10 us, always blocking                    |
+ * | LCD_SCRIPT_COMMAND(n)      | n commands           | LCD_SendCommand for each, n = 1 to 63               |
+ * | LCD_SCRIPT_DATA(n)         | n characters         | LCD_SendChar for each, n = 1 to 63                  |
+ *
+ * Example usage:
+ * @code
+ * static const uint8_t splash[] PROGMEM = {
+ *     LCD_SCRIPT_COMMAND(1), LCD_CMD_CLEAR,
+ *     LCD_SCRIPT_GOTO, 5, 0, LCD_SCRIPT_DATA(5), 'H', 'e', 'l', 'l', 'o',
+ *     LCD_SCRIPT_END
+ * };
+ * LCD_ScriptRun(&lcd1, splash);
+ * @endcode
+ */
+#define LCD_SCRIPT_END              0x00
+#define LCD_SCRIPT_RESET            0x01
+#define LCD_SCRIPT_INTERFACE        0x02
+#define LCD_SCRIPT_FUNCTION_SET     0x03
+#define LCD_SCRIPT_GOTO             0x04
+#define LCD_SCRIPT_GLYPH            0x05
+#define LCD_SCRIPT_DELAY_MS         0x06
+#define LCD_SCRIPT_DELAY_US         0x07
+#define LCD_SCRIPT_COMMAND(n)       (0x40 | (n))
+#define LCD_SCRIPT_DATA(n)          (0x80 | (n))
+
+/**
+ * @brief Commands and function set flags for scripts.
+ */
+#define LCD_CMD_CLEAR                           0x01
+#define LCD_CMD_RETURN_HOME                     0x02
+#define LCD_CMD_ENTRY_MODE(increment, shift)    (0x04 | ((increment) << 1) | (shift))
+#define LCD_CMD_DISPLAY(on, cursor, blink)      (0x08 | ((on) << 2) | ((cursor) << 1) | (blink))
+#define LCD_FUNCTION_2_LINES                    0x08
+#define LCD_FUNCTION_5X10_DOTS                  0x04
+
+/**
+ * @brief Initializes a data bus shared by one or more LCDs.
+ *
+ * Parallel: sets the data, RS and R/W pins as outputs and drives them low.
+ * 74HC595: sets the three shift register pins as outputs and clears the outputs.
+ * PCF8574: initializes the TWI and clears the expander, backlight on.
+ * Marks the bus free. Call it once per bus, before LCD_Init of any display on it.
+ *
+ * @param bus Pointer to the bus with its mode and pins filled in.
+ */
+void LCD_BusInit(LCD_Bus_t *bus);
+
+/**
+ * @brief Reserves the bus of an LCD configuration for a sequence of writes.
+ *
+ * Every write claims the bus for its own duration. Holding it across a
+ * sequence (cursor move and text, a whole flush, ...) keeps writes to other
+ * displays on the bus, e.g. from an interrupt, from landing in between: while
+ * the bus is held, writes through any other configuration are dropped.
+ *
+ * @param[in] config Pointer to the LCD configuration.
+ * @return E_OK if the bus was free or already held by this configuration, E_NOT_OK otherwise.
+ */
+Std_ReturnType LCD_BusAcquire(const LCD_Config_t *config);
+
+/**
+ * @brief Frees the bus reserved with LCD_BusAcquire.
+ *
+ * @param[in] config Pointer to the LCD configuration holding the bus.
+ */
+void LCD_BusRelease(const LCD_Config_t *config);
+
 /**
  * @brief Initializes the LCD module.
  *
  * This function initializes the LCD module according to the provided configuration.
- * It sets the direction of control pins (enable, rs, rw) and data pins based on the
- * mode specified in the configuration.
+ * It sets the direction of the enable pins and runs the initialization sequence
+ * on every display of the configuration at once. The bus must be initialized first.
  *
  * Example usage:
  * @code
- * LCD_Config_t lcd1;
- * lcd1.mode = LCD_4BitMode;
+ * LCD_Bus_t bus;
+ * bus.mode = LCD_4BitMode;
  * for (u8 i = 0; i < 4; i++) {
- *     lcd1.dataPins[i].LCD_PortId = DIO_PORTA;
- *     lcd1.dataPins[i].LCD_PinId = DIO_PIN3 - i;
+ *     bus.dataPins[i].LCD_PortId = DIO_PORTA;
+ *     bus.dataPins[i].LCD_PinId = DIO_PIN3 + i;
  * }
- * lcd1.enablePin.LCD_PortId = DIO_PORTA;
- * lcd1.enablePin.LCD_PinId = DIO_PIN4;
- * lcd1.rsPin.LCD_PortId = DIO_PORTA;
- * lcd1.rsPin.LCD_PinId = DIO_PIN5;
- * LCD_Init(&lcd1);
+ * bus.rsPin.LCD_PortId = DIO_PORTA;
+ * bus.rsPin.LCD_PinId = DIO_PIN1;
+ * bus.rwPin.LCD_PortId = DIO_PORTA;
+ * bus.rwPin.LCD_PinId = DIO_PIN0;
+ * LCD_BusInit(&bus);
+ *
+ * LCD_Config_t lcd1 = {&bus, {{DIO_PORTA, DIO_PIN2}}, 1};
+ * LCD_Config_t lcd2 = {&bus, {{DIO_PORTA, DIO_PIN7}}, 1};
+ * LCD_Config_t both = {&bus, {{DIO_PORTA, DIO_PIN2}, {DIO_PORTA, DIO_PIN7}}, 2};
+ * LCD_Init(&both);
  * @endcode
  *
  * @param config Pointer to the configuration structure containing initialization parameters.
  */
 void LCD_Init(const LCD_Config_t *config);
 
+/**
+ * @brief Initializes the LCD module with a panel-specific initialization script.
+ *
+ * Same as LCD_Init, with the script playing the reset sequence instead of the
+ * built-in one, e.g. with the longer power-on or reset delays some panels
+ * need. The script must end with the display cleared, the cursor at home and
+ * the address counter incrementing.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] script The initialization script, in program memory.
+ */
+void LCD_InitWithScript(const LCD_Config_t *config, const uint8_t *script);
+
+/**
+ * @brief Starts initializing the LCD module in the background.
+ *
+ * Returns at once: LCD_ScriptUpdate plays the initialization from the main
+ * loop, so the power-on and reset waits overlap with the rest of the boot.
+ * The display is ready, as after LCD_Init, once LCD_ScriptIsRunning returns
+ * 0; write nothing to it before. Timer0 must be running (TMR0_Init) and
+ * interrupts enabled for the waits to end.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] script A panel-specific initialization script in program memory (see LCD_InitWithScript), or NULL for the built-in one.
+ * @return E_OK if the initialization was started, E_NOT_OK if the configuration is invalid.
+ */
+Std_ReturnType LCD_InitStart(const LCD_Config_t *config, const uint8_t *script);
+
 /**
  * @brief Sends a command to the LCD module.
  *
  * This function sends a command to the LCD module based on the provided configuration.
- * It sets the RS pin to low for command mode and the RW pin to low for write operation.
- * Depending on the configured mode (4-bit or 8-bit), it calls the corresponding function
- * to send the command.
+ * It sets the RS pin to low for command mode; only data pins whose level changes
+ * are written. The command goes out through the transport of the build in one
+ * byte or two nibbles, then the driver waits until the displays are ready.
  *
  * @param[in] config Pointer to the LCD configuration structure.
  * @param[in] command The command to be sent to the LCD.
+ * @return E_OK if the command was sent or had nothing to change, E_NOT_OK if
+ *         the bus is not initialized or another configuration holds it.
  * @note This function assumes that the required GPIO module has been initialized separately.
- * @warning If the mode in the configuration is neither 4-bit nor 8-bit, the function returns without action.
+ * @warning If the bus mode is neither 4-bit nor 8-bit, or another configuration holds the bus, nothing is sent.
  */
-void LCD_SendCommand(const LCD_Config_t *config, uint8_t command);
+Std_ReturnType LCD_SendCommand(const LCD_Config_t *config, uint8_t command);
 
 /**
  * @brief Sends a character to the LCD module for display.
  *
  * This function sends a character to the LCD module based on the provided configuration.
- * It sets the RS pin to high for data mode and the RW pin to low for write operation.
- * Depending on the configured mode (4-bit or 8-bit), it calls the corresponding function
- * to send the character.
+ * It sets the RS pin to high for data mode; only data pins whose level changes
+ * are written. The character goes out through the transport of the build in
+ * one byte or two nibbles, then the driver waits until the displays are ready.
  *
  * @param[in] config Pointer to the LCD configuration structure.
  * @param[in] character The character to be sent to the LCD for display.
+ * @return E_OK if the character was sent, E_NOT_OK if the bus is not
+ *         initialized or another configuration holds it.
  * @note This function assumes that the required GPIO module has been initialized separately.
- * @warning If the mode in the configuration is neither 4-bit nor 8-bit, the function returns without action.
+ * @warning If the bus mode is neither 4-bit nor 8-bit, or another configuration holds the bus, nothing is sent.
  */
-void LCD_SendChar(const LCD_Config_t *config, uint8_t character);
+Std_ReturnType LCD_SendChar(const LCD_Config_t *config, uint8_t character);
 
 /**
  * @brief Sends a null-terminated string to the LCD for display.
@@ -97,12 +300,35 @@ void LCD_SendChar(const LCD_Config_t *config, uint8_t character);
  * This function sends a null-terminated string to the LCD module for display
  * based on the provided configuration. It iterates through the characters of
  * the string and sends each character to the LCD using the LCD_SendChar function.
+ * The whole string is one batch: the bus is claimed once and, with the PCF8574
+ * transport, sent in a single I2C transaction.
  *
  * @param[in] config Pointer to the LCD configuration structure.
  * @param[in] string Pointer to the null-terminated string to be displayed on the LCD.
+ * @return E_OK if the string was sent, E_NOT_OK if string is NULL or the bus
+ *         could not be claimed; then no character is sent.
+ * @note This function assumes that the required GPIO module and LCD character functions have been initialized separately.
+ */
+Std_ReturnType LCD_SendString(const LCD_Config_t *config, const uint8_t *string);
+
+/**
+ * @brief Sends a null-terminated string stored in program memory to the LCD.
+ *
+ * Same as LCD_SendString, but the characters are read with pgm_read_byte so the
+ * string can live in flash (PROGMEM / PSTR) instead of being copied to SRAM at
+ * startup.
+ *
+ * Example usage:
+ * @code
+ * LCD_SendString_P(&lcd1, (const uint8_t *)PSTR("Hello"));
+ * @endcode
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] string Pointer to the null-terminated string in program memory.
+ * @return E_OK if the string was sent, E_NOT_OK as for LCD_SendString.
  * @note This function assumes that the required GPIO module and LCD character functions have been initialized separately.
  */
-void LCD_SendString(const LCD_Config_t *config, const uint8_t *string);
+Std_ReturnType LCD_SendString_P(const LCD_Config_t *config, const uint8_t *string);
 
 /**
  * @brief Displays a double-precision floating-point number on the LCD.
@@ -147,14 +373,244 @@ void LCD_Clear(const LCD_Config_t *config);
  * @brief Moves the cursor of the LCD to a specific position.
  *
  * This function moves the cursor of the LCD module based on the provided coordinates
- * (x and y) within the screen bounds specified by the LCD configuration.
+ * (x and y). The DDRAM address comes from the row-start table of the geometry in
+ * CLCD_config.h; positions outside the visible rows and columns are ignored.
  *
  * @param[in] config Pointer to the LCD configuration structure.
- * @param[in] x The x-coordinate (column) on the LCD (0 to 15 for a 16-column display).
- * @param[in] y The y-coordinate (row) on the LCD (0 or 1 for a two-row display).
+ * @param[in] x The x-coordinate (column) on the LCD (0 to LCD_COLUMNS - 1).
+ * @param[in] y The y-coordinate (row) on the LCD (0 to LCD_ROWS - 1).
  * @note This function assumes that the required LCD command functions have been initialized separately.
  */
 void LCD_GoToXYPos(const LCD_Config_t *config, uint8_t x, uint8_t y);
 
+/**
+ * @brief Reads the geometry the driver was built for.
+ *
+ * @param[out] geometry Pointer to the structure receiving rows, columns and row starts.
+ */
+void LCD_GetGeometry(LCD_Geometry_t *geometry);
+
+/**
+ * @brief Defines a custom character in the LCD's CGRAM.
+ *
+ * Writes the 8 pattern rows of the character into the CGRAM slot given by
+ * charIndex. The character is then shown by sending charIndex (0-7) as data.
+ * The LCD address counter is left in CGRAM, so move the cursor before writing
+ * text again.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] customChar Pointer to the custom character (pattern and slot).
+ * @return E_OK if the custom character was successfully defined, E_NOT_OK otherwise.
+ */
+Std_ReturnType LCD_DefineCustomChar(const LCD_Config_t *config, const CustomChar_t *customChar);
+
+/**
+ * @brief Defines a custom character stored in program memory on the LCD.
+ *
+ * Same as LCD_DefineCustomChar, but the whole CustomChar_t (pattern and index)
+ * is read from flash with pgm_read_byte.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] customChar Custom character in program memory.
+ * @return E_OK if the custom character was successfully defined, E_NOT_OK otherwise.
+ */
+Std_ReturnType LCD_DefineCustomChar_P(const LCD_Config_t *config, const CustomChar_t *customChar);
+
+/**
+ * @brief Uploads the 8 segment glyphs used by the big digits into CGRAM.
+ *
+ * LCD_Init already does this when LCD_BIG_DIGITS is 1 in CLCD_config.h. Call it
+ * again after anything else has rewritten CGRAM. Leaves the cursor at the home
+ * position.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ */
+void LCD_LoadBigDigitFont(const LCD_Config_t *config);
+
+/**
+ * @brief Frame buffer: fills the buffer with spaces.
+ *
+ * The frame buffer functions only change an SRAM copy of the screen. Cells
+ * whose content really changes are marked dirty, and LCD_Flush writes just
+ * those cells to the LCD. LCD_Clear and LCD_Init keep the buffer in step with
+ * the display. After writing to the LCD directly (LCD_SendChar, ...) call
+ * LCD_BufferInvalidate before the next flush. There is one buffer: to show it
+ * on several displays of a bus, flush through a configuration holding all of
+ * their enable pins.
+ */
+void LCD_BufferClear(void);
+
+/**
+ * @brief Frame buffer: writes a character to a cell.
+ *
+ * @param[in] x The column (0 to LCD_COLUMNS - 1).
+ * @param[in] y The row (0 to LCD_ROWS - 1).
+ * @param[in] character The character code, including custom characters 0-7.
+ */
+void LCD_BufferPutChar(uint8_t x, uint8_t y, uint8_t character);
+
+/**
+ * @brief Frame buffer: writes a null-terminated string from a cell onwards.
+ *
+ * Characters past the end of the row are dropped.
+ *
+ * @param[in] x The column of the first character.
+ * @param[in] y The row.
+ * @param[in] string Pointer to the null-terminated string.
+ */
+void LCD_BufferPutString(uint8_t x, uint8_t y, const uint8_t *string);
+
+/**
+ * @brief Frame buffer: draws an integer with big digits across the first two rows.
+ *
+ * Each digit is 3 columns wide and 2 rows high, built from the segment glyphs
+ * of LCD_LoadBigDigitFont, with one blank column between digits. The number is
+ * right-aligned and the columns to its left are blanked, so on a 16-column
+ * display it holds up to 4 digits, or a minus sign and 3 digits (5 digits on 20
+ * columns). Needs at least two rows. Because the
+ * segments stay in CGRAM, redrawing costs only the DDRAM writes of the cells
+ * that changed.
+ *
+ * @param[in] number The integer to draw.
+ * @return E_OK on success, E_NOT_OK if the number is too wide (nothing is drawn).
+ */
+Std_ReturnType LCD_BufferPutBigNumber(s32 number);
+
+/**
+ * @brief Frame buffer: marks every cell dirty so the next flush rewrites the screen.
+ */
+void LCD_BufferInvalidate(void);
+
+/**
+ * @brief Writes the dirty cells of the frame buffer to the LCD.
+ *
+ * Adjacent dirty cells are written in one run, the cursor is only moved to
+ * skip over clean cells.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ */
+void LCD_Flush(const LCD_Config_t *config);
+
+/**
+ * @brief Shifts the whole display by one column without touching DDRAM.
+ *
+ * Each row of the HD44780 is a 40-character DDRAM line of which LCD_COLUMNS
+ * are visible; a shift moves that window with a single command. All rows shift
+ * together (on a 20x4 panel rows 0 and 2, and rows 1 and 3, are halves of one
+ * line, so text moves from one into the other), and positions given to
+ * LCD_GoToXYPos and the frame buffer stay DDRAM positions, i.e. they move on
+ * screen with the shift. LCD_Clear and LCD_MarqueeStop undo the shift.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] direction LCD_SHIFT_LEFT or LCD_SHIFT_RIGHT.
+ */
+void LCD_ShiftDisplay(const LCD_Config_t *config, LCD_ShiftDirection_t direction);
+
+/**
+ * @brief Writes a whole 40-character DDRAM line for scrolling.
+ *
+ * The string is written once from the start of the row and the rest of the
+ * line is filled with spaces, so a running marquee scrolls the text out and
+ * brings it back in from the right with a gap in between. The visible part is
+ * recorded in the frame buffer. Only rows that have a DDRAM line to themselves
+ * can scroll, i.e. not the rows of a 20x4 panel.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] y The row (0 to LCD_ROWS - 1).
+ * @param[in] string Pointer to the null-terminated string, up to 40 characters.
+ * @return E_OK on success, E_NOT_OK if an argument is invalid, the row shares its
+ *         DDRAM line with another row, or the string was longer than 40
+ *         characters (the rest is dropped).
+ */
+Std_ReturnType LCD_MarqueeLoad(const LCD_Config_t *config, uint8_t y, const uint8_t *string);
+
+/**
+ * @brief Starts scrolling the display to the left, one column per period.
+ *
+ * Text already in DDRAM past the visible columns (from LCD_MarqueeLoad or
+ * from writing past the last visible column) comes into view. Every step is a single shift
+ * command; the text is never rewritten. Requires the Timer0 tick (TMR0_Init).
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] period Timer0 ticks between two steps.
+ */
+void LCD_MarqueeStart(const LCD_Config_t *config, u16 period);
+
+/**
+ * @brief Scrolls the marquee by one column when the next step is due.
+ *
+ * Call it from the main loop.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @return E_OK if the display was shifted, E_NOT_OK otherwise.
+ */
+Std_ReturnType LCD_MarqueeUpdate(const LCD_Config_t *config);
+
+/**
+ * @brief Stops the marquee and shifts the display back to its home position.
+ *
+ * Also moves the cursor to the first column of the first row.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ */
+void LCD_MarqueeStop(const LCD_Config_t *config);
+
+/**
+ * @brief Plays an LCD script to the end before returning.
+ *
+ * The bus is held for the whole script.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] script The script, in program memory.
+ * @return E_OK if the script was played, E_NOT_OK if an argument is NULL or the bus is held by another configuration.
+ */
+Std_ReturnType LCD_ScriptRun(const LCD_Config_t *config, const uint8_t *script);
+
+/**
+ * @brief Starts playing an LCD script in the background with LCD_ScriptUpdate.
+ *
+ * A script already playing is dropped. Millisecond delays are timed with the
+ * system tick (TMR0_Init) instead of waiting: rounded up to whole ticks at
+ * TMR0_TICK_HZ, plus up to one tick since the wait starts inside one.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] script The script, in program memory.
+ * @return E_OK if the script was started, E_NOT_OK if an argument is NULL.
+ */
+Std_ReturnType LCD_ScriptStart(const LCD_Config_t *config, const uint8_t *script);
+
+/**
+ * @brief Plays the next instructions of the background script; call it from the main loop.
+ *
+ * Runs up to LCD_SCRIPT_STEPS instructions, stopping early at a millisecond
+ * delay or at the end of the script.
+ *
+ * @return E_OK if instructions were played, E_NOT_OK if no script is playing, a delay is running or the bus is held.
+ */
+Std_ReturnType LCD_ScriptUpdate(void);
+
+/**
+ * @brief Tells whether the background script is still playing.
+ *
+ * @return 1 until LCD_ScriptUpdate reaches the end of the script, 0 otherwise.
+ */
+uint8_t LCD_ScriptIsRunning(void);
+
+/**
+ * @brief Copies the command counters gathered since the last reset.
+ *
+ * The driver mirrors the address counter, entry mode, display control and
+ * display shift of the configuration that wrote last to each bus, and drops
+ * commands that would leave them as they are (see LCD_ELIDE_COMMANDS).
+ *
+ * @param[out] stats Pointer to the structure to fill.
+ */
+void LCD_GetCommandStats(LCD_CommandStats_t *stats);
+
+/**
+ * @brief Sets every command counter back to zero.
+ */
+void LCD_ResetCommandStats(void);
+
 #endif /**< CLCD_INTERFACE_H */
 
@@ -26,32 +26,304 @@
 #define _LCD_CGRAM_START                0x40  // Start address for Character Generator RAM (CGRAM) in the LCD.
 #define _LCD_DDRAM_START                0x80  // Start address for Display Data RAM (DDRAM) in the LCD.
 
+#define _LCD_DDRAM_LINE_LENGTH          40    // DDRAM characters per line, visible or not.
+#define _LCD_DDRAM_LINE_MASK            0x40  // Address bit selecting the second DDRAM line.
+#define _LCD_MAX_ROWS                   4     // Rows the geometry descriptor can describe.
+
+/*****************************< Geometry checks *****************************/
+/**< A row of LCD_COLUMNS cells starting at 'start' stays inside one DDRAM line */
+#define _LCD_ROW_FITS(start)            ((((start) & ~_LCD_DDRAM_LINE_MASK) + LCD_COLUMNS) <= _LCD_DDRAM_LINE_LENGTH)
+/**< Two rows share cells: same DDRAM line and closer than LCD_COLUMNS */
+#define _LCD_ROWS_OVERLAP(a, b)         ((((a) & _LCD_DDRAM_LINE_MASK) == ((b) & _LCD_DDRAM_LINE_MASK)) && \
+                                         ((((a) > (b)) ? ((a) - (b)) : ((b) - (a))) < LCD_COLUMNS))
+
+/*****************************< Bus *****************************/
+#define _LCD_SREG_R                     (*((volatile u8*)0X5F)) // Status register, to claim the bus with interrupts off.
+
+/*****************************< Controller state mirror *****************************/
+#define _LCD_ENTRY_MODE                 0x04  // Entry mode set, 0x04-0x07.
+#define _LCD_ENTRY_INCREMENT            0x02  // I/D: the address counter counts up after a data write.
+#define _LCD_ENTRY_SHIFT                0x01  // S: the display shifts on every data write.
+#define _LCD_DISPLAY_CONTROL            0x08  // Display on/off control, 0x08-0x0F.
+#define _LCD_CURSOR_SHIFT               0x10  // Cursor or display shift, 0x10-0x1F.
+#define _LCD_SHIFT_DISPLAY              0x08  // S/C: shift the display, not the cursor.
+#define _LCD_SHIFT_RIGHT                0x04  // R/L: to the right.
+#define _LCD_FUNCTION_SET               0x20  // Function set, 0x20-0x3F.
+#define _LCD_CGRAM_SIZE                 64    // CGRAM bytes; the address counter wraps within them.
+#define _LCD_DDRAM_LINE1_LAST           0x27  // Last address of the first DDRAM line.
+#define _LCD_DDRAM_LINE2_LAST           0x67  // Last address of the second DDRAM line.
+#define _LCD_MIRROR_UNKNOWN             0x00  // Mirrored command that is not known.
+#define _LCD_MIRROR_BLANK               0x01  // Flag: every DDRAM cell holds a space.
+#define _LCD_MIRROR_SHIFTED             0x02  // Flag: the display may be shifted from home.
+
+/*****************************< Frame buffer and big digits *****************************/
+#define _LCD_CUSTOM_CHARS               8     // Custom character slots in CGRAM.
+#define _LCD_BIG_DIGIT_WIDTH            3     // Columns of one big digit.
+#define _LCD_BIG_MINUS_WIDTH            2     // Columns of the big minus sign.
+#define _LCD_BIG_MINUS                  10    // Index of the minus sign in the big glyph table.
+#define _LCD_BIG_BLANK                  ' '   // Empty cell of a big glyph.
+#define _LCD_DIRTY_BYTES                ((LCD_COLUMNS + 7) / 8) // Bytes of dirty flags per row.
+
+/*****************************< Timing *****************************/
+#define _LCD_EXECUTION_US               50    // Worst-case execution time of a write, except clear and home.
+#define _LCD_SLOW_COMMAND_MS            2     // Execution time of clear display and return home.
+#define _LCD_SLOW_COMMAND_LAST          0x03  // Commands up to this value are clear or return home.
+#define _LCD_BUSY_POLLS                 1000  // Busy flag reads before giving up on a display.
+
+/*****************************< Transport *****************************/
+#define _LCD_FUNCTION_SET_8BIT          0x30  // Function set, 8-bit interface (high nibble only during init).
+#define _LCD_FUNCTION_SET_4BIT          0x20  // Function set, 4-bit interface (high nibble only during init).
+#define _LCD_FUNCTION_8BIT              0x10  // DL bit of the function set.
+#define _LCD_POWER_ON_MS                20    // Wait after power-on before the reset sequence.
+#define _LCD_RESET_MS                   5     // Wait after the first reset nibble.
+#define _LCD_RESET_US10                 15    // Wait after the other reset nibbles, in 10 us units.
+
+/*****************************< Scripts *****************************/
+#define _LCD_SCRIPT_OPCODE_MASK         0xC0  // Counted opcodes: COMMAND(n) and DATA(n).
+#define _LCD_SCRIPT_COUNT_MASK          0x3F  // Count of a counted opcode.
+#define _LCD_SCRIPT_GLYPH_ROWS          8     // Pattern rows after the slot of a glyph.
+#define _LCD_MS_TO_TICKS(ms)            ((((u32)(ms) * TMR0_TICK_HZ) + 999UL) / 1000UL)  // Timer0 ticks lasting at least ms milliseconds.
+
+#if (LCD_TRANSPORT == LCD_TRANSPORT_HC595) || (LCD_TRANSPORT == LCD_TRANSPORT_PCF8574)
+#define _LCD_EXPANDER                   1     // RS, R/W, enables and D4-D7 are outputs of one 8-bit expander.
+#define _LCD_EXPANDER_DATA_MASK         0xF0  // D4-D7 on expander outputs 4-7.
+#else
+#define _LCD_EXPANDER                   0
+#endif
+
+#if LCD_TRANSPORT == LCD_TRANSPORT_PCF8574
+#define _LCD_SELF_PACED                 1     // Four I2C bytes per character outlast the execution time.
+#else
+#define _LCD_SELF_PACED                 0
+#endif
+
+#if (LCD_TRANSPORT != LCD_TRANSPORT_PARALLEL) && (LCD_TRANSPORT != LCD_TRANSPORT_HC595) && \
+    (LCD_TRANSPORT != LCD_TRANSPORT_PCF8574)
+#error "LCD_TRANSPORT must be LCD_TRANSPORT_PARALLEL, LCD_TRANSPORT_HC595 or LCD_TRANSPORT_PCF8574"
+#endif
+
+#if LCD_READ_BUSY && (LCD_TRANSPORT == LCD_TRANSPORT_HC595)
+#error "The 74HC595 transport cannot read the busy flag, set LCD_READ_BUSY to 0"
+#endif
+
 /*****************************< Private function prototypes *****************************/ 
 /**
- * @brief Sends 4-bit data to the LCD.
+ * @brief Writes one byte to every display of a configuration.
+ *
+ * Sends the byte through the transport inside a batch, then waits until the
+ * displays are ready for the next one.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] value The command or character.
+ * @param[in] rs DIO_LOW for a command, DIO_HIGH for data.
+ * @return E_OK if the byte was sent or elided, E_NOT_OK if the batch could not begin.
+ */
+static Std_ReturnType HAL_LCD_Write(const LCD_Config_t *config, uint8_t value, uint8_t rs);
+
+/**
+ * @brief Starts a batch of writes, or joins the batch in progress.
+ *
+ * The outermost batch claims the bus unless the configuration already holds
+ * it, and opens the transport (an I2C transaction with the PCF8574).
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @return E_OK if the writes can go ahead, E_NOT_OK if the bus is held by another
+ *         configuration or the transport could not be opened.
+ */
+static Std_ReturnType HAL_LCD_BatchBegin(const LCD_Config_t *config);
+
+/**
+ * @brief Ends a batch started with HAL_LCD_BatchBegin.
+ *
+ * The outermost end closes the transport and releases the bus it claimed.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ */
+static void HAL_LCD_BatchEnd(const LCD_Config_t *config);
+
+/**
+ * @brief Waits until the displays have executed the last write.
  *
- * This function sends a 4-bit command or data to the LCD module using the 4-bit mode
- * based on the provided configuration and value. It sequentially sets the 4 data pins
- * (4 most significant bits first) to transmit the specified value to the LCD.
+ * Polls the busy flag with LCD_READ_BUSY, otherwise waits the worst-case
+ * execution time of the write (none for short writes on a self-paced transport).
  *
  * @param[in] config Pointer to the LCD configuration structure.
- * @param[in] value The 4-bit value to be sent to the LCD.
- * @note This function assumes that the required GPIO and timing functions have been initialized separately.
+ * @param[in] value The byte just written.
+ * @param[in] rs DIO_LOW if it was a command, DIO_HIGH for data.
+ */
+static void HAL_LCD_WaitReady(const LCD_Config_t *config, uint8_t value, uint8_t rs);
+
+/**
+ * @brief Marks the controller state of a bus unknown and hands the mirror to a configuration.
+ *
+ * @param[in] config Pointer to the LCD configuration structure about to write.
  */
-static void HAL_LCD_Send4Bits(const LCD_Config_t *config, uint8_t value);
+static void HAL_LCD_MirrorReset(const LCD_Config_t *config);
 
 /**
- * @brief Sends 8-bit data to the LCD.
+ * @brief Updates the mirror for a command and tells whether the command changes anything.
  *
- * This function sends an 8-bit command or data to the LCD module based on the provided
- * configuration and value. It sequentially sets the 8 data pins to transmit the specified
- * value to the LCD.
+ * Counts the command as sent or, if it is redundant, as dropped.
+ *
+ * @param[in] bus Pointer to the bus.
+ * @param[in] command The command.
+ * @return 1 if the controller state already matches what the command sets, 0 otherwise.
+ */
+static uint8_t HAL_LCD_MirrorCommand(LCD_Bus_t *bus, uint8_t command);
+
+/**
+ * @brief Updates the mirror for a data write: the address counter moves, the display may shift.
+ *
+ * @param[in] bus Pointer to the bus.
+ * @param[in] character The byte written to DDRAM or CGRAM.
+ */
+static void HAL_LCD_MirrorData(LCD_Bus_t *bus, uint8_t character);
+
+/**
+ * @brief Set-address command for the address counter one step on.
+ *
+ * Follows the 2-line DDRAM layout (0x27 runs into 0x40, 0x67 back into 0x00)
+ * and the 64-byte CGRAM.
+ *
+ * @param[in] address Set-address command of the current address, or _LCD_MIRROR_UNKNOWN.
+ * @param[in] increment 1 to count up, 0 to count down.
+ * @return The set-address command of the next address, or _LCD_MIRROR_UNKNOWN.
+ */
+static uint8_t HAL_LCD_MirrorStep(uint8_t address, uint8_t increment);
+
+/**
+ * @brief Transport: prepares the lines of a bus (see LCD_BusInit).
+ *
+ * @param[in] bus Pointer to the bus.
+ */
+static void HAL_LCD_TransportInit(LCD_Bus_t *bus);
+
+/**
+ * @brief Transport: opens a batch (the I2C transaction of the PCF8574).
+ *
+ * On failure the caller still closes the transport, then gives the batch up.
  *
  * @param[in] config Pointer to the LCD configuration structure.
- * @param[in] value The 8-bit value to be sent to the LCD.
- * @note This function assumes that the required GPIO and timing functions have been initialized separately.
+ * @return E_OK if the batch can be sent, E_NOT_OK otherwise.
+ */
+static Std_ReturnType HAL_LCD_TransportOpen(const LCD_Config_t *config);
+
+/**
+ * @brief Transport: closes the batch opened by HAL_LCD_TransportOpen.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ */
+static void HAL_LCD_TransportClose(const LCD_Config_t *config);
+
+/**
+ * @brief Transport: clocks the upper nibble of a value into every display.
+ *
+ * In 8-bit mode the whole value is latched, which is what the
+ * initialization sequence needs from a nibble.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] value The nibble in bits 4-7.
+ * @param[in] rs DIO_LOW for a command, DIO_HIGH for data.
+ */
+static void HAL_LCD_TransportSendNibble(const LCD_Config_t *config, uint8_t value, uint8_t rs);
+
+/**
+ * @brief Transport: clocks a byte into every display, as one transfer in
+ * 8-bit mode or as two nibbles (4 most significant bits first) in 4-bit mode.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in] value The byte.
+ * @param[in] rs DIO_LOW for a command, DIO_HIGH for data.
+ */
+static void HAL_LCD_TransportSendByte(const LCD_Config_t *config, uint8_t value, uint8_t rs);
+
+#if LCD_READ_BUSY
+/**
+ * @brief Transport: reads the busy flag of every display of a configuration.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @return 1 while any of the displays is busy, 0 when all are ready.
+ */
+static uint8_t HAL_LCD_TransportReadBusy(const LCD_Config_t *config);
+#endif
+
+#if LCD_TRANSPORT == LCD_TRANSPORT_PARALLEL
+/**
+ * @brief Drives the data pins of the bus to a value, touching only pins that change.
+ *
+ * In 4-bit mode the nibble in bits 4-7 of the value goes to data pins 0-3.
+ *
+ * @param[in] bus Pointer to the bus.
+ * @param[in] value The levels to drive.
+ */
+static void HAL_LCD_LatchData(LCD_Bus_t *bus, uint8_t value);
+
+/**
+ * @brief Pulses the enable pin of every display of a configuration in turn.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ */
+static void HAL_LCD_PulseEnables(const LCD_Config_t *config);
+#endif
+
+#if _LCD_EXPANDER
+/**
+ * @brief Drives the eight expander outputs (one 74HC595 shift and latch, or one I2C byte).
+ *
+ * @param[in] bus Pointer to the bus.
+ * @param[in] value The output levels.
+ */
+static void HAL_LCD_ExpanderWrite(LCD_Bus_t *bus, uint8_t value);
+
+/**
+ * @brief Expander outputs of the enable lines of a configuration.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @return A mask with the enable output of every display set.
+ */
+static uint8_t HAL_LCD_ExpanderEnables(const LCD_Config_t *config);
+#endif
+
+/**
+ * @brief Checks a configuration and sets up its enable lines, the part of the init before the script.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @return E_OK if the configuration is valid, E_NOT_OK otherwise.
+ */
+static Std_ReturnType HAL_LCD_InitBegin(const LCD_Config_t *config);
+
+/**
+ * @brief Finishes the init after the script: big-digit font, DDRAM address and a blank frame buffer.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ */
+static void HAL_LCD_InitEnd(const LCD_Config_t *config);
+
+/**
+ * @brief Plays one script instruction.
+ *
+ * @param[in] config Pointer to the LCD configuration structure.
+ * @param[in,out] script Pointer to the instruction, moved past it.
+ * @param[out] delayMs Milliseconds to wait before the next instruction, 0 for none.
+ * @return 1 if the script goes on, 0 at its end.
+ */
+static uint8_t HAL_LCD_ScriptStep(const LCD_Config_t *config, const uint8_t **script, uint8_t *delayMs);
+
+/**
+ * @brief Draws one big glyph (digit or minus sign) into the frame buffer.
+ *
+ * @param[in] x The leftmost column of the glyph.
+ * @param[in] glyph Index in the big glyph table (0-9, or _LCD_BIG_MINUS).
+ * @param[in] width Number of columns to draw.
+ */
+static void HAL_LCD_BufferPutBigGlyph(uint8_t x, uint8_t glyph, uint8_t width);
+
+/**
+ * @brief Sets or clears the dirty flag of every cell of the frame buffer.
+ *
+ * @param[in] dirty 1 to mark every cell for the next flush, 0 when the LCD already matches the buffer.
  */
-static void HAL_LCD_Send8Bits(const LCD_Config_t *config, uint8_t value);
+static void HAL_LCD_BufferMarkAll(uint8_t dirty);
 
 
 #endif /**< CLCD_PRIVATE_H */
@@ -6,114 +6,262 @@
 #include "BIT_MATH.h"
 /*****************************< MCAL *****************************/
 #include "DIO_interface.h"
+#include "TMR0_interface.h"
+#include "TMR0_config.h"
+#include "TWI_interface.h"
 #include <util/delay.h>
+#include <avr/pgmspace.h>
 /*****************************< HAL *****************************/
 #include "CLCD_interface.h"
-#include "CLCD_private.h"
 #include "CLCD_config.h"
+#include "CLCD_private.h"
+#include "PROF_interface.h"
+
+/*****************************< Geometry checks *****************************/
+#if (LCD_ROWS < 1) || (LCD_ROWS > _LCD_MAX_ROWS)
+#error "LCD_ROWS must be 1 to 4"
+#endif
+
+#if (LCD_COLUMNS < 1) || (LCD_COLUMNS > _LCD_DDRAM_LINE_LENGTH)
+#error "LCD_COLUMNS must be 1 to 40"
+#endif
+
+#if !_LCD_ROW_FITS(LCD_ROW0_START) || \
+    ((LCD_ROWS > 1) && !_LCD_ROW_FITS(LCD_ROW1_START)) || \
+    ((LCD_ROWS > 2) && !_LCD_ROW_FITS(LCD_ROW2_START)) || \
+    ((LCD_ROWS > 3) && !_LCD_ROW_FITS(LCD_ROW3_START))
+#error "Every row of the LCD geometry must lie within one DDRAM line (0x00-0x27 or 0x40-0x67)"
+#endif
+
+#if ((LCD_ROWS > 1) && _LCD_ROWS_OVERLAP(LCD_ROW0_START, LCD_ROW1_START)) || \
+    ((LCD_ROWS > 2) && (_LCD_ROWS_OVERLAP(LCD_ROW0_START, LCD_ROW2_START) || \
+                        _LCD_ROWS_OVERLAP(LCD_ROW1_START, LCD_ROW2_START))) || \
+    ((LCD_ROWS > 3) && (_LCD_ROWS_OVERLAP(LCD_ROW0_START, LCD_ROW3_START) || \
+                        _LCD_ROWS_OVERLAP(LCD_ROW1_START, LCD_ROW3_START) || \
+                        _LCD_ROWS_OVERLAP(LCD_ROW2_START, LCD_ROW3_START)))
+#error "Rows of the LCD geometry overlap in DDRAM"
+#endif
+
+/*****************************< Private Variables *****************************/
+/**
+ * @brief Geometry of the panel, built from CLCD_config.h.
+ * Stored in program memory; read it with pgm_read_byte.
+ */
+static const LCD_Geometry_t LCD_Geometry PROGMEM = {
+    LCD_ROWS, LCD_COLUMNS, {LCD_ROW0_START, LCD_ROW1_START, LCD_ROW2_START, LCD_ROW3_START}
+};
+
+static uint8_t LCD_FrameBuffer[LCD_ROWS][LCD_COLUMNS];       /**< Characters the screen should show */
+static uint8_t LCD_DirtyCells[LCD_ROWS][_LCD_DIRTY_BYTES];   /**< Bit x%8 of byte x/8 set: cell x is not on the LCD yet */
+static u16 LCD_MarqueePeriod = 0;                            /**< Ticks between marquee steps, 0 when stopped */
+static u32 LCD_MarqueeLastTick = 0;                          /**< Tick at which the last step was due */
+static LCD_CommandStats_t LCD_CommandStats;                  /**< Commands sent and dropped since the last reset */
+static const LCD_Config_t *LCD_ScriptConfig = NULL;          /**< LCD of the background script, NULL when none plays */
+static const uint8_t *LCD_Script;                            /**< Next instruction of the background script */
+static u32 LCD_ScriptDelayTicks = 0;                         /**< Ticks the background script waits, 0 when not waiting */
+static u32 LCD_ScriptDelayStart = 0;                         /**< Tick at which the wait began */
+static uint8_t LCD_ScriptInit = 0;                           /**< 1 if the background script is an LCD_InitStart */
+
+/**
+ * @brief Reset sequence of the HD44780 datasheet: three 8-bit function sets
+ * bring the controller to 8-bit mode from any state, then the bus width,
+ * two lines, a cleared display, incrementing cursor and display on.
+ */
+static const uint8_t LCD_DefaultInitScript[] PROGMEM = {
+    LCD_SCRIPT_DELAY_MS, _LCD_POWER_ON_MS,
+    LCD_SCRIPT_RESET, LCD_SCRIPT_DELAY_MS, _LCD_RESET_MS,
+    LCD_SCRIPT_RESET, LCD_SCRIPT_DELAY_US, _LCD_RESET_US10,
+    LCD_SCRIPT_RESET, LCD_SCRIPT_DELAY_US, _LCD_RESET_US10,
+    LCD_SCRIPT_INTERFACE, LCD_SCRIPT_DELAY_US, _LCD_RESET_US10,
+    LCD_SCRIPT_FUNCTION_SET, LCD_FUNCTION_2_LINES,
+    LCD_SCRIPT_COMMAND(4), _LCD_CLEAR, _LCD_RETURN_HOME, _LCD_ENTRY_MODE_INC_SHIFT_OFF,
+                           _LCD_DISPLAY_ON_UNDERLINE_OFF_CURSOR_OFF,
+    LCD_SCRIPT_END
+};
+
+/**
+ * @brief Segment glyphs of the big digits, loaded into CGRAM slots 0-7.
+ */
+static const uint8_t LCD_BigDigitSegments[_LCD_CUSTOM_CHARS][8] PROGMEM = {
+    {0x07, 0x0F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F}, /**< 0: upper left corner */
+    {0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00}, /**< 1: upper bar */
+    {0x1C, 0x1E, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F}, /**< 2: upper right corner */
+    {0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x0F, 0x07}, /**< 3: lower left corner */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F}, /**< 4: lower bar */
+    {0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1E, 0x1C}, /**< 5: lower right corner */
+    {0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x1F, 0x1F}, /**< 6: upper and middle bars */
+    {0x1F, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F}  /**< 7: middle and lower bars */
+};
+
+/**
+ * @brief Cells of the big digits 0-9 and the minus sign: top row, then bottom row.
+ *
+ * 0x00-0x07 are the segment glyphs, 0x20 is a blank and 0xFF the full block of
+ * the character ROM.
+ */
+static const uint8_t LCD_BigGlyphs[11][2][_LCD_BIG_DIGIT_WIDTH] PROGMEM = {
+    {{0x00, 0x01, 0x02}, {0x03, 0x04, 0x05}}, /**< 0 */
+    {{0x01, 0x02, 0x20}, {0x04, 0xFF, 0x04}}, /**< 1 */
+    {{0x06, 0x06, 0x02}, {0x03, 0x04, 0x04}}, /**< 2 */
+    {{0x06, 0x06, 0x02}, {0x04, 0x04, 0x05}}, /**< 3 */
+    {{0x03, 0x04, 0xFF}, {0x20, 0x20, 0xFF}}, /**< 4 */
+    {{0x03, 0x06, 0x06}, {0x04, 0x04, 0x05}}, /**< 5 */
+    {{0x00, 0x06, 0x06}, {0x03, 0x04, 0x05}}, /**< 6 */
+    {{0x01, 0x01, 0x02}, {0x20, 0x20, 0xFF}}, /**< 7 */
+    {{0x00, 0x06, 0x02}, {0x03, 0x07, 0x05}}, /**< 8 */
+    {{0x00, 0x06, 0x02}, {0x04, 0x04, 0x05}}, /**< 9 */
+    {{0x04, 0x04, 0x20}, {0x20, 0x20, 0x20}}  /**< - */
+};
 
 /*****************************< Function Implementations *****************************/
-void LCD_Init(const LCD_Config_t *config) 
+void LCD_BusInit(LCD_Bus_t *bus)
 {
-    if(config == NULL)
+    if((bus == NULL) || ((bus->mode != LCD_4BitMode) && (bus->mode != LCD_8BitMode)))
     {
         return;
     }
 
-    /**< Init the Mode of the en, rs, rw */
-    DIO_SetPinDirection(config->enablePin.LCD_PortId, config->enablePin.LCD_PinId, DIO_OUTPUT);
-    DIO_SetPinDirection(config->rsPin.LCD_PortId, config->rsPin.LCD_PinId, DIO_OUTPUT);
-    DIO_SetPinDirection(config->rwPin.LCD_PortId, config->rwPin.LCD_PinId, DIO_OUTPUT);
-
-    if(config->mode == LCD_4BitMode)
-    {
-        /**< Init the Mode of Data Pins */
-        for(uint8_t i = 0; i < 4; i++)
-        {
-            DIO_SetPinDirection(config->dataPins[i].LCD_PortId, config->dataPins[i].LCD_PinId, DIO_OUTPUT);
-        }
-    }
-    else if(LCD_8BitMode)
-    {
-        for(uint8_t i = 0; i < 8; i++)
-        {
-            DIO_SetPinDirection(config->dataPins[i].LCD_PortId, config->dataPins[i].LCD_PinId, DIO_OUTPUT);
-        }
-    }
-    else
+#if _LCD_EXPANDER
+    /**< Only D4-D7 reach the expander outputs */
+    if(bus->mode != LCD_4BitMode)
     {
         return;
     }
-    
-    _delay_ms(20);
-    LCD_SendCommand(config, _LCD_8BIT_MODE_2_LINE);
-    _delay_ms(5);
-    LCD_SendCommand(config, _LCD_8BIT_MODE_2_LINE);
-    _delay_us(150);
-    LCD_SendCommand(config, _LCD_8BIT_MODE_2_LINE);
+#endif
 
-    LCD_SendCommand(config, _LCD_CLEAR);
-    LCD_SendCommand(config, _LCD_RETURN_HOME);
-    LCD_SendCommand(config, _LCD_ENTRY_MODE_INC_SHIFT_OFF);
-    LCD_SendCommand(config, _LCD_DISPLAY_ON_UNDERLINE_OFF_CURSOR_OFF);
-    if(config->mode == LCD_4BitMode)
-    {
-        LCD_SendCommand(config, _LCD_4BIT_MODE_2_LINE);
-    }
-    LCD_SendCommand(config, 0x80);
+    bus->owner = NULL;
+    bus->batchDepth = 0;
+    bus->batchClaimed = 0;
+    bus->mirrorOwner = NULL;
+    HAL_LCD_TransportInit(bus);
 }
 
-void LCD_SendCommand(const LCD_Config_t *config, uint8_t command) 
+Std_ReturnType LCD_BusAcquire(const LCD_Config_t *config)
 {
-    /**< Set RS pin to low for command --> RS = 0 */
-    DIO_SetPinValue(config->rsPin.LCD_PortId, config->rsPin.LCD_PinId, DIO_LOW);
-    /**< Set RW pin to low for write  --> RW = 0 */
-    DIO_SetPinValue(config->rwPin.LCD_PortId, config->rwPin.LCD_PinId, DIO_LOW);
+    Std_ReturnType Local_FunctionState = E_NOT_OK;
+    u8 Local_Sreg;
 
-    if(config->mode == LCD_4BitMode)
+    if((config == NULL) || (config->bus == NULL))
     {
-        HAL_LCD_Send4Bits(config, command);
+        return E_NOT_OK;
     }
-    else if(config->mode == LCD_8BitMode)
+
+    /**< Test and set with interrupts off, an ISR may be writing to another display */
+    Local_Sreg = _LCD_SREG_R;
+    __asm__ __volatile__ ("cli" ::: "memory");
+    if((config->bus->owner == NULL) || (config->bus->owner == config))
     {
-        HAL_LCD_Send8Bits(config, command);
+        config->bus->owner = config;
+        Local_FunctionState = E_OK;
     }
-    else
+    _LCD_SREG_R = Local_Sreg;
+
+    return Local_FunctionState;
+}
+
+void LCD_BusRelease(const LCD_Config_t *config)
+{
+    if((config != NULL) && (config->bus != NULL) && (config->bus->owner == config))
     {
-        return;
+        config->bus->owner = NULL;
     }
 }
 
-void LCD_SendChar(const LCD_Config_t *config, uint8_t character) 
+void LCD_Init(const LCD_Config_t *config) 
 {
-    /**< Set RS pin to low for command --> RS = 0 */
-    DIO_SetPinValue(config->rsPin.LCD_PortId, config->rsPin.LCD_PinId, DIO_HIGH);
-    /**< Set RW pin to low for write  --> RW = 0 */
-    DIO_SetPinValue(config->rwPin.LCD_PortId, config->rwPin.LCD_PinId, DIO_LOW);
+    LCD_InitWithScript(config, LCD_DefaultInitScript);
+}
 
-    if(config->mode == LCD_4BitMode)
+void LCD_InitWithScript(const LCD_Config_t *config, const uint8_t *script)
+{
+    if((script == NULL) || (HAL_LCD_InitBegin(config) != E_OK))
     {
-        HAL_LCD_Send4Bits(config, character);
+        return;
     }
-    else if(config->mode == LCD_8BitMode)
+
+    if(HAL_LCD_BatchBegin(config) != E_OK)
     {
-        HAL_LCD_Send8Bits(config, character);
+        return;
     }
-    else
+
+    /**< Whatever the controller held before is about to be reset */
+    HAL_LCD_MirrorReset(config);
+
+    LCD_ScriptRun(config, script);
+    HAL_LCD_InitEnd(config);
+    HAL_LCD_BatchEnd(config);
+}
+
+Std_ReturnType LCD_InitStart(const LCD_Config_t *config, const uint8_t *script)
+{
+    if(HAL_LCD_InitBegin(config) != E_OK)
     {
-        return;
+        return E_NOT_OK;
     }
+
+    /**< Whatever the controller held before is about to be reset */
+    HAL_LCD_MirrorReset(config);
+    LCD_ScriptStart(config, (script != NULL) ? script : LCD_DefaultInitScript);
+    LCD_ScriptInit = 1;
+
+    return E_OK;
+}
+
+Std_ReturnType LCD_SendCommand(const LCD_Config_t *config, uint8_t command) 
+{
+    /**< RS = 0 for command */
+    return HAL_LCD_Write(config, command, DIO_LOW);
+}
+
+Std_ReturnType LCD_SendChar(const LCD_Config_t *config, uint8_t character) 
+{
+    /**< RS = 1 for data */
+    return HAL_LCD_Write(config, character, DIO_HIGH);
 }
 
-void LCD_SendString(const LCD_Config_t *config, const uint8_t *string) 
+Std_ReturnType LCD_SendString(const LCD_Config_t *config, const uint8_t *string) 
 {
     uint8_t Local_Counter = 0;
     
+    /**< One claim of the bus (one I2C transaction) for the whole string */
+    if((string == NULL) || (HAL_LCD_BatchBegin(config) != E_OK))
+    {
+        return E_NOT_OK;
+    }
+
+    PROF_ENTER(PROF_LCD_SEND_STRING);
     while(string[Local_Counter] != '\0')
     {
         LCD_SendChar(config, string[Local_Counter]);
         Local_Counter++;
     }
+
+    HAL_LCD_BatchEnd(config);
+    PROF_EXIT(PROF_LCD_SEND_STRING);
+
+    return E_OK;
+}
+
+Std_ReturnType LCD_SendString_P(const LCD_Config_t *config, const uint8_t *string) 
+{
+    uint8_t Local_Character;
+    
+    if((string == NULL) || (HAL_LCD_BatchBegin(config) != E_OK))
+    {
+        return E_NOT_OK;
+    }
+
+    Local_Character = pgm_read_byte(string);
+    while(Local_Character != '\0')
+    {
+        LCD_SendChar(config, Local_Character);
+        string++;
+        Local_Character = pgm_read_byte(string);
+    }
+
+    HAL_LCD_BatchEnd(config);
+
+    return E_OK;
 }
 
 void LCD_SendIntegerNumber(const LCD_Config_t *config, s32 number) {
@@ -164,27 +312,23 @@ void LCD_SendNumber(const LCD_Config_t *config, double number) {
 
 void LCD_Clear(const LCD_Config_t *config) 
 {
+    /**< Clearing also cancels any display shift, so a marquee cannot keep running */
+    LCD_MarqueePeriod = 0;
     LCD_SendCommand(config, _LCD_CLEAR);
+
+    /**< The LCD now shows what a cleared buffer holds */
+    LCD_BufferClear();
+    HAL_LCD_BufferMarkAll(0);
 }
 
 void LCD_GoToXYPos(const LCD_Config_t *config, uint8_t x, uint8_t y) {
     /**< Check if the coordinates are within bounds */ 
-    if ((y < 2) && (x >= 0 && x <= 15)) {
-        u8 localAddress = 0;
-
-        switch (y) {
-            case 0:
-                localAddress = x;
-                break;
-            case 1:
-                localAddress = x + _LCD_CGRAM_START;
-                break;
-            default:
-                break;
-        }
+    if ((y < LCD_ROWS) && (x < LCD_COLUMNS)) {
+        // DDRAM address of the row start, from the geometry table
+        u8 localAddress = pgm_read_byte(&LCD_Geometry.rowStart[y]) + x;
 
         // Calculate the final address to move the cursor
-        u8 command = localAddress | (1 << 7); // Or simply: localAddress + 0x80;
+        u8 command = localAddress | _LCD_DDRAM_START;
         LCD_SendCommand(config, command);
     }
     else
@@ -193,52 +337,1120 @@ void LCD_GoToXYPos(const LCD_Config_t *config, uint8_t x, uint8_t y) {
     }
 }
 
-/*****************************< Private helper function to send 4 bits *****************************/ 
-static void HAL_LCD_Send4Bits(const LCD_Config_t *config, uint8_t value) 
+void LCD_GetGeometry(LCD_Geometry_t *geometry)
 {
-    /**< Send the 4-MSB */
-    for(uint8_t i = 0; i < 4; i++)
+    if(geometry != NULL)
     {
-        DIO_SetPinValue(config->dataPins[i].LCD_PortId, config->dataPins[i].LCD_PinId, value >> (4 + i) & 0x01);
+        memcpy_P(geometry, &LCD_Geometry, sizeof(LCD_Geometry_t));
     }
+}
 
-    /**< Set the enable pin to high */
-    DIO_SetPinValue(config->enablePin.LCD_PortId, config->enablePin.LCD_PinId, DIO_HIGH);
-    /**< Set the Pulse time to be 5msec */
-    _delay_ms(5);
-    /**< Set the enable pin to low */
-    DIO_SetPinValue(config->enablePin.LCD_PortId, config->enablePin.LCD_PinId, DIO_LOW);
+Std_ReturnType LCD_DefineCustomChar(const LCD_Config_t *config, const CustomChar_t *customChar)
+{
+    if((config == NULL) || (customChar == NULL) || (customChar->charIndex >= _LCD_CUSTOM_CHARS))
+    {
+        return E_NOT_OK;
+    }
 
-    /**< Shift the 4-LSB command to the 4-MSB */
-    value <<= 4;
+    if(HAL_LCD_BatchBegin(config) != E_OK)
+    {
+        return E_NOT_OK;
+    }
 
-    /**< Send the 4-LSB */
-    for(uint8_t i = 0; i < 4; i++)
+    /**< Set the CGRAM address of the slot, then write its 8 rows */
+    LCD_SendCommand(config, _LCD_CGRAM_START + customChar->charIndex * 8);
+    for(uint8_t i = 0; i < 8; i++)
     {
-    	DIO_SetPinValue(config->dataPins[i].LCD_PortId, config->dataPins[i].LCD_PinId, value >> (4 + i) & 0x01);
+        LCD_SendChar(config, customChar->pattern[i]);
     }
 
-    /**< Set the enable pin to high */
-    DIO_SetPinValue(config->enablePin.LCD_PortId, config->enablePin.LCD_PinId, DIO_HIGH);
-    /**< Set the Pulse time to be 5msec */
-    _delay_ms(5);
-    /**< Set the enable pin to low */
-    DIO_SetPinValue(config->enablePin.LCD_PortId, config->enablePin.LCD_PinId, DIO_LOW);
+    HAL_LCD_BatchEnd(config);
+
+    return E_OK;
 }
 
-/*****************************< Private helper function to send 8 bits *****************************/ 
-static void HAL_LCD_Send8Bits(const LCD_Config_t *config, uint8_t value) 
+Std_ReturnType LCD_DefineCustomChar_P(const LCD_Config_t *config, const CustomChar_t *customChar)
 {
-     /**< Send the 8-Bit */
+    uint8_t Local_CharIndex;
+
+    if((config == NULL) || (customChar == NULL))
+    {
+        return E_NOT_OK;
+    }
+
+    Local_CharIndex = pgm_read_byte(&customChar->charIndex);
+    if(Local_CharIndex >= _LCD_CUSTOM_CHARS)
+    {
+        return E_NOT_OK;
+    }
+
+    if(HAL_LCD_BatchBegin(config) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    LCD_SendCommand(config, _LCD_CGRAM_START + Local_CharIndex * 8);
     for(uint8_t i = 0; i < 8; i++)
     {
-        DIO_SetPinValue(config->dataPins[i].LCD_PortId, config->dataPins[i].LCD_PinId, value >> i & 0x01);
+        LCD_SendChar(config, pgm_read_byte(&customChar->pattern[i]));
+    }
+
+    HAL_LCD_BatchEnd(config);
+
+    return E_OK;
+}
+
+void LCD_LoadBigDigitFont(const LCD_Config_t *config)
+{
+    if(HAL_LCD_BatchBegin(config) != E_OK)
+    {
+        return;
+    }
+
+    /**< The slots are consecutive in CGRAM, so one address command covers all 64 rows */
+    LCD_SendCommand(config, _LCD_CGRAM_START);
+    for(uint8_t i = 0; i < _LCD_CUSTOM_CHARS * 8; i++)
+    {
+        LCD_SendChar(config, pgm_read_byte(&LCD_BigDigitSegments[0][0] + i));
+    }
+
+    /**< Back to DDRAM so following text is not written into CGRAM */
+    LCD_SendCommand(config, _LCD_DDRAM_START);
+    HAL_LCD_BatchEnd(config);
+}
+
+void LCD_BufferClear(void)
+{
+    for(uint8_t y = 0; y < LCD_ROWS; y++)
+    {
+        for(uint8_t x = 0; x < LCD_COLUMNS; x++)
+        {
+            LCD_BufferPutChar(x, y, ' ');
+        }
+    }
+}
+
+void LCD_BufferPutChar(uint8_t x, uint8_t y, uint8_t character)
+{
+    if((x < LCD_COLUMNS) && (y < LCD_ROWS) && (LCD_FrameBuffer[y][x] != character))
+    {
+        LCD_FrameBuffer[y][x] = character;
+        SET_BIT(LCD_DirtyCells[y][x / 8], x % 8);
+    }
+}
+
+void LCD_BufferPutString(uint8_t x, uint8_t y, const uint8_t *string)
+{
+    if(string == NULL)
+    {
+        return;
+    }
+
+    while((*string != '\0') && (x < LCD_COLUMNS))
+    {
+        LCD_BufferPutChar(x, y, *string);
+        string++;
+        x++;
+    }
+}
+
+Std_ReturnType LCD_BufferPutBigNumber(s32 number)
+{
+    u8 Local_Digits[10];
+    u8 Local_Count = 0;
+    u8 Local_Width;
+    u32 Local_Magnitude = (number < 0) ? -(u32)number : (u32)number;
+    uint8_t x;
+
+    /**< Extract the digits, least significant first */
+    do {
+        Local_Digits[Local_Count] = Local_Magnitude % 10;
+        Local_Magnitude /= 10;
+        Local_Count++;
+    } while (Local_Magnitude != 0);
+
+    /**< One blank column between glyphs */
+    Local_Width = Local_Count * (_LCD_BIG_DIGIT_WIDTH + 1) - 1;
+    if(number < 0)
+    {
+        Local_Width += _LCD_BIG_MINUS_WIDTH + 1;
+    }
+    if((LCD_ROWS < 2) || (Local_Width > LCD_COLUMNS))
+    {
+        return E_NOT_OK;
+    }
+
+    /**< Blank the columns left of the number, right-align the glyphs */
+    for(x = 0; x < LCD_COLUMNS - Local_Width; x++)
+    {
+        LCD_BufferPutChar(x, 0, _LCD_BIG_BLANK);
+        LCD_BufferPutChar(x, 1, _LCD_BIG_BLANK);
+    }
+
+    if(number < 0)
+    {
+        HAL_LCD_BufferPutBigGlyph(x, _LCD_BIG_MINUS, _LCD_BIG_MINUS_WIDTH + 1);
+        x += _LCD_BIG_MINUS_WIDTH + 1;
+    }
+
+    while(Local_Count > 0)
+    {
+        Local_Count--;
+        HAL_LCD_BufferPutBigGlyph(x, Local_Digits[Local_Count], _LCD_BIG_DIGIT_WIDTH);
+        x += _LCD_BIG_DIGIT_WIDTH;
+        if(Local_Count > 0)
+        {
+            LCD_BufferPutChar(x, 0, _LCD_BIG_BLANK);
+            LCD_BufferPutChar(x, 1, _LCD_BIG_BLANK);
+            x++;
+        }
+    }
+
+    return E_OK;
+}
+
+void LCD_BufferInvalidate(void)
+{
+    HAL_LCD_BufferMarkAll(1);
+}
+
+void LCD_Flush(const LCD_Config_t *config)
+{
+    /**< With the bus taken the cells stay dirty for the next flush */
+    if(HAL_LCD_BatchBegin(config) != E_OK)
+    {
+        return;
+    }
+
+    for(uint8_t y = 0; y < LCD_ROWS; y++)
+    {
+        uint8_t Local_Cursor = LCD_COLUMNS; /**< Column the address counter points at, if on this row */
+
+        for(uint8_t x = 0; x < LCD_COLUMNS; x++)
+        {
+            /**< Skip eight clean cells at a time */
+            if(((x % 8) == 0) && (LCD_DirtyCells[y][x / 8] == 0))
+            {
+                x += 7;
+                continue;
+            }
+
+            if(GET_BIT(LCD_DirtyCells[y][x / 8], x % 8))
+            {
+                if(Local_Cursor != x)
+                {
+                    LCD_GoToXYPos(config, x, y);
+                }
+                LCD_SendChar(config, LCD_FrameBuffer[y][x]);
+                CLR_BIT(LCD_DirtyCells[y][x / 8], x % 8);
+                Local_Cursor = x + 1;
+            }
+        }
+    }
+
+    HAL_LCD_BatchEnd(config);
+}
+
+void LCD_ShiftDisplay(const LCD_Config_t *config, LCD_ShiftDirection_t direction)
+{
+    LCD_SendCommand(config, (direction == LCD_SHIFT_LEFT) ? _LCD_DISPLAY_SHIFT_LEFT : _LCD_DISPLAY_SHIFT_RIGHT);
+}
+
+Std_ReturnType LCD_MarqueeLoad(const LCD_Config_t *config, uint8_t y, const uint8_t *string)
+{
+    uint8_t Local_Character;
+    uint8_t Local_Line;
+    uint8_t Local_Length;
+
+    if((config == NULL) || (string == NULL) || (y >= LCD_ROWS))
+    {
+        return E_NOT_OK;
+    }
+
+    /**< The line would run through the other row sharing it, e.g. rows 0 and 2 of a 20x4 panel */
+    Local_Line = pgm_read_byte(&LCD_Geometry.rowStart[y]) & _LCD_DDRAM_LINE_MASK;
+    for(uint8_t row = 0; row < LCD_ROWS; row++)
+    {
+        if((row != y) && ((pgm_read_byte(&LCD_Geometry.rowStart[row]) & _LCD_DDRAM_LINE_MASK) == Local_Line))
+        {
+            return E_NOT_OK;
+        }
+    }
+
+    /**< The address counter runs through the invisible columns up to the end of the line */
+    Local_Length = _LCD_DDRAM_LINE_LENGTH - (pgm_read_byte(&LCD_Geometry.rowStart[y]) & ~_LCD_DDRAM_LINE_MASK);
+    if(HAL_LCD_BatchBegin(config) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    LCD_GoToXYPos(config, 0, y);
+    for(uint8_t x = 0; x < Local_Length; x++)
+    {
+        Local_Character = ' ';
+        if(*string != '\0')
+        {
+            Local_Character = *string;
+            string++;
+        }
+        LCD_SendChar(config, Local_Character);
+
+        if(x < LCD_COLUMNS)
+        {
+            LCD_FrameBuffer[y][x] = Local_Character;
+            CLR_BIT(LCD_DirtyCells[y][x / 8], x % 8);
+        }
+    }
+
+    HAL_LCD_BatchEnd(config);
+
+    return (*string == '\0') ? E_OK : E_NOT_OK;
+}
+
+void LCD_MarqueeStart(const LCD_Config_t *config, u16 period)
+{
+    if((config == NULL) || (period == 0))
+    {
+        return;
+    }
+
+    LCD_MarqueePeriod = period;
+    LCD_MarqueeLastTick = TMR0_GetTicks();
+}
+
+Std_ReturnType LCD_MarqueeUpdate(const LCD_Config_t *config)
+{
+    u32 Local_Now = TMR0_GetTicks();
+
+    if((config == NULL) || (LCD_MarqueePeriod == 0) ||
+       ((u32)(Local_Now - LCD_MarqueeLastTick) < LCD_MarqueePeriod))
+    {
+        return E_NOT_OK;
+    }
+
+    /**< Steady pace; after a long stall resume from now instead of catching up */
+    LCD_MarqueeLastTick += LCD_MarqueePeriod;
+    if((u32)(Local_Now - LCD_MarqueeLastTick) >= LCD_MarqueePeriod)
+    {
+        LCD_MarqueeLastTick = Local_Now;
+    }
+
+    /**< One command per frame instead of rewriting the whole row */
+    LCD_ShiftDisplay(config, LCD_SHIFT_LEFT);
+
+    return E_OK;
+}
+
+void LCD_MarqueeStop(const LCD_Config_t *config)
+{
+    LCD_MarqueePeriod = 0;
+
+    /**< Return home also cancels the display shift */
+    LCD_SendCommand(config, _LCD_RETURN_HOME);
+}
+
+Std_ReturnType LCD_ScriptRun(const LCD_Config_t *config, const uint8_t *script)
+{
+    uint8_t Local_DelayMs;
+
+    if((script == NULL) || (HAL_LCD_BatchBegin(config) != E_OK))
+    {
+        return E_NOT_OK;
+    }
+
+    while(HAL_LCD_ScriptStep(config, &script, &Local_DelayMs))
+    {
+        while(Local_DelayMs > 0)
+        {
+            _delay_ms(1);
+            Local_DelayMs--;
+        }
+    }
+
+    HAL_LCD_BatchEnd(config);
+
+    return E_OK;
+}
+
+Std_ReturnType LCD_ScriptStart(const LCD_Config_t *config, const uint8_t *script)
+{
+    if((config == NULL) || (script == NULL))
+    {
+        return E_NOT_OK;
+    }
+
+    LCD_ScriptConfig = config;
+    LCD_Script = script;
+    LCD_ScriptDelayTicks = 0;
+    LCD_ScriptInit = 0;
+
+    return E_OK;
+}
+
+Std_ReturnType LCD_ScriptUpdate(void)
+{
+    const LCD_Config_t *Local_Config = LCD_ScriptConfig;
+    uint8_t Local_DelayMs;
+
+    /**< The wait began somewhere inside a tick: one tick more so it is never short */
+    if((Local_Config == NULL) ||
+       ((LCD_ScriptDelayTicks != 0) && ((u32)(TMR0_GetTicks() - LCD_ScriptDelayStart) <= LCD_ScriptDelayTicks)))
+    {
+        return E_NOT_OK;
+    }
+
+    /**< With the bus taken the script waits for the next call */
+    if(HAL_LCD_BatchBegin(Local_Config) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    LCD_ScriptDelayTicks = 0;
+    for(uint8_t i = 0; i < LCD_SCRIPT_STEPS; i++)
+    {
+        if(!HAL_LCD_ScriptStep(Local_Config, &LCD_Script, &Local_DelayMs))
+        {
+            if(LCD_ScriptInit)
+            {
+                HAL_LCD_InitEnd(Local_Config);
+                LCD_ScriptInit = 0;
+            }
+            LCD_ScriptConfig = NULL;
+            break;
+        }
+        if(Local_DelayMs != 0)
+        {
+            LCD_ScriptDelayTicks = _LCD_MS_TO_TICKS(Local_DelayMs);
+            LCD_ScriptDelayStart = TMR0_GetTicks();
+            break;
+        }
     }
 
-    /**< Set the enable pin to high */
-    DIO_SetPinValue(config->enablePin.LCD_PortId, config->enablePin.LCD_PinId, DIO_HIGH);
-    /**< Set the Pulse time to be 5msec */
-    _delay_ms(5);
-    /**< Set the enable pin to low */
-    DIO_SetPinValue(config->enablePin.LCD_PortId, config->enablePin.LCD_PinId, DIO_LOW);
+    HAL_LCD_BatchEnd(Local_Config);
+
+    return E_OK;
+}
+
+uint8_t LCD_ScriptIsRunning(void)
+{
+    return LCD_ScriptConfig != NULL;
+}
+
+void LCD_GetCommandStats(LCD_CommandStats_t *stats)
+{
+    if(stats != NULL)
+    {
+        *stats = LCD_CommandStats;
+    }
+}
+
+void LCD_ResetCommandStats(void)
+{
+    LCD_CommandStats.sent = 0;
+    LCD_CommandStats.address = 0;
+    LCD_CommandStats.entryMode = 0;
+    LCD_CommandStats.displayControl = 0;
+    LCD_CommandStats.home = 0;
+    LCD_CommandStats.clear = 0;
+}
+
+/*****************************< Private helper functions to write a byte *****************************/
+static Std_ReturnType HAL_LCD_Write(const LCD_Config_t *config, uint8_t value, uint8_t rs)
+{
+    /**< Another display holds the bus: nothing is sent and the mirror stays as it is */
+    if(HAL_LCD_BatchBegin(config) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    /**< The mirror follows one configuration per bus; a write through another starts it over */
+    if(config->bus->mirrorOwner != config)
+    {
+        HAL_LCD_MirrorReset(config);
+    }
+
+    if(rs == DIO_HIGH)
+    {
+        HAL_LCD_MirrorData(config->bus, value);
+    }
+    else if(HAL_LCD_MirrorCommand(config->bus, value) && LCD_ELIDE_COMMANDS)
+    {
+        /**< Nothing would change: save the transfer and the execution time */
+        HAL_LCD_BatchEnd(config);
+        return E_OK;
+    }
+
+    HAL_LCD_TransportSendByte(config, value, rs);
+    HAL_LCD_WaitReady(config, value, rs);
+
+    HAL_LCD_BatchEnd(config);
+
+    return E_OK;
+}
+
+static Std_ReturnType HAL_LCD_BatchBegin(const LCD_Config_t *config)
+{
+    LCD_Bus_t *Local_Bus;
+    uint8_t Local_Claimed;
+
+    if((config == NULL) || (config->bus == NULL))
+    {
+        return E_NOT_OK;
+    }
+    Local_Bus = config->bus;
+
+    if(Local_Bus->batchDepth == 0)
+    {
+        /**< Hold the bus for the batch only, unless the caller already holds it */
+        Local_Claimed = (Local_Bus->owner != config);
+        if(LCD_BusAcquire(config) != E_OK)
+        {
+            return E_NOT_OK;
+        }
+        Local_Bus->batchClaimed = Local_Claimed;
+        if(HAL_LCD_TransportOpen(config) != E_OK)
+        {
+            /**< The expander is out of reach: nothing of the batch may be sent */
+            HAL_LCD_TransportClose(config);
+            if(Local_Claimed)
+            {
+                LCD_BusRelease(config);
+            }
+            return E_NOT_OK;
+        }
+    }
+    else if(Local_Bus->owner != config)
+    {
+        return E_NOT_OK;
+    }
+
+    Local_Bus->batchDepth++;
+
+    return E_OK;
+}
+
+static void HAL_LCD_BatchEnd(const LCD_Config_t *config)
+{
+    LCD_Bus_t *Local_Bus = config->bus;
+
+    if(Local_Bus->batchDepth == 0)
+    {
+        return;
+    }
+
+    Local_Bus->batchDepth--;
+    if(Local_Bus->batchDepth == 0)
+    {
+        HAL_LCD_TransportClose(config);
+        if(Local_Bus->batchClaimed)
+        {
+            LCD_BusRelease(config);
+        }
+    }
+}
+
+static void HAL_LCD_WaitReady(const LCD_Config_t *config, uint8_t value, uint8_t rs)
+{
+#if LCD_READ_BUSY
+    for(u16 i = 0; (i < _LCD_BUSY_POLLS) && HAL_LCD_TransportReadBusy(config); i++);
+#else
+    if((rs == DIO_LOW) && (value <= _LCD_SLOW_COMMAND_LAST))
+    {
+        /**< Clear display and return home */
+        _delay_ms(_LCD_SLOW_COMMAND_MS);
+    }
+    else if(!_LCD_SELF_PACED)
+    {
+        _delay_us(_LCD_EXECUTION_US);
+    }
+#endif
+}
+
+static void HAL_LCD_TransportSendByte(const LCD_Config_t *config, uint8_t value, uint8_t rs)
+{
+    PROF_ENTER(PROF_LCD_SEND_BYTE);
+    /**< In 8-bit mode the "nibble" is the whole byte */
+    HAL_LCD_TransportSendNibble(config, value, rs);
+    if(config->bus->mode == LCD_4BitMode)
+    {
+        /**< Shift the 4-LSB to the 4-MSB, then send them */
+        HAL_LCD_TransportSendNibble(config, value << 4, rs);
+    }
+    PROF_EXIT(PROF_LCD_SEND_BYTE);
+}
+
+/*****************************< Private helper functions to initialize *****************************/
+static Std_ReturnType HAL_LCD_InitBegin(const LCD_Config_t *config)
+{
+    if((config == NULL) || (config->bus == NULL) ||
+       (config->enableCount == 0) || (config->enableCount > LCD_MAX_ENABLES))
+    {
+        return E_NOT_OK;
+    }
+
+#if LCD_TRANSPORT == LCD_TRANSPORT_PARALLEL
+    /**< Init the Mode of the en pins; data, rs and rw belong to the bus */
+    for(uint8_t i = 0; i < config->enableCount; i++)
+    {
+        DIO_SetPinDirection(config->enablePins[i].LCD_PortId, config->enablePins[i].LCD_PinId, DIO_OUTPUT);
+        DIO_SetPinValue(config->enablePins[i].LCD_PortId, config->enablePins[i].LCD_PinId, DIO_LOW);
+    }
+#endif
+
+    return E_OK;
+}
+
+static void HAL_LCD_InitEnd(const LCD_Config_t *config)
+{
+#if LCD_BIG_DIGITS
+    /**< Segments stay in CGRAM, so big digits later cost only DDRAM writes */
+    LCD_LoadBigDigitFont(config);
+#endif
+    LCD_SendCommand(config, _LCD_DDRAM_START);
+
+    /**< The init script cleared the display */
+    LCD_BufferClear();
+    HAL_LCD_BufferMarkAll(0);
+}
+
+/*****************************< Private helper functions to play scripts *****************************/
+static uint8_t HAL_LCD_ScriptStep(const LCD_Config_t *config, const uint8_t **script, uint8_t *delayMs)
+{
+    const uint8_t *Local_Script = *script;
+    uint8_t Local_Opcode = pgm_read_byte(Local_Script++);
+    uint8_t Local_Count = Local_Opcode & _LCD_SCRIPT_COUNT_MASK;
+    uint8_t Local_Continue = 1;
+    CustomChar_t Local_Glyph;
+
+    *delayMs = 0;
+
+    switch(Local_Opcode & _LCD_SCRIPT_OPCODE_MASK)
+    {
+    case LCD_SCRIPT_COMMAND(0):
+        for(; Local_Count > 0; Local_Count--)
+        {
+            LCD_SendCommand(config, pgm_read_byte(Local_Script++));
+        }
+        break;
+
+    case LCD_SCRIPT_DATA(0):
+        for(; Local_Count > 0; Local_Count--)
+        {
+            LCD_SendChar(config, pgm_read_byte(Local_Script++));
+        }
+        break;
+
+    default:
+        switch(Local_Opcode)
+        {
+        case LCD_SCRIPT_RESET:
+            /**< Controller state is unknown until the reset is through */
+            HAL_LCD_MirrorReset(config);
+            HAL_LCD_TransportSendNibble(config, _LCD_FUNCTION_SET_8BIT, DIO_LOW);
+            break;
+
+        case LCD_SCRIPT_INTERFACE:
+            if(config->bus->mode == LCD_4BitMode)
+            {
+                /**< Still a single nibble, every byte after it is sent as two */
+                HAL_LCD_TransportSendNibble(config, _LCD_FUNCTION_SET_4BIT, DIO_LOW);
+            }
+            break;
+
+        case LCD_SCRIPT_FUNCTION_SET:
+            LCD_SendCommand(config, _LCD_FUNCTION_SET | pgm_read_byte(Local_Script++) |
+                                    ((config->bus->mode == LCD_8BitMode) ? _LCD_FUNCTION_8BIT : 0));
+            break;
+
+        case LCD_SCRIPT_GOTO:
+            LCD_GoToXYPos(config, pgm_read_byte(Local_Script), pgm_read_byte(Local_Script + 1));
+            Local_Script += 2;
+            break;
+
+        case LCD_SCRIPT_GLYPH:
+            Local_Glyph.charIndex = pgm_read_byte(Local_Script++);
+            for(uint8_t i = 0; i < _LCD_SCRIPT_GLYPH_ROWS; i++)
+            {
+                Local_Glyph.pattern[i] = pgm_read_byte(Local_Script++);
+            }
+            LCD_DefineCustomChar(config, &Local_Glyph);
+            break;
+
+        case LCD_SCRIPT_DELAY_MS:
+            *delayMs = pgm_read_byte(Local_Script++);
+            break;
+
+        case LCD_SCRIPT_DELAY_US:
+            for(Local_Count = pgm_read_byte(Local_Script++); Local_Count > 0; Local_Count--)
+            {
+                _delay_us(10);
+            }
+            break;
+
+        default:
+            /**< LCD_SCRIPT_END, or a byte that is no instruction: stop there */
+            Local_Script--;
+            Local_Continue = 0;
+            break;
+        }
+        break;
+    }
+
+    *script = Local_Script;
+
+    return Local_Continue;
+}
+
+/*****************************< Private helper functions to mirror the controller state *****************************/
+static void HAL_LCD_MirrorReset(const LCD_Config_t *config)
+{
+    LCD_Bus_t *Local_Bus = config->bus;
+
+    Local_Bus->mirrorOwner = config;
+    Local_Bus->mirrorAddress = _LCD_MIRROR_UNKNOWN;
+    Local_Bus->mirrorEntryMode = _LCD_MIRROR_UNKNOWN;
+    Local_Bus->mirrorDisplay = _LCD_MIRROR_UNKNOWN;
+    Local_Bus->mirrorFlags = _LCD_MIRROR_SHIFTED;  /**< Not known to be blank, maybe shifted */
+}
+
+static uint8_t HAL_LCD_MirrorCommand(LCD_Bus_t *bus, uint8_t command)
+{
+    uint8_t Local_Redundant = 0;
+    u16 *Local_Counter = &LCD_CommandStats.sent;
+
+    if(command >= _LCD_CGRAM_START)
+    {
+        /**< Set CGRAM or DDRAM address */
+        Local_Redundant = (command == bus->mirrorAddress);
+        Local_Counter = &LCD_CommandStats.address;
+        bus->mirrorAddress = command;
+        if((command >= _LCD_DDRAM_START) &&
+           ((command & ~(_LCD_DDRAM_START | _LCD_DDRAM_LINE_MASK)) > _LCD_DDRAM_LINE1_LAST))
+        {
+            bus->mirrorAddress = _LCD_MIRROR_UNKNOWN;  /**< Between the DDRAM lines, where counting is undefined */
+        }
+    }
+    else if(command >= _LCD_FUNCTION_SET)
+    {
+        /**< Interface width and line count are fixed by LCD_Init, not mirrored */
+    }
+    else if(command >= _LCD_CURSOR_SHIFT)
+    {
+        if(command & _LCD_SHIFT_DISPLAY)
+        {
+            bus->mirrorFlags |= _LCD_MIRROR_SHIFTED;
+        }
+        else
+        {
+            bus->mirrorAddress = HAL_LCD_MirrorStep(bus->mirrorAddress, (command & _LCD_SHIFT_RIGHT) != 0);
+        }
+    }
+    else if(command >= _LCD_DISPLAY_CONTROL)
+    {
+        Local_Redundant = (command == bus->mirrorDisplay);
+        Local_Counter = &LCD_CommandStats.displayControl;
+        bus->mirrorDisplay = command;
+    }
+    else if(command >= _LCD_ENTRY_MODE)
+    {
+        Local_Redundant = (command == bus->mirrorEntryMode);
+        Local_Counter = &LCD_CommandStats.entryMode;
+        bus->mirrorEntryMode = command;
+    }
+    else if(command >= _LCD_RETURN_HOME)
+    {
+        Local_Redundant = (bus->mirrorAddress == _LCD_DDRAM_START) && !(bus->mirrorFlags & _LCD_MIRROR_SHIFTED);
+        Local_Counter = &LCD_CommandStats.home;
+        bus->mirrorAddress = _LCD_DDRAM_START;
+        bus->mirrorFlags &= ~_LCD_MIRROR_SHIFTED;
+    }
+    else if(command == _LCD_CLEAR)
+    {
+        /**< Clear also sets I/D; an unknown entry mode has it clear, so it is never taken as redundant */
+        Local_Redundant = (bus->mirrorFlags == _LCD_MIRROR_BLANK) && (bus->mirrorAddress == _LCD_DDRAM_START) &&
+                          (bus->mirrorEntryMode & _LCD_ENTRY_INCREMENT);
+        Local_Counter = &LCD_CommandStats.clear;
+        bus->mirrorAddress = _LCD_DDRAM_START;
+        bus->mirrorFlags = _LCD_MIRROR_BLANK;
+        if(bus->mirrorEntryMode != _LCD_MIRROR_UNKNOWN)
+        {
+            bus->mirrorEntryMode |= _LCD_ENTRY_INCREMENT;
+        }
+    }
+
+    if(Local_Redundant)
+    {
+        (*Local_Counter)++;
+    }
+    else
+    {
+        LCD_CommandStats.sent++;
+    }
+
+    return Local_Redundant;
+}
+
+static void HAL_LCD_MirrorData(LCD_Bus_t *bus, uint8_t character)
+{
+    /**< Into DDRAM, or possibly so when the address is unknown */
+    if((bus->mirrorAddress >= _LCD_DDRAM_START) || (bus->mirrorAddress == _LCD_MIRROR_UNKNOWN))
+    {
+        if(character != ' ')
+        {
+            bus->mirrorFlags &= ~_LCD_MIRROR_BLANK;
+        }
+        if((bus->mirrorEntryMode == _LCD_MIRROR_UNKNOWN) || (bus->mirrorEntryMode & _LCD_ENTRY_SHIFT))
+        {
+            bus->mirrorFlags |= _LCD_MIRROR_SHIFTED;
+        }
+    }
+
+    bus->mirrorAddress = (bus->mirrorEntryMode == _LCD_MIRROR_UNKNOWN) ? _LCD_MIRROR_UNKNOWN :
+                         HAL_LCD_MirrorStep(bus->mirrorAddress, (bus->mirrorEntryMode & _LCD_ENTRY_INCREMENT) != 0);
+}
+
+static uint8_t HAL_LCD_MirrorStep(uint8_t address, uint8_t increment)
+{
+    uint8_t Local_Address;
+
+    if(address >= _LCD_DDRAM_START)
+    {
+        Local_Address = address & ~_LCD_DDRAM_START;
+        if(increment)
+        {
+            Local_Address = (Local_Address == _LCD_DDRAM_LINE1_LAST) ? _LCD_DDRAM_LINE_MASK :
+                            (Local_Address == _LCD_DDRAM_LINE2_LAST) ? 0x00 : Local_Address + 1;
+        }
+        else
+        {
+            Local_Address = (Local_Address == 0x00) ? _LCD_DDRAM_LINE2_LAST :
+                            (Local_Address == _LCD_DDRAM_LINE_MASK) ? _LCD_DDRAM_LINE1_LAST : Local_Address - 1;
+        }
+        return _LCD_DDRAM_START | Local_Address;
+    }
+
+    if(address >= _LCD_CGRAM_START)
+    {
+        Local_Address = (uint8_t)(increment ? (address + 1) : (address - 1)) & (_LCD_CGRAM_SIZE - 1);
+        return _LCD_CGRAM_START | Local_Address;
+    }
+
+    return _LCD_MIRROR_UNKNOWN;
+}
+
+#if LCD_TRANSPORT == LCD_TRANSPORT_PARALLEL
+/*****************************< Transport: parallel GPIO *****************************/ 
+static void HAL_LCD_TransportInit(LCD_Bus_t *bus)
+{
+    /**< Init the Mode of the rs, rw; rw stays low except to read the busy flag */
+    DIO_SetPinDirection(bus->rsPin.LCD_PortId, bus->rsPin.LCD_PinId, DIO_OUTPUT);
+    DIO_SetPinDirection(bus->rwPin.LCD_PortId, bus->rwPin.LCD_PinId, DIO_OUTPUT);
+    DIO_SetPinValue(bus->rsPin.LCD_PortId, bus->rsPin.LCD_PinId, DIO_LOW);
+    DIO_SetPinValue(bus->rwPin.LCD_PortId, bus->rwPin.LCD_PinId, DIO_LOW);
+
+    /**< Init the Mode of Data Pins, 4 or 8 of them */
+    for(uint8_t i = 0; i < bus->mode; i++)
+    {
+        DIO_SetPinDirection(bus->dataPins[i].LCD_PortId, bus->dataPins[i].LCD_PinId, DIO_OUTPUT);
+        DIO_SetPinValue(bus->dataPins[i].LCD_PortId, bus->dataPins[i].LCD_PinId, DIO_LOW);
+    }
+
+    /**< Every line is low now, later writes only touch pins that change */
+    bus->latchedData = 0x00;
+    bus->latchedRs = DIO_LOW;
+}
+
+static Std_ReturnType HAL_LCD_TransportOpen(const LCD_Config_t *config)
+{
+    /**< Nothing to open, the pins are always driven */
+    return E_OK;
+}
+
+static void HAL_LCD_TransportClose(const LCD_Config_t *config)
+{
+}
+
+static void HAL_LCD_TransportSendNibble(const LCD_Config_t *config, uint8_t value, uint8_t rs)
+{
+    LCD_Bus_t *Local_Bus = config->bus;
+
+    if(Local_Bus->latchedRs != rs)
+    {
+        DIO_SetPinValue(Local_Bus->rsPin.LCD_PortId, Local_Bus->rsPin.LCD_PinId, rs);
+        Local_Bus->latchedRs = rs;
+    }
+
+    HAL_LCD_LatchData(Local_Bus, value);
+    HAL_LCD_PulseEnables(config);
+}
+
+#if LCD_READ_BUSY
+static uint8_t HAL_LCD_TransportReadBusy(const LCD_Config_t *config)
+{
+    LCD_Bus_t *Local_Bus = config->bus;
+    LCD_PinConfig_t Local_Flag = Local_Bus->dataPins[Local_Bus->mode - 1]; /**< D7 */
+    uint8_t Local_Busy = 0;
+    uint8_t Local_Level;
+
+    /**< Release the data lines to the displays; the latched levels come back afterwards */
+    for(uint8_t i = 0; i < Local_Bus->mode; i++)
+    {
+        DIO_SetPinDirection(Local_Bus->dataPins[i].LCD_PortId, Local_Bus->dataPins[i].LCD_PinId, DIO_INPUT);
+    }
+    if(Local_Bus->latchedRs != DIO_LOW)
+    {
+        DIO_SetPinValue(Local_Bus->rsPin.LCD_PortId, Local_Bus->rsPin.LCD_PinId, DIO_LOW);
+        Local_Bus->latchedRs = DIO_LOW;
+    }
+    DIO_SetPinValue(Local_Bus->rwPin.LCD_PortId, Local_Bus->rwPin.LCD_PinId, DIO_HIGH);
+
+    /**< One display at a time, they would fight over D7 */
+    for(uint8_t i = 0; (i < config->enableCount) && (i < LCD_MAX_ENABLES); i++)
+    {
+        DIO_SetPinValue(config->enablePins[i].LCD_PortId, config->enablePins[i].LCD_PinId, DIO_HIGH);
+        _delay_us(1);
+        DIO_GetPinValue(Local_Flag.LCD_PortId, Local_Flag.LCD_PinId, &Local_Level);
+        DIO_SetPinValue(config->enablePins[i].LCD_PortId, config->enablePins[i].LCD_PinId, DIO_LOW);
+        Local_Busy |= Local_Level;
+
+        if(Local_Bus->mode == LCD_4BitMode)
+        {
+            /**< Clock out the low nibble (address counter) too */
+            DIO_SetPinValue(config->enablePins[i].LCD_PortId, config->enablePins[i].LCD_PinId, DIO_HIGH);
+            _delay_us(1);
+            DIO_SetPinValue(config->enablePins[i].LCD_PortId, config->enablePins[i].LCD_PinId, DIO_LOW);
+        }
+    }
+
+    DIO_SetPinValue(Local_Bus->rwPin.LCD_PortId, Local_Bus->rwPin.LCD_PinId, DIO_LOW);
+    for(uint8_t i = 0; i < Local_Bus->mode; i++)
+    {
+        DIO_SetPinDirection(Local_Bus->dataPins[i].LCD_PortId, Local_Bus->dataPins[i].LCD_PinId, DIO_OUTPUT);
+    }
+
+    return Local_Busy;
+}
+#endif
+
+static void HAL_LCD_LatchData(LCD_Bus_t *bus, uint8_t value)
+{
+    uint8_t Local_Changed;
+
+    if(bus->mode == LCD_4BitMode)
+    {
+        /**< Data pins 0-3 carry bits 4-7 */
+        value &= 0xF0;
+        Local_Changed = value ^ bus->latchedData;
+        for(uint8_t i = 0; i < 4; i++)
+        {
+            if(GET_BIT(Local_Changed, (4 + i)))
+            {
+                DIO_SetPinValue(bus->dataPins[i].LCD_PortId, bus->dataPins[i].LCD_PinId, GET_BIT(value, (4 + i)));
+            }
+        }
+    }
+    else
+    {
+        Local_Changed = value ^ bus->latchedData;
+        for(uint8_t i = 0; i < 8; i++)
+        {
+            if(GET_BIT(Local_Changed, i))
+            {
+                DIO_SetPinValue(bus->dataPins[i].LCD_PortId, bus->dataPins[i].LCD_PinId, GET_BIT(value, i));
+            }
+        }
+    }
+
+    bus->latchedData = value;
+}
+
+static void HAL_LCD_PulseEnables(const LCD_Config_t *config)
+{
+    /**< The data is already on the bus, clock it into each display in turn */
+    for(uint8_t i = 0; (i < config->enableCount) && (i < LCD_MAX_ENABLES); i++)
+    {
+        DIO_SetPinValue(config->enablePins[i].LCD_PortId, config->enablePins[i].LCD_PinId, DIO_HIGH);
+        _delay_us(1);
+        DIO_SetPinValue(config->enablePins[i].LCD_PortId, config->enablePins[i].LCD_PinId, DIO_LOW);
+    }
+}
+#endif
+
+#if _LCD_EXPANDER
+/*****************************< Transport: 8-bit expander (74HC595 or PCF8574) *****************************/ 
+static void HAL_LCD_TransportSendNibble(const LCD_Config_t *config, uint8_t value, uint8_t rs)
+{
+    LCD_Bus_t *Local_Bus = config->bus;
+    uint8_t Local_Port = (value & _LCD_EXPANDER_DATA_MASK) | (1 << LCD_EXPANDER_BACKLIGHT_BIT);
+
+    if(rs == DIO_HIGH)
+    {
+        SET_BIT(Local_Port, LCD_EXPANDER_RS_BIT);
+    }
+
+    /**< RS and R/W must settle before an enable rises, data only before it falls */
+    if((Local_Port ^ Local_Bus->latchedData) & ((1 << LCD_EXPANDER_RS_BIT) | (1 << LCD_EXPANDER_RW_BIT)))
+    {
+        HAL_LCD_ExpanderWrite(Local_Bus, Local_Port);
+    }
+
+    /**< All displays take the same data, so their enables rise and fall together */
+    HAL_LCD_ExpanderWrite(Local_Bus, Local_Port | HAL_LCD_ExpanderEnables(config));
+    HAL_LCD_ExpanderWrite(Local_Bus, Local_Port);
+}
+
+static uint8_t HAL_LCD_ExpanderEnables(const LCD_Config_t *config)
+{
+    uint8_t Local_Enables = 0;
+
+    for(uint8_t i = 0; (i < config->enableCount) && (i < LCD_MAX_ENABLES); i++)
+    {
+        SET_BIT(Local_Enables, config->enablePins[i].LCD_PinId);
+    }
+
+    return Local_Enables;
+}
+#endif
+
+#if LCD_TRANSPORT == LCD_TRANSPORT_HC595
+/*****************************< Transport: 74HC595 shift register *****************************/ 
+static void HAL_LCD_TransportInit(LCD_Bus_t *bus)
+{
+    DIO_SetPinDirection(bus->serialPin.LCD_PortId, bus->serialPin.LCD_PinId, DIO_OUTPUT);
+    DIO_SetPinDirection(bus->shiftClockPin.LCD_PortId, bus->shiftClockPin.LCD_PinId, DIO_OUTPUT);
+    DIO_SetPinDirection(bus->latchPin.LCD_PortId, bus->latchPin.LCD_PinId, DIO_OUTPUT);
+    DIO_SetPinValue(bus->shiftClockPin.LCD_PortId, bus->shiftClockPin.LCD_PinId, DIO_LOW);
+    DIO_SetPinValue(bus->latchPin.LCD_PortId, bus->latchPin.LCD_PinId, DIO_LOW);
+
+    /**< All outputs low but the backlight */
+    HAL_LCD_ExpanderWrite(bus, 1 << LCD_EXPANDER_BACKLIGHT_BIT);
+}
+
+static Std_ReturnType HAL_LCD_TransportOpen(const LCD_Config_t *config)
+{
+    /**< Nothing to open, every write is shifted and latched on its own */
+    return E_OK;
+}
+
+static void HAL_LCD_TransportClose(const LCD_Config_t *config)
+{
+}
+
+static void HAL_LCD_ExpanderWrite(LCD_Bus_t *bus, uint8_t value)
+{
+    uint8_t Local_Serial = 0xFF; /**< Level of the serial pin, unknown at first */
+    uint8_t Local_Bit;
+
+    /**< Most significant bit first: after eight clocks bit n sits on output Qn */
+    for(uint8_t i = 8; i > 0; i--)
+    {
+        Local_Bit = GET_BIT(value, (i - 1));
+        if(Local_Bit != Local_Serial)
+        {
+            DIO_SetPinValue(bus->serialPin.LCD_PortId, bus->serialPin.LCD_PinId, Local_Bit);
+            Local_Serial = Local_Bit;
+        }
+        DIO_SetPinValue(bus->shiftClockPin.LCD_PortId, bus->shiftClockPin.LCD_PinId, DIO_HIGH);
+        DIO_SetPinValue(bus->shiftClockPin.LCD_PortId, bus->shiftClockPin.LCD_PinId, DIO_LOW);
+    }
+
+    /**< All eight outputs change together on the storage clock */
+    DIO_SetPinValue(bus->latchPin.LCD_PortId, bus->latchPin.LCD_PinId, DIO_HIGH);
+    DIO_SetPinValue(bus->latchPin.LCD_PortId, bus->latchPin.LCD_PinId, DIO_LOW);
+
+    bus->latchedData = value;
+}
+#endif
+
+#if LCD_TRANSPORT == LCD_TRANSPORT_PCF8574
+/*****************************< Transport: PCF8574 I2C backpack *****************************/ 
+static void HAL_LCD_TransportInit(LCD_Bus_t *bus)
+{
+    TWI_Init();
+
+    /**< All outputs low but the backlight */
+    bus->latchedData = 1 << LCD_EXPANDER_BACKLIGHT_BIT;
+    TWI_Write(bus->address, &bus->latchedData, 1);
+}
+
+static Std_ReturnType HAL_LCD_TransportOpen(const LCD_Config_t *config)
+{
+    /**< The writes of the batch follow as data bytes of one transaction. The start
+     *   fails while queued TWI transactions run, the address when no backpack answers */
+    if(TWI_Start() != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    return TWI_SendAddress(config->bus->address, TWI_WRITE);
+}
+
+static void HAL_LCD_TransportClose(const LCD_Config_t *config)
+{
+    TWI_Stop();
+}
+
+static void HAL_LCD_ExpanderWrite(LCD_Bus_t *bus, uint8_t value)
+{
+    TWI_WriteByte(value);
+    bus->latchedData = value;
+}
+
+#if LCD_READ_BUSY
+static uint8_t HAL_LCD_TransportReadBusy(const LCD_Config_t *config)
+{
+    LCD_Bus_t *Local_Bus = config->bus;
+    /**< D4-D7 written high are weak pull-ups the displays can drive low */
+    uint8_t Local_Port = _LCD_EXPANDER_DATA_MASK | (1 << LCD_EXPANDER_RW_BIT) | (1 << LCD_EXPANDER_BACKLIGHT_BIT);
+    uint8_t Local_Enable;
+    uint8_t Local_Input = 0;
+    uint8_t Local_Busy = 0;
+
+    /**< Called inside a batch: the write transaction is open */
+    HAL_LCD_ExpanderWrite(Local_Bus, Local_Port);
+
+    /**< One display at a time, they would fight over D7 */
+    for(uint8_t i = 0; (i < config->enableCount) && (i < LCD_MAX_ENABLES); i++)
+    {
+        Local_Enable = 1 << config->enablePins[i].LCD_PinId;
+        HAL_LCD_ExpanderWrite(Local_Bus, Local_Port | Local_Enable);
+
+        /**< Sample the pins with the enable high, then carry on writing */
+        TWI_Start();
+        TWI_SendAddress(Local_Bus->address, TWI_READ);
+        TWI_ReadByte(&Local_Input, 0);
+        TWI_Start();
+        TWI_SendAddress(Local_Bus->address, TWI_WRITE);
+        HAL_LCD_ExpanderWrite(Local_Bus, Local_Port);
+        Local_Busy |= GET_BIT(Local_Input, 7);
+
+        /**< Clock out the low nibble (address counter) too */
+        HAL_LCD_ExpanderWrite(Local_Bus, Local_Port | Local_Enable);
+        HAL_LCD_ExpanderWrite(Local_Bus, Local_Port);
+    }
+
+    return Local_Busy;
+}
+#endif
+#endif
+
+/*****************************< Private helper function to draw a big glyph *****************************/
+static void HAL_LCD_BufferPutBigGlyph(uint8_t x, uint8_t glyph, uint8_t width)
+{
+    for(uint8_t i = 0; i < width; i++)
+    {
+        LCD_BufferPutChar(x + i, 0, pgm_read_byte(&LCD_BigGlyphs[glyph][0][i]));
+        LCD_BufferPutChar(x + i, 1, pgm_read_byte(&LCD_BigGlyphs[glyph][1][i]));
+    }
+}
+
+static void HAL_LCD_BufferMarkAll(uint8_t dirty)
+{
+    for(uint8_t y = 0; y < LCD_ROWS; y++)
+    {
+        for(uint8_t i = 0; i < _LCD_DIRTY_BYTES; i++)
+        {
+            LCD_DirtyCells[y][i] = dirty ? 0xFF : 0x00;
+        }
+    }
 }
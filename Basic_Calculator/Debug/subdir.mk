@@ -4,21 +4,51 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../ANIM_program.c \
+../BOOT_program.c \
 ../CLCD_program.c \
 ../DIO_program.c \
+../EEPROM_program.c \
+../HIST_program.c \
 ../KPD_program.c \
+../LAT_program.c \
+../MEM_program.c \
+../PROF_program.c \
+../TMR0_program.c \
+../TWI_program.c \
+../UART_program.c \
 ../main.c 
 
 OBJS += \
+./ANIM_program.o \
+./BOOT_program.o \
 ./CLCD_program.o \
 ./DIO_program.o \
+./EEPROM_program.o \
+./HIST_program.o \
 ./KPD_program.o \
+./LAT_program.o \
+./MEM_program.o \
+./PROF_program.o \
+./TMR0_program.o \
+./TWI_program.o \
+./UART_program.o \
 ./main.o 
 
 C_DEPS += \
+./ANIM_program.d \
+./BOOT_program.d \
 ./CLCD_program.d \
 ./DIO_program.d \
+./EEPROM_program.d \
+./HIST_program.d \
 ./KPD_program.d \
+./LAT_program.d \
+./MEM_program.d \
+./PROF_program.d \
+./TMR0_program.d \
+./TWI_program.d \
+./UART_program.d \
 ./main.d 
 
 
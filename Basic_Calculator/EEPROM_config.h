@@ -0,0 +1,24 @@
+
+
+#ifndef EEPROM_CONFIG_H_
+#define EEPROM_CONFIG_H_
+
+/**
+ * @brief Write requests that can wait in the queue.
+ */
+#define EEPROM_QUEUE_SIZE           4
+
+/**
+ * @brief Number of cache lines, each holding EEPROM_CACHE_LINE_SIZE consecutive bytes.
+ *
+ * Lines are direct mapped: address / EEPROM_CACHE_LINE_SIZE picks the line.
+ */
+#define EEPROM_CACHE_LINES          4
+
+/**
+ * @brief Bytes per cache line, a power of two from 1 to 64.
+ */
+#define EEPROM_CACHE_LINE_SIZE      8
+
+
+#endif /**< EEPROM_CONFIG_H_ */
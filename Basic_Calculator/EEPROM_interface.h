@@ -0,0 +1,112 @@
+
+
+#ifndef EEPROM_INTERFACE_H_
+#define EEPROM_INTERFACE_H_
+
+/**
+ * @brief Size of the ATmega32 EEPROM in bytes.
+ */
+#define EEPROM_SIZE             1024
+
+/**
+ * @brief State of a queued write.
+ */
+typedef enum {
+    EEPROM_PENDING = 0, /**< Queued or being written */
+    EEPROM_DONE = 1     /**< Every byte holds its new value */
+} EEPROM_Result_t;
+
+typedef struct EEPROM_Request_s EEPROM_Request_t;
+
+/**
+ * @brief Function called from the EE_READY interrupt when a write ends.
+ */
+typedef void (*EEPROM_Callback_t)(EEPROM_Request_t *request);
+
+/**
+ * @brief A write for the interrupt-driven driver.
+ *
+ * The structure and its data belong to the driver from EEPROM_Submit until
+ * the result leaves EEPROM_PENDING; keep them alive (static or global) and
+ * unchanged until then.
+ */
+struct EEPROM_Request_s {
+    u16 address;                      /**< First EEPROM address */
+    const u8 *data;                   /**< Bytes to write */
+    u8 length;                        /**< Number of bytes to write */
+    EEPROM_Callback_t callback;       /**< Called when the write ends, may be NULL */
+    volatile EEPROM_Result_t result;  /**< Set by the driver */
+};
+
+/**
+ * @brief Counters of the bytes the driver went through.
+ */
+typedef struct {
+    u16 written;   /**< Bytes programmed, about 8.5 ms each */
+    u16 skipped;   /**< Bytes that already held their value and were not programmed */
+    u16 hits;      /**< Bytes EEPROM_Read served from the cache */
+    u16 misses;    /**< Bytes EEPROM_Read found only after loading their line from the EEPROM */
+} EEPROM_Stats_t;
+
+/**
+ * @brief Empties the write queue and the read cache.
+ *
+ * Global interrupts must be enabled by the application (sei) for queued
+ * writes to run.
+ */
+void EEPROM_Init(void);
+
+/**
+ * @brief Queues a write and returns without waiting for the EEPROM.
+ *
+ * The bytes are programmed one per EE_READY interrupt, after the requests
+ * queued before it; a byte that already holds its value is skipped, saving
+ * the write time and the wear. The callback is called from the interrupt
+ * once the last byte is in the EEPROM. Reads see the new bytes as soon as
+ * this function returns.
+ *
+ * Example usage:
+ * @code
+ * static u8 settings[4];
+ * static EEPROM_Request_t saveSettings = {0x3F0, settings, 4, NULL, EEPROM_PENDING};
+ * EEPROM_Submit(&saveSettings);
+ * // ... other work ...
+ * if (saveSettings.result == EEPROM_DONE) { ... }
+ * @endcode
+ *
+ * @param[in,out] request Pointer to the request.
+ * @return E_OK if it was queued, E_NOT_OK if it is invalid or the queue is full.
+ */
+Std_ReturnType EEPROM_Submit(EEPROM_Request_t *request);
+
+/**
+ * @brief Tells whether queued writes are still running.
+ *
+ * @return 1 while a write is queued or being programmed, 0 when idle.
+ */
+u8 EEPROM_IsBusy(void);
+
+/**
+ * @brief Reads bytes through the write-through cache.
+ *
+ * Queued writes are included, so a read always returns what the EEPROM will
+ * hold once the queue has drained. A cache miss reads the whole line from the
+ * EEPROM, which first has to wait for the byte being programmed, if any
+ * (up to 8.5 ms).
+ *
+ * @param[in]  address First EEPROM address.
+ * @param[out] data    Buffer for the bytes.
+ * @param[in]  length  Number of bytes to read.
+ * @return E_OK if the bytes were read, E_NOT_OK if the range is outside the EEPROM or data is NULL.
+ */
+Std_ReturnType EEPROM_Read(u16 address, u8 *data, u8 length);
+
+/**
+ * @brief Copies the byte counters gathered since EEPROM_Init.
+ *
+ * @param[out] stats Pointer to the structure to fill.
+ */
+void EEPROM_GetStats(EEPROM_Stats_t *stats);
+
+
+#endif /**< EEPROM_INTERFACE_H_ */
@@ -0,0 +1,78 @@
+
+
+#ifndef EEPROM_PRIVATE_H_
+#define EEPROM_PRIVATE_H_
+
+/**
+ * @brief Macro definitions for the EEPROM registers.
+ */
+#define EEPROM_EEARH_R          (*((volatile u8*)0X3F))
+#define EEPROM_EEARL_R          (*((volatile u8*)0X3E))
+#define EEPROM_EEDR_R           (*((volatile u8*)0X3D))
+#define EEPROM_EECR_R           (*((volatile u8*)0X3C))
+#define EEPROM_SREG_R           (*((volatile u8*)0X5F))
+
+/**
+ * @brief Bit positions of EECR and its I/O address for sbi.
+ */
+#define _EEPROM_EECR_IO         0x1C
+#define _EEPROM_EERIE           3     // EE_READY interrupt enable, fires while EEWE is clear.
+#define _EEPROM_EEMWE           2     // Master write enable, opens a 4-cycle window for EEWE.
+#define _EEPROM_EEWE            1     // Write enable; stays set while the write runs.
+#define _EEPROM_EERE            0     // Read enable.
+
+#define _EEPROM_NO_LINE         0xFFFF  // Tag of an empty cache line.
+
+#if (EEPROM_CACHE_LINE_SIZE < 1) || (EEPROM_CACHE_LINE_SIZE > 64) || \
+    (EEPROM_CACHE_LINE_SIZE & (EEPROM_CACHE_LINE_SIZE - 1))
+#error "EEPROM_CACHE_LINE_SIZE must be a power of two from 1 to 64"
+#endif
+
+#if (EEPROM_CACHE_LINES < 1)
+#error "EEPROM_CACHE_LINES must be at least 1"
+#endif
+
+/**
+ * @brief Starts programming EEDR into EEAR; EEWE must follow EEMWE within 4 cycles.
+ *
+ * Call it with interrupts disabled.
+ */
+#define _EEPROM_START_WRITE()                                           \
+    __asm__ __volatile__ (                                              \
+        "sbi %0, %1 \n"                                                 \
+        "sbi %0, %2 \n"                                                 \
+        :                                                               \
+        : "I" (_EEPROM_EECR_IO), "I" (_EEPROM_EEMWE), "I" (_EEPROM_EEWE) \
+    )
+
+/**
+ * @brief Reads one EEPROM byte; the EEPROM must not be programming.
+ *
+ * @param[in] address The EEPROM address.
+ * @return The byte.
+ */
+static u8 EEPROM_ReadRaw(u16 address);
+
+/**
+ * @brief Loads the cache line holding an address from the EEPROM, with the queued writes on top.
+ *
+ * @param[in] line Index into EEPROM_Cache.
+ * @param[in] tag  Address of the first byte of the line.
+ */
+static void EEPROM_FillLine(u8 line, u16 tag);
+
+/**
+ * @brief Copies the bytes of a request that fall into a cache line.
+ *
+ * @param[in] line    Index into EEPROM_Cache.
+ * @param[in] request The request.
+ */
+static void EEPROM_PatchLine(u8 line, const EEPROM_Request_t *request);
+
+/**
+ * @brief EEPROM ready interrupt (vector 17 on the ATmega32).
+ */
+void __vector_17(void) __attribute__((signal, used));
+
+
+#endif /**< EEPROM_PRIVATE_H_ */
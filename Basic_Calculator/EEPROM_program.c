@@ -0,0 +1,240 @@
+
+
+/*****************************< LIB *****************************/
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+/*****************************< MCAL *****************************/
+#include "EEPROM_interface.h"
+#include "EEPROM_config.h"
+#include "EEPROM_private.h"
+
+/*****************************< Private Variables *****************************/
+static EEPROM_Request_t *EEPROM_Queue[EEPROM_QUEUE_SIZE];  /**< Queued writes, the head one is being programmed */
+static volatile u8 EEPROM_QueueHead = 0;                   /**< Index of the current write */
+static volatile u8 EEPROM_QueueCount = 0;                  /**< Writes queued, the current one included */
+static volatile u8 EEPROM_Index = 0;                       /**< Next byte of the current write */
+static volatile EEPROM_Stats_t EEPROM_Stats;               /**< Byte counters since EEPROM_Init */
+
+/**
+ * The cache is only changed by EEPROM_Submit and EEPROM_Read, never by the
+ * interrupt, and always holds the bytes as they will be once every queued
+ * write is done.
+ */
+static u8 EEPROM_Cache[EEPROM_CACHE_LINES][EEPROM_CACHE_LINE_SIZE];  /**< Cached bytes */
+static u16 EEPROM_CacheTag[EEPROM_CACHE_LINES];                      /**< Address of each line, _EEPROM_NO_LINE when empty */
+
+/*****************************< Function Implementations *****************************/
+void EEPROM_Init(void)
+{
+    u8 Local_Sreg = EEPROM_SREG_R;
+
+    __asm__ __volatile__ ("cli" ::: "memory");
+    CLR_BIT(EEPROM_EECR_R, _EEPROM_EERIE);
+    EEPROM_QueueHead = 0;
+    EEPROM_QueueCount = 0;
+    EEPROM_Index = 0;
+    EEPROM_Stats.written = 0;
+    EEPROM_Stats.skipped = 0;
+    EEPROM_Stats.hits = 0;
+    EEPROM_Stats.misses = 0;
+    for (u8 i = 0; i < EEPROM_CACHE_LINES; i++)
+    {
+        EEPROM_CacheTag[i] = _EEPROM_NO_LINE;
+    }
+    EEPROM_SREG_R = Local_Sreg;
+}
+
+Std_ReturnType EEPROM_Submit(EEPROM_Request_t *request)
+{
+    Std_ReturnType Local_FunctionState = E_NOT_OK;
+    u8 Local_Sreg;
+
+    if ((request == NULL) || (request->data == NULL) || (request->length == 0) ||
+        ((u32)request->address + request->length > EEPROM_SIZE))
+    {
+        return E_NOT_OK;
+    }
+
+    /**< The interrupt moves the head and the count: keep it out while the request goes in */
+    Local_Sreg = EEPROM_SREG_R;
+    __asm__ __volatile__ ("cli" ::: "memory");
+
+    if (EEPROM_QueueCount < EEPROM_QUEUE_SIZE)
+    {
+        request->result = EEPROM_PENDING;
+        EEPROM_Queue[(u8)(EEPROM_QueueHead + EEPROM_QueueCount) % EEPROM_QUEUE_SIZE] = request;
+        EEPROM_QueueCount++;
+        Local_FunctionState = E_OK;
+
+        /**< Write through: cached lines take the new bytes now */
+        for (u8 i = 0; i < EEPROM_CACHE_LINES; i++)
+        {
+            EEPROM_PatchLine(i, request);
+        }
+
+        /**< Fires at once if the EEPROM is idle, otherwise when the running byte is done */
+        SET_BIT(EEPROM_EECR_R, _EEPROM_EERIE);
+    }
+
+    EEPROM_SREG_R = Local_Sreg;
+
+    return Local_FunctionState;
+}
+
+u8 EEPROM_IsBusy(void)
+{
+    return EEPROM_QueueCount != 0;
+}
+
+Std_ReturnType EEPROM_Read(u16 address, u8 *data, u8 length)
+{
+    u16 Local_Address;
+    u16 Local_Tag;
+    u8 Local_Line;
+
+    if ((data == NULL) || ((u32)address + length > EEPROM_SIZE))
+    {
+        return E_NOT_OK;
+    }
+
+    for (u8 i = 0; i < length; i++)
+    {
+        Local_Address = address + i;
+        Local_Tag = Local_Address & ~(u16)(EEPROM_CACHE_LINE_SIZE - 1);
+        Local_Line = (u8)((Local_Address / EEPROM_CACHE_LINE_SIZE) % EEPROM_CACHE_LINES);
+
+        if (EEPROM_CacheTag[Local_Line] == Local_Tag)
+        {
+            EEPROM_Stats.hits++;
+        }
+        else
+        {
+            EEPROM_FillLine(Local_Line, Local_Tag);
+            EEPROM_Stats.misses++;
+        }
+        data[i] = EEPROM_Cache[Local_Line][Local_Address & (EEPROM_CACHE_LINE_SIZE - 1)];
+    }
+
+    return E_OK;
+}
+
+void EEPROM_GetStats(EEPROM_Stats_t *stats)
+{
+    u8 Local_Sreg;
+
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    Local_Sreg = EEPROM_SREG_R;
+    __asm__ __volatile__ ("cli" ::: "memory");
+    stats->written = EEPROM_Stats.written;
+    stats->skipped = EEPROM_Stats.skipped;
+    stats->hits = EEPROM_Stats.hits;
+    stats->misses = EEPROM_Stats.misses;
+    EEPROM_SREG_R = Local_Sreg;
+}
+
+/*****************************< Private helper functions *****************************/
+static u8 EEPROM_ReadRaw(u16 address)
+{
+    EEPROM_EEARH_R = (u8)(address >> 8);
+    EEPROM_EEARL_R = (u8)address;
+    SET_BIT(EEPROM_EECR_R, _EEPROM_EERE);
+
+    return EEPROM_EEDR_R;
+}
+
+static void EEPROM_FillLine(u8 line, u16 tag)
+{
+    u8 Local_Sreg = EEPROM_SREG_R;
+
+    /**< Hold the queue, or the interrupt would start the next byte the moment the running one ends */
+    __asm__ __volatile__ ("cli" ::: "memory");
+    CLR_BIT(EEPROM_EECR_R, _EEPROM_EERIE);
+    EEPROM_SREG_R = Local_Sreg;
+
+    while (GET_BIT(EEPROM_EECR_R, _EEPROM_EEWE));
+
+    __asm__ __volatile__ ("cli" ::: "memory");
+    for (u8 i = 0; i < EEPROM_CACHE_LINE_SIZE; i++)
+    {
+        EEPROM_Cache[line][i] = EEPROM_ReadRaw(tag + i);
+    }
+    EEPROM_CacheTag[line] = tag;
+
+    /**< Bytes still in the queue are newer than the EEPROM; apply them oldest first */
+    for (u8 i = 0; i < EEPROM_QueueCount; i++)
+    {
+        EEPROM_PatchLine(line, EEPROM_Queue[(u8)(EEPROM_QueueHead + i) % EEPROM_QUEUE_SIZE]);
+    }
+
+    if (EEPROM_QueueCount != 0)
+    {
+        SET_BIT(EEPROM_EECR_R, _EEPROM_EERIE);
+    }
+    EEPROM_SREG_R = Local_Sreg;
+}
+
+static void EEPROM_PatchLine(u8 line, const EEPROM_Request_t *request)
+{
+    u16 Local_Tag = EEPROM_CacheTag[line];
+
+    if ((Local_Tag == _EEPROM_NO_LINE) || (request->address >= Local_Tag + EEPROM_CACHE_LINE_SIZE) ||
+        (request->address + request->length <= Local_Tag))
+    {
+        return;  /**< Empty line, or no byte of the request in it */
+    }
+
+    for (u8 i = 0; i < EEPROM_CACHE_LINE_SIZE; i++)
+    {
+        if (((u16)(Local_Tag + i) >= request->address) && ((u16)(Local_Tag + i) < request->address + request->length))
+        {
+            EEPROM_Cache[line][i] = request->data[Local_Tag + i - request->address];
+        }
+    }
+}
+
+/*****************************< Interrupt Service Routines *****************************/
+void __vector_17(void)
+{
+    EEPROM_Request_t *Local_Job = EEPROM_Queue[EEPROM_QueueHead];
+    u16 Local_Address;
+    u8 Local_Byte;
+
+    /**< Program the next byte that differs; equal ones cost a read instead of 8.5 ms and a wear cycle */
+    while (EEPROM_Index < Local_Job->length)
+    {
+        Local_Address = Local_Job->address + EEPROM_Index;
+        Local_Byte = Local_Job->data[EEPROM_Index];
+        EEPROM_Index++;
+
+        if (EEPROM_ReadRaw(Local_Address) == Local_Byte)
+        {
+            EEPROM_Stats.skipped++;
+            continue;
+        }
+
+        /**< EEAR still holds the address from the read */
+        EEPROM_EEDR_R = Local_Byte;
+        _EEPROM_START_WRITE();
+        EEPROM_Stats.written++;
+        return;
+    }
+
+    /**< The last byte is in: the request is done */
+    EEPROM_QueueHead = (u8)(EEPROM_QueueHead + 1) % EEPROM_QUEUE_SIZE;
+    EEPROM_QueueCount--;
+    EEPROM_Index = 0;
+    if (EEPROM_QueueCount == 0)
+    {
+        CLR_BIT(EEPROM_EECR_R, _EEPROM_EERIE);
+    }
+
+    Local_Job->result = EEPROM_DONE;
+    if (Local_Job->callback != NULL)
+    {
+        Local_Job->callback(Local_Job);
+    }
+}
@@ -0,0 +1,22 @@
+
+
+#ifndef HIST_CONFIG_H_
+#define HIST_CONFIG_H_
+
+/**
+ * @brief First EEPROM address of the history log.
+ */
+#define HIST_EEPROM_START       0x000
+
+/**
+ * @brief Number of record slots, a power of two from 2 to 128.
+ *
+ * The log takes HIST_SLOTS * HIST_RECORD_SIZE bytes from HIST_EEPROM_START
+ * (16 slots fill the ATmega32's 1 KB) and keeps the last HIST_SLOTS entries.
+ * Each new record goes to the slot after the newest one, so every slot is
+ * written once per HIST_SLOTS entries.
+ */
+#define HIST_SLOTS              16
+
+
+#endif /**< HIST_CONFIG_H_ */
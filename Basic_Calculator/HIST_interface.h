@@ -0,0 +1,57 @@
+
+
+#ifndef HIST_INTERFACE_H_
+#define HIST_INTERFACE_H_
+
+/**
+ * @brief Size of one record slot in EEPROM.
+ */
+#define HIST_RECORD_SIZE        64
+
+/**
+ * @brief Largest entry HIST_Append takes: the slot minus sequence number, length and CRC.
+ */
+#define HIST_PAYLOAD_SIZE       (HIST_RECORD_SIZE - 4)
+
+/**
+ * @brief Finds the newest record of the log in EEPROM.
+ *
+ * Records carry a 16-bit sequence number that grows by one per entry, so
+ * around the ring the numbers count up to the newest record and then drop;
+ * a binary search finds that point with log2(HIST_SLOTS) record reads.
+ * Slots that fail their CRC (never written, or cut by a power loss) end the
+ * log. Reads go through the EEPROM driver: call EEPROM_Init first.
+ */
+void HIST_Init(void);
+
+/**
+ * @brief Queues an entry for the log and returns without waiting for the EEPROM.
+ *
+ * The record is written in the background by the EEPROM driver from its
+ * interrupt (enable interrupts with sei); it becomes the newest entry once
+ * its last byte is in. Bytes equal to what the slot already holds are not
+ * programmed again.
+ *
+ * @param[in] payload The entry.
+ * @param[in] length  Its size, 1 to HIST_PAYLOAD_SIZE.
+ * @return E_OK if it was queued, E_NOT_OK if the previous entry is still being written or the arguments are invalid.
+ */
+Std_ReturnType HIST_Append(const void *payload, u8 length);
+
+/**
+ * @brief Returns the number of entries in the log, at most HIST_SLOTS.
+ */
+u8 HIST_Count(void);
+
+/**
+ * @brief Reads an entry back.
+ *
+ * @param[in]  age     0 for the newest entry, 1 for the one before, and so on.
+ * @param[out] payload Buffer for the entry.
+ * @param[in]  size    Size of the buffer.
+ * @return The length of the entry, or 0 if there is no such entry, it does not fit in the buffer or it fails its CRC.
+ */
+u8 HIST_Get(u8 age, void *payload, u8 size);
+
+
+#endif /**< HIST_INTERFACE_H_ */
@@ -0,0 +1,58 @@
+
+
+#ifndef HIST_PRIVATE_H_
+#define HIST_PRIVATE_H_
+
+#define HIST_SREG_R         (*((volatile u8*)0X5F))
+
+/**
+ * @brief Record layout inside a slot.
+ *
+ * The CRC-8 covers the sequence number, the length and the payload.
+ */
+#define _HIST_SEQ           0     // Sequence number, 2 bytes little endian.
+#define _HIST_LENGTH        2     // Payload length, 1 to HIST_PAYLOAD_SIZE.
+#define _HIST_CRC           3     // CRC-8.
+#define _HIST_PAYLOAD       4     // Payload, length bytes.
+
+#define _HIST_NO_HEAD       0xFF  // HIST_Head of an empty log.
+
+#if (HIST_SLOTS < 2) || (HIST_SLOTS > 128) || (HIST_SLOTS & (HIST_SLOTS - 1))
+#error "HIST_SLOTS must be a power of two from 2 to 128"
+#endif
+
+#if (HIST_EEPROM_START + HIST_SLOTS * HIST_RECORD_SIZE) > EEPROM_SIZE
+#error "The history log does not fit in the EEPROM"
+#endif
+
+/**
+ * @brief EEPROM address of a slot.
+ */
+#define _HIST_SLOT_ADDRESS(slot)    (HIST_EEPROM_START + (u16)(slot) * HIST_RECORD_SIZE)
+
+/**
+ * @brief Reads and checks the record of a slot.
+ *
+ * @param[in]  slot    The slot.
+ * @param[out] record  Buffer of HIST_RECORD_SIZE bytes for the record.
+ * @return 1 if the record is complete and its CRC matches, 0 otherwise.
+ */
+static u8 HIST_ReadRecord(u8 slot, u8 *record);
+
+/**
+ * @brief CRC-8 (polynomial 0x31, initial value 0xFF) of a record without its CRC byte.
+ *
+ * @param[in] record The record.
+ * @return The CRC.
+ */
+static u8 HIST_Crc(const u8 *record);
+
+/**
+ * @brief Makes the written record the newest one; called from the EEPROM interrupt.
+ *
+ * @param[in] request The finished write.
+ */
+static void HIST_WriteDone(EEPROM_Request_t *request);
+
+
+#endif /**< HIST_PRIVATE_H_ */
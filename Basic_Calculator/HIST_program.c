@@ -0,0 +1,198 @@
+
+
+/*****************************< LIB *****************************/
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+/*****************************< MCAL *****************************/
+#include "EEPROM_interface.h"
+/*****************************< HAL *****************************/
+#include "HIST_interface.h"
+#include "HIST_config.h"
+#include "HIST_private.h"
+
+/*****************************< Private Variables *****************************/
+static volatile u8 HIST_Head = _HIST_NO_HEAD;  /**< Slot of the newest record */
+static volatile u8 HIST_Entries = 0;           /**< Valid records, at most HIST_SLOTS */
+static u16 HIST_NextSeq = 0;                   /**< Sequence number of the next record */
+static u8 HIST_Pending[HIST_RECORD_SIZE];      /**< Record being written */
+static u8 HIST_PendingSlot = 0;                /**< Slot HIST_Pending goes to */
+static EEPROM_Request_t HIST_Request = {0, HIST_Pending, 0, HIST_WriteDone, EEPROM_DONE};  /**< Write of HIST_Pending */
+
+/*****************************< Function Implementations *****************************/
+void HIST_Init(void)
+{
+    u8 Local_Record[HIST_RECORD_SIZE];
+    u16 Local_FirstSeq;
+    u8 Local_Low = 0;
+    u8 Local_High = HIST_SLOTS - 1;
+    u8 Local_Middle;
+
+    HIST_Head = _HIST_NO_HEAD;
+    HIST_Entries = 0;
+    HIST_NextSeq = 0;
+
+    if (!HIST_ReadRecord(0, Local_Record))
+    {
+        /**< Slot 0 is blank, or its write after a wrap-around was cut: the newest record is then the last slot */
+        if (HIST_ReadRecord(HIST_SLOTS - 1, Local_Record))
+        {
+            HIST_Head = HIST_SLOTS - 1;
+            HIST_Entries = HIST_SLOTS - 1;
+            HIST_NextSeq = (u16)(Local_Record[_HIST_SEQ] | (Local_Record[_HIST_SEQ + 1] << 8)) + 1;
+        }
+        return;
+    }
+    Local_FirstSeq = Local_Record[_HIST_SEQ] | (Local_Record[_HIST_SEQ + 1] << 8);
+
+    /**< Slot i belongs to the run started in slot 0 while it is valid and numbered first + i */
+    while (Local_Low < Local_High)
+    {
+        Local_Middle = (u8)((Local_Low + Local_High + 1) / 2);
+        if (HIST_ReadRecord(Local_Middle, Local_Record) &&
+            ((u16)((Local_Record[_HIST_SEQ] | (Local_Record[_HIST_SEQ + 1] << 8)) - Local_FirstSeq) == Local_Middle))
+        {
+            Local_Low = Local_Middle;
+        }
+        else
+        {
+            Local_High = Local_Middle - 1;
+        }
+    }
+
+    HIST_Head = Local_Low;
+    HIST_NextSeq = Local_FirstSeq + Local_Low + 1;
+
+    /**< Older records follow the head once the log has wrapped around */
+    HIST_Entries = Local_Low + 1;
+    if ((Local_Low + 1 < HIST_SLOTS) && HIST_ReadRecord(HIST_SLOTS - 1, Local_Record))
+    {
+        HIST_Entries = HIST_SLOTS;
+        if (!HIST_ReadRecord(Local_Low + 1, Local_Record))
+        {
+            HIST_Entries = HIST_SLOTS - 1;  /**< The slot after the head lost its record to a cut write */
+        }
+    }
+}
+
+Std_ReturnType HIST_Append(const void *payload, u8 length)
+{
+    const u8 *Local_Payload = (const u8 *)payload;
+    u8 Local_Full = 0;
+
+    if ((payload == NULL) || (length == 0) || (length > HIST_PAYLOAD_SIZE) ||
+        (HIST_Request.result == EEPROM_PENDING))
+    {
+        return E_NOT_OK;
+    }
+
+    HIST_Pending[_HIST_SEQ] = (u8)HIST_NextSeq;
+    HIST_Pending[_HIST_SEQ + 1] = (u8)(HIST_NextSeq >> 8);
+    HIST_Pending[_HIST_LENGTH] = length;
+    for (u8 i = 0; i < length; i++)
+    {
+        HIST_Pending[_HIST_PAYLOAD + i] = Local_Payload[i];
+    }
+    HIST_Pending[_HIST_CRC] = HIST_Crc(HIST_Pending);
+
+    HIST_PendingSlot = (HIST_Head == _HIST_NO_HEAD) ? 0 : ((HIST_Head + 1) & (HIST_SLOTS - 1));
+    HIST_Request.address = _HIST_SLOT_ADDRESS(HIST_PendingSlot);
+    HIST_Request.length = _HIST_PAYLOAD + length;
+
+    if (HIST_Entries == HIST_SLOTS)
+    {
+        HIST_Entries--;  /**< The oldest entry is overwritten from the first byte on */
+        Local_Full = 1;
+    }
+    if (EEPROM_Submit(&HIST_Request) != E_OK)
+    {
+        HIST_Entries += Local_Full;  /**< Queue full: nothing was overwritten */
+        return E_NOT_OK;
+    }
+
+    return E_OK;
+}
+
+u8 HIST_Count(void)
+{
+    return HIST_Entries;
+}
+
+u8 HIST_Get(u8 age, void *payload, u8 size)
+{
+    u8 Local_Record[HIST_RECORD_SIZE];
+    u8 *Local_Payload = (u8 *)payload;
+    u8 Local_Length;
+    u8 Local_Head;
+    u8 Local_Entries;
+    u8 Local_Sreg;
+
+    /**< The EEPROM interrupt moves both when a record is done */
+    Local_Sreg = HIST_SREG_R;
+    __asm__ __volatile__ ("cli" ::: "memory");
+    Local_Head = HIST_Head;
+    Local_Entries = HIST_Entries;
+    HIST_SREG_R = Local_Sreg;
+
+    if ((payload == NULL) || (age >= Local_Entries) ||
+        !HIST_ReadRecord((Local_Head - age) & (HIST_SLOTS - 1), Local_Record))
+    {
+        return 0;
+    }
+
+    Local_Length = Local_Record[_HIST_LENGTH];
+    if (Local_Length > size)
+    {
+        return 0;
+    }
+    for (u8 i = 0; i < Local_Length; i++)
+    {
+        Local_Payload[i] = Local_Record[_HIST_PAYLOAD + i];
+    }
+
+    return Local_Length;
+}
+
+/*****************************< Private helper functions *****************************/
+static u8 HIST_ReadRecord(u8 slot, u8 *record)
+{
+    u16 Local_Address = _HIST_SLOT_ADDRESS(slot);
+
+    EEPROM_Read(Local_Address, record, _HIST_PAYLOAD);
+    if ((record[_HIST_LENGTH] == 0) || (record[_HIST_LENGTH] > HIST_PAYLOAD_SIZE))
+    {
+        return 0;  /**< Erased EEPROM reads 0xFF */
+    }
+    EEPROM_Read(Local_Address + _HIST_PAYLOAD, record + _HIST_PAYLOAD, record[_HIST_LENGTH]);
+
+    return HIST_Crc(record) == record[_HIST_CRC];
+}
+
+static u8 HIST_Crc(const u8 *record)
+{
+    u8 Local_Crc = 0xFF;
+    u8 Local_Size = _HIST_PAYLOAD + record[_HIST_LENGTH];
+
+    for (u8 i = 0; i < Local_Size; i++)
+    {
+        if (i == _HIST_CRC)
+        {
+            continue;
+        }
+        Local_Crc ^= record[i];
+        for (u8 bit = 0; bit < 8; bit++)
+        {
+            Local_Crc = (Local_Crc & 0x80) ? (u8)((Local_Crc << 1) ^ 0x31) : (u8)(Local_Crc << 1);
+        }
+    }
+
+    return Local_Crc;
+}
+
+static void HIST_WriteDone(EEPROM_Request_t *request)
+{
+    (void)request;
+
+    HIST_Head = HIST_PendingSlot;
+    HIST_Entries++;
+    HIST_NextSeq++;
+}
@@ -3,9 +3,12 @@
 /*****************************< LIB *****************************/
 #include "STD_TYPES.h"
 #include "util/delay.h"
+#include <avr/pgmspace.h>
 /*****************************< MCAL *****************************/
 #include "DIO_interface.h"
 /*****************************< HAL *****************************/
+#include "PROF_interface.h"
+#include "LAT_interface.h"
 #include "KPD_interface.h"
 #include "KPD_private.h"
 #include "KPD_config.h"
@@ -14,26 +17,30 @@
  * @brief Matrix representing the keypad keys.
  * Each row corresponds to a row of the physical keypad, and each column corresponds to a column.
  * Users can initialize this matrix with the desired keypad layout using KPD_KEYS.
+ * Stored in program memory; read it with pgm_read_byte.
  */
-const u8 KPD_Keys[4][4] = KPD_KEYS;
+const u8 KPD_Keys[4][4] PROGMEM = KPD_KEYS;
 
 /**
  * @brief Array representing the pins connected to the rows of the keypad.
  * Users need to specify the corresponding pins in the order of physical connection.
+ * Stored in program memory; read it with pgm_read_byte.
  */
-const u8 KPD_rowsPins[4] = {KPD_R1_PIN, KPD_R2_PIN, KPD_R3_PIN, KPD_R4_PIN};
+const u8 KPD_rowsPins[4] PROGMEM = {KPD_R1_PIN, KPD_R2_PIN, KPD_R3_PIN, KPD_R4_PIN};
 
 /**
  * @brief Array representing the pins connected to the columns of the keypad.
  * Users need to specify the corresponding pins in the order of physical connection.
+ * Stored in program memory; read it with pgm_read_byte.
  */
-const u8 KPD_colsPins[4] = {KPD_C1_PIN, KPD_C2_PIN, KPD_C3_PIN, KPD_C4_PIN};
+const u8 KPD_colsPins[4] PROGMEM = {KPD_C1_PIN, KPD_C2_PIN, KPD_C3_PIN, KPD_C4_PIN};
 /*****************************< Function Implementations *****************************/
 Std_ReturnType KPD_GetKeyState(uint8_t *returnedKey)
 {
     Std_ReturnType FunctionState = E_NOT_OK; /**< Initialize function state to "not OK" */
     u8 rowsCounter = 0, colsCounter = 0, pinValue = 0, flag = 0; /**< Initialize loop counters and pin value */
     
+    PROF_ENTER(PROF_KPD_GET_KEY_STATE);
     if (NULL != returnedKey) /**< Check if the returnedKey pointer is not NULL */
     {   
         *returnedKey = KPD_KEY_NOT_PRESSED; /**< Set the returnedKey to indicate no key is pressed */
@@ -41,30 +48,33 @@ Std_ReturnType KPD_GetKeyState(uint8_t *returnedKey)
         /**< Active Each Row => For loop on pins of the rows */
         for (rowsCounter = 0; rowsCounter < 4; rowsCounter++) /**< Loop through each row */
         {
-            DIO_SetPinValue(KPD_ROWS_PORT, KPD_rowsPins[rowsCounter], DIO_LOW); /**< Activate the current row */
+            DIO_SetPinValue(KPD_ROWS_PORT, pgm_read_byte(&KPD_rowsPins[rowsCounter]), DIO_LOW); /**< Activate the current row */
             
             /**< Check which input pin has a low value (i.e., which key is pressed) */
             for (colsCounter = 0; colsCounter < 4; colsCounter++) /**< Loop through each column */
             {
-                DIO_GetPinValue(KPD_COLS_PORT, KPD_colsPins[colsCounter], &pinValue); /**< Read the value of the current column pin */
+                DIO_GetPinValue(KPD_COLS_PORT, pgm_read_byte(&KPD_colsPins[colsCounter]), &pinValue); /**< Read the value of the current column pin */
                 if (pinValue == DIO_LOW) /**< Check if the pin value is low */
                 {
+                    LAT_MARK(LAT_DETECT); /**< Start of the keypress-to-pixel latency */
+
                     /**< Debouncing */
                     _delay_ms(20); /**< Delay for debouncing */
-                    DIO_GetPinValue(KPD_COLS_PORT, KPD_colsPins[colsCounter], &pinValue); /**< Get pin value again */
+                    DIO_GetPinValue(KPD_COLS_PORT, pgm_read_byte(&KPD_colsPins[colsCounter]), &pinValue); /**< Get pin value again */
+                    LAT_MARK(LAT_DEBOUNCED);
                     /**< check if the pin is still equal low */
                     while (pinValue == DIO_LOW) /**< Wait until the pin value becomes high (debounced) */
                     {
-                        DIO_GetPinValue(KPD_COLS_PORT, KPD_colsPins[colsCounter], &pinValue); /**< Get pin value */
+                        DIO_GetPinValue(KPD_COLS_PORT, pgm_read_byte(&KPD_colsPins[colsCounter]), &pinValue); /**< Get pin value */
                     }
-                    *returnedKey = KPD_Keys[rowsCounter][colsCounter]; /**< Store the pressed key */
+                    *returnedKey = pgm_read_byte(&KPD_Keys[rowsCounter][colsCounter]); /**< Store the pressed key */
                     flag = 1; /**< Set flag to indicate that a key is pressed */
                     break; /**< Exit the loop */
                 }
             }
             
             /**< Deactivate Rows */
-			DIO_SetPinValue(KPD_ROWS_PORT, KPD_rowsPins[rowsCounter], DIO_HIGH); /**< Deactivate the current row */
+			DIO_SetPinValue(KPD_ROWS_PORT, pgm_read_byte(&KPD_rowsPins[rowsCounter]), DIO_HIGH); /**< Deactivate the current row */
 
             if (flag == 1) /**< Check if a key is pressed */
             {
@@ -78,5 +88,6 @@ Std_ReturnType KPD_GetKeyState(uint8_t *returnedKey)
         FunctionState = E_NOT_OK; /**< Set function state to "not OK" if returnedKey pointer is NULL */
     }
     
+    PROF_EXIT(PROF_KPD_GET_KEY_STATE);
     return FunctionState; /**< Return the function state */
 }
@@ -0,0 +1,21 @@
+
+
+#ifndef LAT_CONFIG_H_
+#define LAT_CONFIG_H_
+
+/**
+ * @brief Width of one histogram bucket of the keypress-to-pixel latency, in ms.
+ */
+#define LAT_BUCKET_MS           10
+
+/**
+ * @brief Number of histogram buckets, 2 to 255.
+ *
+ * Buckets cover 0 to LAT_BUCKETS * LAT_BUCKET_MS ms; the last one also
+ * holds every longer sample. The p99 is read from the buckets, so it is
+ * exact to one bucket width.
+ */
+#define LAT_BUCKETS             32
+
+
+#endif /**< LAT_CONFIG_H_ */
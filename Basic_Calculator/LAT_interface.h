@@ -0,0 +1,85 @@
+
+
+#ifndef LAT_INTERFACE_H_
+#define LAT_INTERFACE_H_
+
+#include "STD_TYPES.h"
+
+/**
+ * @brief Build the latency timestamps in (1) or compile them out (0).
+ *
+ * Set it for the whole build (-DLAT_ENABLE=1) so every module agrees. At 0
+ * the LAT_MARK points expand to nothing and LAT_program.c is empty.
+ */
+#ifndef LAT_ENABLE
+#define LAT_ENABLE              1
+#endif
+
+/**
+ * @brief Points on the way from a key press to its echo on the LCD, in order.
+ */
+typedef enum {
+    LAT_DETECT = 0,   /**< A keypad column went low */
+    LAT_DEBOUNCED,    /**< The debounce delay is over and the key is accepted */
+    LAT_DISPATCH,     /**< The application received the key (after its release) */
+    LAT_DISPLAYED,    /**< The echoed character was written to the LCD */
+    LAT_STAGES        /**< Number of points, not a point */
+} LAT_Stage_t;
+
+/**
+ * @brief Latency figures, all in microseconds.
+ *
+ * total is from LAT_DETECT to LAT_DISPLAYED; segment[i] is from point i to
+ * point i + 1, as averages.
+ */
+typedef struct {
+    u16 samples;                       /**< Key presses measured, saturating at 65535 */
+    u32 min;                           /**< Shortest total */
+    u32 avg;                           /**< Mean total */
+    u32 max;                           /**< Longest total */
+    u32 p99;                           /**< 99th percentile total, to one bucket (upper edge) */
+    u32 segment[LAT_STAGES - 1];       /**< Mean time between consecutive points */
+} LAT_Stats_t;
+
+#if LAT_ENABLE
+/**
+ * @brief Timestamp a point of the current key press.
+ */
+#define LAT_MARK(stage)         LAT_Mark(stage)
+#else
+#define LAT_MARK(stage)         ((void)0)
+#endif
+
+/**
+ * @brief Timestamps a point of the current key press; use LAT_MARK.
+ *
+ * LAT_DETECT starts a new press. The press becomes a sample when
+ * LAT_DISPLAYED is reached after every earlier point, in order; presses
+ * with a point missing (a key not echoed) are dropped. Uses
+ * TMR0_GetMicros, so Timer0 must be running.
+ *
+ * @param[in] stage The point reached.
+ */
+void LAT_Mark(LAT_Stage_t stage);
+
+/**
+ * @brief Computes the figures of the samples since the last LAT_Reset.
+ *
+ * @param[out] stats Where the figures are stored; all zero without samples.
+ */
+void LAT_GetStats(LAT_Stats_t *stats);
+
+/**
+ * @brief Drops every sample.
+ */
+void LAT_Reset(void);
+
+/**
+ * @brief Writes the figures and the non-empty histogram buckets to the UART.
+ *
+ * Waits for room in the UART transmit buffer, so interrupts must be enabled.
+ */
+void LAT_DumpUart(void);
+
+
+#endif /**< LAT_INTERFACE_H_ */
@@ -0,0 +1,33 @@
+
+
+#ifndef LAT_PRIVATE_H_
+#define LAT_PRIVATE_H_
+
+#if (LAT_BUCKETS < 2) || (LAT_BUCKETS > 255)
+#error "LAT_BUCKETS must be 2 to 255"
+#endif
+
+/**
+ * @brief Width of one histogram bucket in microseconds.
+ */
+#define _LAT_BUCKET_US      ((u32)LAT_BUCKET_MS * 1000UL)
+
+/**
+ * @brief Running sum of one measured interval.
+ */
+typedef struct {
+    u32 sum;      /**< Saturating sum of the samples */
+    u32 min;
+    u32 max;
+} LAT_Accumulator_t;
+
+/**
+ * @brief Adds one sample to an accumulator.
+ *
+ * @param[in,out] accumulator The accumulator.
+ * @param[in]     value       The sample in microseconds.
+ */
+static void LAT_Accumulate(LAT_Accumulator_t *accumulator, u32 value);
+
+
+#endif /**< LAT_PRIVATE_H_ */
@@ -0,0 +1,188 @@
+
+
+/*****************************< LIB *****************************/
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+#include <avr/pgmspace.h>
+/*****************************< MCAL *****************************/
+#include "TMR0_interface.h"
+#include "UART_interface.h"
+/*****************************< HAL *****************************/
+#include "LAT_interface.h"
+#include "LAT_config.h"
+
+#if LAT_ENABLE
+#include "LAT_private.h"
+
+/*****************************< Private Variables *****************************/
+static u32 LAT_Points[LAT_STAGES];                      /**< Timestamps of the current press */
+static u8 LAT_NextStage = LAT_STAGES;                   /**< Point expected next, LAT_STAGES when idle */
+static u16 LAT_Samples = 0;                             /**< Presses measured */
+static LAT_Accumulator_t LAT_Total;                     /**< Detect to displayed */
+static LAT_Accumulator_t LAT_Segments[LAT_STAGES - 1];  /**< Between consecutive points */
+static u16 LAT_Histogram[LAT_BUCKETS];                  /**< Totals per LAT_BUCKET_MS, saturating */
+
+/*****************************< Function Implementations *****************************/
+void LAT_Mark(LAT_Stage_t stage)
+{
+    u32 Local_Now = TMR0_GetMicros();
+    u32 Local_Total;
+    u32 Local_Bucket;
+
+    if (stage == LAT_DETECT)
+    {
+        LAT_NextStage = LAT_DETECT;
+    }
+    if ((stage >= LAT_STAGES) || (stage != LAT_NextStage))
+    {
+        return;  /**< Out of order: this press is not measured */
+    }
+
+    LAT_Points[stage] = Local_Now;
+    LAT_NextStage = stage + 1;
+    if (stage != LAT_DISPLAYED)
+    {
+        return;
+    }
+
+    /**< The echo is on the LCD: one complete sample */
+    for (u8 i = 0; i < (LAT_STAGES - 1); i++)
+    {
+        LAT_Accumulate(&LAT_Segments[i], LAT_Points[i + 1] - LAT_Points[i]);
+    }
+    Local_Total = LAT_Points[LAT_DISPLAYED] - LAT_Points[LAT_DETECT];
+    LAT_Accumulate(&LAT_Total, Local_Total);
+
+    Local_Bucket = Local_Total / _LAT_BUCKET_US;
+    if (Local_Bucket >= LAT_BUCKETS)
+    {
+        Local_Bucket = LAT_BUCKETS - 1;
+    }
+    if (LAT_Histogram[Local_Bucket] != 0xFFFF)
+    {
+        LAT_Histogram[Local_Bucket]++;
+    }
+    if (LAT_Samples != 0xFFFF)
+    {
+        LAT_Samples++;
+    }
+}
+
+void LAT_GetStats(LAT_Stats_t *stats)
+{
+    u32 Local_Rank;
+    u32 Local_Seen = 0;
+    u8 Local_Bucket = 0;
+
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    stats->samples = LAT_Samples;
+    if (LAT_Samples == 0)
+    {
+        stats->min = 0;
+        stats->avg = 0;
+        stats->max = 0;
+        stats->p99 = 0;
+        for (u8 i = 0; i < (LAT_STAGES - 1); i++)
+        {
+            stats->segment[i] = 0;
+        }
+        return;
+    }
+
+    stats->min = LAT_Total.min;
+    stats->avg = LAT_Total.sum / LAT_Samples;
+    stats->max = LAT_Total.max;
+    for (u8 i = 0; i < (LAT_STAGES - 1); i++)
+    {
+        stats->segment[i] = LAT_Segments[i].sum / LAT_Samples;
+    }
+
+    /**< Smallest bucket holding the ceil(0.99 * samples)-th sample; the maximum caps its edge */
+    Local_Rank = ((u32)LAT_Samples * 99 + 99) / 100;
+    for (; Local_Bucket < (LAT_BUCKETS - 1); Local_Bucket++)
+    {
+        Local_Seen += LAT_Histogram[Local_Bucket];
+        if (Local_Seen >= Local_Rank)
+        {
+            break;
+        }
+    }
+    stats->p99 = ((u32)Local_Bucket + 1) * _LAT_BUCKET_US;
+    if (stats->p99 > stats->max)
+    {
+        stats->p99 = stats->max;
+    }
+}
+
+void LAT_Reset(void)
+{
+    /**< The first sample after this sets min and max */
+    LAT_Samples = 0;
+    LAT_NextStage = LAT_STAGES;
+    LAT_Total.sum = 0;
+    for (u8 i = 0; i < (LAT_STAGES - 1); i++)
+    {
+        LAT_Segments[i].sum = 0;
+    }
+    for (u8 i = 0; i < LAT_BUCKETS; i++)
+    {
+        LAT_Histogram[i] = 0;
+    }
+}
+
+void LAT_DumpUart(void)
+{
+    LAT_Stats_t Local_Stats;
+
+    LAT_GetStats(&Local_Stats);
+
+    /**< "lat <samples> <min> <avg> <max> <p99> <3 segment averages>", in us */
+    UART_WriteStringWait_P(PSTR("lat"));
+    UART_WriteNumber(Local_Stats.samples);
+    UART_WriteNumber(Local_Stats.min);
+    UART_WriteNumber(Local_Stats.avg);
+    UART_WriteNumber(Local_Stats.max);
+    UART_WriteNumber(Local_Stats.p99);
+    for (u8 i = 0; i < (LAT_STAGES - 1); i++)
+    {
+        UART_WriteNumber(Local_Stats.segment[i]);
+    }
+    UART_WriteStringWait_P(PSTR("\n"));
+
+    /**< "bucket <lower edge in ms> <count>" */
+    for (u8 i = 0; i < LAT_BUCKETS; i++)
+    {
+        if (LAT_Histogram[i] != 0)
+        {
+            UART_WriteStringWait_P(PSTR("bucket"));
+            UART_WriteNumber((u32)i * LAT_BUCKET_MS);
+            UART_WriteNumber(LAT_Histogram[i]);
+            UART_WriteStringWait_P(PSTR("\n"));
+        }
+    }
+}
+
+/*****************************< Private helper functions *****************************/
+static void LAT_Accumulate(LAT_Accumulator_t *accumulator, u32 value)
+{
+    if (LAT_Samples == 0)
+    {
+        accumulator->min = value;
+        accumulator->max = value;
+    }
+    accumulator->sum = (accumulator->sum + value < accumulator->sum) ? 0xFFFFFFFFUL : (accumulator->sum + value);
+    if (value < accumulator->min)
+    {
+        accumulator->min = value;
+    }
+    if (value > accumulator->max)
+    {
+        accumulator->max = value;
+    }
+}
+
+#endif /**< LAT_ENABLE */
@@ -0,0 +1,25 @@
+
+
+#ifndef MEM_CONFIG_H_
+#define MEM_CONFIG_H_
+
+/**
+ * @brief Byte painted over the free RAM at boot; the stack is known to have
+ *        reached every byte that no longer holds it.
+ */
+#define MEM_CANARY              0xC5
+
+/**
+ * @brief Fewest never-used bytes between the variables and the stack before
+ *        MEM_Check reports a problem.
+ */
+#define MEM_MIN_FREE            64
+
+/**
+ * @brief Timer0 ticks (ms) between two scans of MEM_Check; calls in between
+ *        return the last result.
+ */
+#define MEM_CHECK_PERIOD        1000
+
+
+#endif /**< MEM_CONFIG_H_ */
@@ -0,0 +1,52 @@
+
+
+#ifndef MEM_INTERFACE_H_
+#define MEM_INTERFACE_H_
+
+/**
+ * @brief SRAM usage, in bytes.
+ *
+ * The ATmega32's 2 KB hold .data (initialised variables, strings not in
+ * PROGMEM), .bss (zeroed variables), then free space, with the stack
+ * growing down from the top towards them.
+ */
+typedef struct {
+    u16 dataSize;    /**< .data */
+    u16 bssSize;     /**< .bss */
+    u16 stackNow;    /**< Stack in use at the call */
+    u16 stackPeak;   /**< Deepest stack since reset (high-water mark) */
+    u16 freeNow;     /**< Between the variables and the stack at the call */
+    u16 freeMin;     /**< Never touched since reset: the headroom left */
+} MEM_Stats_t;
+
+/**
+ * @brief Measures the SRAM usage.
+ *
+ * The free RAM was painted with MEM_CANARY before main (nothing to call);
+ * the high-water mark is the lowest byte the stack has overwritten. Scans
+ * the free RAM, so it takes time proportional to the headroom.
+ *
+ * @param[out] stats Where the figures are stored.
+ */
+void MEM_GetStats(MEM_Stats_t *stats);
+
+/**
+ * @brief Periodic self-check of the stack headroom; call it from the main loop.
+ *
+ * Rescans at most every MEM_CHECK_PERIOD ms (Timer0 must be running) and
+ * returns the last result in between.
+ *
+ * @return E_OK while at least MEM_MIN_FREE bytes were never used, E_NOT_OK otherwise.
+ */
+Std_ReturnType MEM_Check(void);
+
+/**
+ * @brief Writes the figures of MEM_GetStats to the UART as one line.
+ *
+ * "mem <data> <bss> <stack now> <stack peak> <free now> <free min>". Waits
+ * for room in the UART transmit buffer, so interrupts must be enabled.
+ */
+void MEM_DumpUart(void);
+
+
+#endif /**< MEM_INTERFACE_H_ */
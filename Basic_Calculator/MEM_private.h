@@ -0,0 +1,45 @@
+
+
+#ifndef MEM_PRIVATE_H_
+#define MEM_PRIVATE_H_
+
+/**
+ * @brief Macro definitions for the stack pointer registers.
+ */
+#define MEM_SPL_R           (*((volatile u8*)0X5D))
+#define MEM_SPH_R           (*((volatile u8*)0X5E))
+
+/**
+ * @brief Last SRAM address of the ATmega32, where the stack starts.
+ */
+#define _MEM_RAMEND         0x085F
+
+/**
+ * @brief Section boundaries placed by the linker script.
+ *
+ * Only their addresses are meaningful. __heap_start is the first byte past
+ * every variable.
+ */
+extern u8 __data_start;
+extern u8 __data_end;
+extern u8 __bss_start;
+extern u8 __bss_end;
+extern u8 __heap_start;
+
+/**
+ * @brief Paints everything from __heap_start to _MEM_RAMEND with MEM_CANARY.
+ *
+ * Placed in .init1, so it runs inline in the startup code before the stack
+ * is set up; it is written in assembly for that reason and never called.
+ */
+void MEM_Paint(void) __attribute__((naked, used, section(".init1")));
+
+/**
+ * @brief Finds the lowest byte the stack has overwritten since reset.
+ *
+ * @return Its address.
+ */
+static u16 MEM_StackLowWater(void);
+
+
+#endif /**< MEM_PRIVATE_H_ */
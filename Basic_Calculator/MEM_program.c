@@ -0,0 +1,100 @@
+
+
+/*****************************< LIB *****************************/
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+#include <avr/pgmspace.h>
+/*****************************< MCAL *****************************/
+#include "TMR0_interface.h"
+#include "UART_interface.h"
+/*****************************< HAL *****************************/
+#include "MEM_interface.h"
+#include "MEM_config.h"
+#include "MEM_private.h"
+
+/*****************************< Private Variables *****************************/
+static u32 MEM_LastCheck = 0;                   /**< Tick of the last scan */
+static Std_ReturnType MEM_LastState = E_OK;     /**< Result of the last scan */
+static u8 MEM_Checked = 0;                      /**< Set after the first scan */
+
+/*****************************< Function Implementations *****************************/
+void MEM_Paint(void)
+{
+    /**< Z walks from __heap_start to the top of RAM; no stack, so no C */
+    __asm__ __volatile__ (
+        "    ldi r30, lo8(__heap_start)  \n"
+        "    ldi r31, hi8(__heap_start)  \n"
+        "    ldi r24, %0                 \n"
+        "    ldi r25, hi8(%1)            \n"
+        "1:  st Z+, r24                  \n"
+        "    cpi r30, lo8(%1 + 1)        \n"
+        "    cpc r31, r25                \n"
+        "    brlo 1b                     \n"
+        :
+        : "M" (MEM_CANARY), "i" (_MEM_RAMEND)
+    );
+}
+
+void MEM_GetStats(MEM_Stats_t *stats)
+{
+    u16 Local_Sp = ((u16)MEM_SPH_R << 8) | MEM_SPL_R;
+    u16 Local_LowWater;
+
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    Local_LowWater = MEM_StackLowWater();
+
+    stats->dataSize = (u16)(&__data_end - &__data_start);
+    stats->bssSize = (u16)(&__bss_end - &__bss_start);
+    stats->stackNow = _MEM_RAMEND - Local_Sp;                       /**< SP points below the last push */
+    stats->stackPeak = _MEM_RAMEND + 1 - Local_LowWater;
+    stats->freeNow = Local_Sp + 1 - (u16)&__heap_start;
+    stats->freeMin = Local_LowWater - (u16)&__heap_start;
+}
+
+Std_ReturnType MEM_Check(void)
+{
+    u32 Local_Now = TMR0_GetTicks();
+
+    if (!MEM_Checked || ((Local_Now - MEM_LastCheck) >= MEM_CHECK_PERIOD))
+    {
+        MEM_Checked = 1;
+        MEM_LastCheck = Local_Now;
+        MEM_LastState = ((MEM_StackLowWater() - (u16)&__heap_start) >= MEM_MIN_FREE) ? E_OK : E_NOT_OK;
+    }
+
+    return MEM_LastState;
+}
+
+void MEM_DumpUart(void)
+{
+    MEM_Stats_t Local_Stats;
+
+    MEM_GetStats(&Local_Stats);
+
+    UART_WriteStringWait_P(PSTR("mem"));
+    UART_WriteNumber(Local_Stats.dataSize);
+    UART_WriteNumber(Local_Stats.bssSize);
+    UART_WriteNumber(Local_Stats.stackNow);
+    UART_WriteNumber(Local_Stats.stackPeak);
+    UART_WriteNumber(Local_Stats.freeNow);
+    UART_WriteNumber(Local_Stats.freeMin);
+    while (UART_WriteByte('\n') != E_OK);
+}
+
+/*****************************< Private helper functions *****************************/
+static u16 MEM_StackLowWater(void)
+{
+    const volatile u8 *Local_Byte = &__heap_start;
+
+    /**< The paint is intact from __heap_start up to the deepest the stack went */
+    while (((u16)Local_Byte <= _MEM_RAMEND) && (*Local_Byte == MEM_CANARY))
+    {
+        Local_Byte++;
+    }
+
+    return (u16)Local_Byte;
+}
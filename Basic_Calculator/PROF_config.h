@@ -0,0 +1,15 @@
+
+
+#ifndef PROF_CONFIG_H_
+#define PROF_CONFIG_H_
+
+/**
+ * @brief Subtract the cost of the instrumentation itself from every measurement.
+ *
+ * PROF_Init times an empty PROF_Enter/PROF_Exit pair and takes that many
+ * cycles off each call, so short functions are not dominated by the probe.
+ */
+#define PROF_CALIBRATE          1
+
+
+#endif /**< PROF_CONFIG_H_ */
@@ -0,0 +1,118 @@
+
+
+#ifndef PROF_INTERFACE_H_
+#define PROF_INTERFACE_H_
+
+#include "STD_TYPES.h"
+#include "CLCD_interface.h"  /**< LCD_Config_t of PROF_DumpLcd */
+
+/**
+ * @brief Build the profiler in (1) or compile it out (0).
+ *
+ * Set it for the whole build (-DPROF_ENABLE=1) so every module agrees. At 0
+ * the PROF_ENTER/PROF_EXIT marks expand to nothing, PROF_program.c is empty
+ * and Timer1 is left alone.
+ */
+#ifndef PROF_ENABLE
+#define PROF_ENABLE             0
+#endif
+
+/**
+ * @brief The instrumented functions, one table entry each.
+ */
+typedef enum {
+    PROF_LCD_SEND_STRING = 0,    /**< LCD_SendString */
+    PROF_LCD_SEND_BYTE,          /**< HAL_LCD_TransportSendByte, one byte to the LCD in 4- or 8-bit mode */
+    PROF_KPD_GET_KEY_STATE,      /**< KPD_GetKeyState, including debounce and release */
+    PROF_CALC_ADD,               /**< Arithmetic of the '=' key in main.c */
+    PROF_CALC_SUBTRACT,
+    PROF_CALC_MULTIPLY,
+    PROF_CALC_DIVIDE,
+    PROF_COUNT                   /**< Number of entries, not an ID */
+} PROF_Id_t;
+
+/**
+ * @brief Accumulated timing of one instrumented function.
+ */
+typedef struct {
+    u16 calls;         /**< Completed calls, saturating at 65535 */
+    u32 totalCycles;   /**< CPU cycles spent in all calls, saturating */
+    u32 maxCycles;     /**< Longest single call */
+} PROF_Stats_t;
+
+#if PROF_ENABLE
+/**
+ * @brief Mark the entry of an instrumented function.
+ */
+#define PROF_ENTER(id)          PROF_Enter(id)
+
+/**
+ * @brief Mark the exit of an instrumented function; needed on every return path.
+ */
+#define PROF_EXIT(id)           PROF_Exit(id)
+#else
+#define PROF_ENTER(id)          ((void)0)
+#define PROF_EXIT(id)           ((void)0)
+#endif
+
+/**
+ * @brief Starts Timer1 as a free-running CPU clock counter and clears the table.
+ *
+ * Timer1 runs without a prescaler, so timestamps count CPU cycles; its
+ * overflow interrupt extends them to 32 bits (about 268 s at 16 MHz).
+ * Global interrupts must be enabled by the application (sei).
+ */
+void PROF_Init(void);
+
+/**
+ * @brief Timestamps the entry of a function; use PROF_ENTER.
+ *
+ * Calls of one ID must not nest, and marks belong to the main loop, not to
+ * interrupts. Different IDs nest freely, each counting its callees.
+ *
+ * @param[in] id The function.
+ */
+void PROF_Enter(PROF_Id_t id);
+
+/**
+ * @brief Timestamps the exit of a function and accumulates the call; use PROF_EXIT.
+ *
+ * @param[in] id The function.
+ */
+void PROF_Exit(PROF_Id_t id);
+
+/**
+ * @brief Copies the statistics of one function.
+ *
+ * @param[in]  id    The function.
+ * @param[out] stats Where the statistics are copied.
+ * @return E_OK, or E_NOT_OK for an invalid ID or a NULL pointer.
+ */
+Std_ReturnType PROF_GetStats(PROF_Id_t id, PROF_Stats_t *stats);
+
+/**
+ * @brief Clears the statistics of every function.
+ */
+void PROF_Reset(void);
+
+/**
+ * @brief Writes the table to the UART, one line per function.
+ *
+ * Lines read "<name> <calls> <total cycles> <max cycles>". Waits for room
+ * in the UART transmit buffer, so interrupts must be enabled.
+ */
+void PROF_DumpUart(void);
+
+/**
+ * @brief Shows one function's statistics on the LCD.
+ *
+ * The first row holds the name, the second the call count and the longest
+ * call in cycles.
+ *
+ * @param[in] config The LCD.
+ * @param[in] id     The function.
+ */
+void PROF_DumpLcd(const LCD_Config_t *config, PROF_Id_t id);
+
+
+#endif /**< PROF_INTERFACE_H_ */
@@ -0,0 +1,45 @@
+
+
+#ifndef PROF_PRIVATE_H_
+#define PROF_PRIVATE_H_
+
+/**
+ * @brief Macro definitions for the Timer1 and status registers.
+ */
+#define PROF_TCCR1A_R       (*((volatile u8*)0X4F))
+#define PROF_TCCR1B_R       (*((volatile u8*)0X4E))
+#define PROF_TCNT1H_R       (*((volatile u8*)0X4D))
+#define PROF_TCNT1L_R       (*((volatile u8*)0X4C))
+#define PROF_TIMSK_R        (*((volatile u8*)0X59))
+#define PROF_TIFR_R         (*((volatile u8*)0X58))
+#define PROF_SREG_R         (*((volatile u8*)0X5F))
+
+/**
+ * @brief Bit positions used by the driver.
+ */
+#define _PROF_TOIE1         2     // TIMSK: Timer1 overflow interrupt enable.
+#define _PROF_TOV1          2     // TIFR: Timer1 overflow flag.
+#define _PROF_CS10          0     // TCCR1B: clock select, CPU clock without prescaler.
+
+/**
+ * @brief One table entry: the statistics and the pending entry timestamp.
+ */
+typedef struct {
+    PROF_Stats_t stats;
+    u32 start;
+} PROF_Entry_t;
+
+/**
+ * @brief Reads the 32-bit cycle count (Timer1 plus its overflows).
+ *
+ * @return CPU cycles since PROF_Init, wrapping at 2^32.
+ */
+static u32 PROF_Now(void);
+
+/**
+ * @brief Timer1 overflow interrupt (vector 9 on the ATmega32).
+ */
+void __vector_9(void) __attribute__((signal, used));
+
+
+#endif /**< PROF_PRIVATE_H_ */
@@ -0,0 +1,173 @@
+
+
+/*****************************< LIB *****************************/
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+#include <avr/pgmspace.h>
+/*****************************< MCAL *****************************/
+#include "UART_interface.h"
+/*****************************< HAL *****************************/
+#include "CLCD_interface.h"
+#include "PROF_interface.h"
+#include "PROF_config.h"
+
+#if PROF_ENABLE
+#include "PROF_private.h"
+
+/*****************************< Private Variables *****************************/
+static volatile u16 PROF_Overflows = 0;      /**< Upper 16 bits of the cycle count */
+static PROF_Entry_t PROF_Table[PROF_COUNT];  /**< One entry per PROF_Id_t */
+static u32 PROF_Overhead = 0;                /**< Cycles of an empty enter/exit pair */
+
+/**
+ * @brief Names of the table entries, in PROF_Id_t order.
+ */
+static const char PROF_NameSendString[] PROGMEM = "LCD_SendString";
+static const char PROF_NameSendByte[] PROGMEM = "LCD_SendByte";
+static const char PROF_NameGetKey[] PROGMEM = "KPD_GetKeyState";
+static const char PROF_NameAdd[] PROGMEM = "add";
+static const char PROF_NameSubtract[] PROGMEM = "subtract";
+static const char PROF_NameMultiply[] PROGMEM = "multiply";
+static const char PROF_NameDivide[] PROGMEM = "divide";
+
+static const char *const PROF_Names[PROF_COUNT] PROGMEM = {
+    PROF_NameSendString, PROF_NameSendByte, PROF_NameGetKey,
+    PROF_NameAdd, PROF_NameSubtract, PROF_NameMultiply, PROF_NameDivide
+};
+
+/*****************************< Function Implementations *****************************/
+void PROF_Init(void)
+{
+    /**< Normal mode, stopped while it is configured */
+    PROF_TCCR1A_R = 0;
+    PROF_TCCR1B_R = 0;
+    PROF_TCNT1H_R = 0;  /**< High byte first: it is latched until the low byte is written */
+    PROF_TCNT1L_R = 0;
+    PROF_Overflows = 0;
+    PROF_TIFR_R = (1 << _PROF_TOV1);  /**< Written 1 to clear; SET_BIT would clear the other pending flags too */
+    SET_BIT(PROF_TIMSK_R, _PROF_TOIE1);
+    PROF_TCCR1B_R = (1 << _PROF_CS10);
+
+    PROF_Overhead = 0;
+#if PROF_CALIBRATE
+    PROF_Enter(PROF_LCD_SEND_STRING);
+    PROF_Exit(PROF_LCD_SEND_STRING);
+    PROF_Overhead = PROF_Table[PROF_LCD_SEND_STRING].stats.totalCycles;
+#endif
+    PROF_Reset();
+}
+
+void PROF_Enter(PROF_Id_t id)
+{
+    if (id < PROF_COUNT)
+    {
+        PROF_Table[id].start = PROF_Now();
+    }
+}
+
+void PROF_Exit(PROF_Id_t id)
+{
+    u32 Local_Cycles = PROF_Now();
+    PROF_Stats_t *Local_Stats;
+
+    if (id >= PROF_COUNT)
+    {
+        return;
+    }
+    Local_Stats = &PROF_Table[id].stats;
+
+    Local_Cycles -= PROF_Table[id].start;
+    Local_Cycles = (Local_Cycles > PROF_Overhead) ? (Local_Cycles - PROF_Overhead) : 0;
+
+    if (Local_Stats->calls != 0xFFFF)
+    {
+        Local_Stats->calls++;
+    }
+    Local_Stats->totalCycles = (Local_Stats->totalCycles + Local_Cycles < Local_Stats->totalCycles) ?
+                               0xFFFFFFFFUL : (Local_Stats->totalCycles + Local_Cycles);
+    if (Local_Cycles > Local_Stats->maxCycles)
+    {
+        Local_Stats->maxCycles = Local_Cycles;
+    }
+}
+
+Std_ReturnType PROF_GetStats(PROF_Id_t id, PROF_Stats_t *stats)
+{
+    if ((id >= PROF_COUNT) || (stats == NULL))
+    {
+        return E_NOT_OK;
+    }
+
+    *stats = PROF_Table[id].stats;
+
+    return E_OK;
+}
+
+void PROF_Reset(void)
+{
+    for (u8 i = 0; i < PROF_COUNT; i++)
+    {
+        PROF_Table[i].stats.calls = 0;
+        PROF_Table[i].stats.totalCycles = 0;
+        PROF_Table[i].stats.maxCycles = 0;
+    }
+}
+
+void PROF_DumpUart(void)
+{
+    for (u8 i = 0; i < PROF_COUNT; i++)
+    {
+        UART_WriteStringWait_P((const char *)pgm_read_ptr(&PROF_Names[i]));
+        UART_WriteNumber(PROF_Table[i].stats.calls);
+        UART_WriteNumber(PROF_Table[i].stats.totalCycles);
+        UART_WriteNumber(PROF_Table[i].stats.maxCycles);
+        UART_WriteStringWait_P(PSTR("\n"));
+    }
+}
+
+void PROF_DumpLcd(const LCD_Config_t *config, PROF_Id_t id)
+{
+    if (id >= PROF_COUNT)
+    {
+        return;
+    }
+
+    LCD_Clear(config);
+    LCD_SendString_P(config, (const uint8_t *)pgm_read_ptr(&PROF_Names[id]));
+    LCD_GoToXYPos(config, 0, 1);
+    LCD_SendIntegerNumber(config, PROF_Table[id].stats.calls);
+    LCD_SendChar(config, ' ');
+    LCD_SendIntegerNumber(config, (s32)PROF_Table[id].stats.maxCycles);
+}
+
+/*****************************< Private helper functions *****************************/
+static u32 PROF_Now(void)
+{
+    u8 Local_Sreg = PROF_SREG_R;
+    u8 Local_Low;
+    u8 Local_High;
+    u16 Local_Overflows;
+
+    /**< Counter and overflow count must come from the same instant */
+    __asm__ __volatile__ ("cli" ::: "memory");
+    Local_Low = PROF_TCNT1L_R;  /**< Low byte first: it latches the high byte */
+    Local_High = PROF_TCNT1H_R;
+    Local_Overflows = PROF_Overflows;
+
+    /**< An overflow not serviced yet belongs to a counter that already wrapped */
+    if (GET_BIT(PROF_TIFR_R, _PROF_TOV1) && (Local_High < 0x80))
+    {
+        Local_Overflows++;
+    }
+    PROF_SREG_R = Local_Sreg;
+
+    return ((u32)Local_Overflows << 16) | ((u16)Local_High << 8) | Local_Low;
+}
+
+/*****************************< Interrupt Service Routines *****************************/
+void __vector_9(void)
+{
+    PROF_Overflows++;
+}
+
+#endif /**< PROF_ENABLE */
@@ -0,0 +1,19 @@
+
+
+#ifndef TMR0_CONFIG_H_
+#define TMR0_CONFIG_H_
+
+/**
+ * @brief Frequency of the system tick in Hz (1000 gives a 1 ms tick).
+ */
+#define TMR0_TICK_HZ            1000UL
+
+/**
+ * @brief Timer0 clock prescaler: 1, 8, 64, 256 or 1024.
+ *
+ * F_CPU / TMR0_PRESCALER / TMR0_TICK_HZ must be between 1 and 256.
+ */
+#define TMR0_PRESCALER          64
+
+
+#endif /**< TMR0_CONFIG_H_ */
@@ -0,0 +1,53 @@
+
+
+#ifndef TMR0_INTERFACE_H_
+#define TMR0_INTERFACE_H_
+
+/**
+ * @brief Function called from the tick interrupt.
+ */
+typedef void (*TMR0_Callback_t)(void);
+
+/**
+ * @brief Starts Timer0 as the system tick.
+ *
+ * The timer runs in CTC mode and raises a compare match interrupt every
+ * 1 / TMR0_TICK_HZ seconds (see TMR0_config.h). Global interrupts must be
+ * enabled by the application (sei) for the tick to count.
+ */
+void TMR0_Init(void);
+
+/**
+ * @brief Returns the number of ticks since TMR0_Init.
+ *
+ * The 32-bit counter is read with interrupts masked, so the value is never torn.
+ * It wraps after about 49 days at 1 kHz; compare times by subtraction
+ * (TMR0_GetTicks() - start >= period) to stay correct across the wrap.
+ *
+ * @return The tick count.
+ */
+u32 TMR0_GetTicks(void);
+
+/**
+ * @brief Returns the time since TMR0_Init in microseconds.
+ *
+ * Combines the tick count with the position of the counter inside the
+ * current tick, so the resolution is one timer clock (TMR0_PRESCALER CPU
+ * cycles) rather than one tick. It wraps after about 71 minutes; compare
+ * times by subtraction as with TMR0_GetTicks.
+ *
+ * @return The time in microseconds.
+ */
+u32 TMR0_GetMicros(void);
+
+/**
+ * @brief Registers a function to run on every tick, inside the interrupt.
+ *
+ * Keep it short: it delays every other interrupt. Pass NULL to remove it.
+ *
+ * @param[in] callback The function to call.
+ */
+void TMR0_SetCallback(TMR0_Callback_t callback);
+
+
+#endif /**< TMR0_INTERFACE_H_ */
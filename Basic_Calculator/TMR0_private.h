@@ -0,0 +1,64 @@
+
+
+#ifndef TMR0_PRIVATE_H_
+#define TMR0_PRIVATE_H_
+
+/**
+ * @brief Macro definitions for the Timer0 and status registers.
+ */
+#define TMR0_TCCR0_R        (*((volatile u8*)0X53))
+#define TMR0_TCNT0_R        (*((volatile u8*)0X52))
+#define TMR0_OCR0_R         (*((volatile u8*)0X5C))
+#define TMR0_TIMSK_R        (*((volatile u8*)0X59))
+#define TMR0_TIFR_R         (*((volatile u8*)0X58))
+#define TMR0_SREG_R         (*((volatile u8*)0X5F))
+
+/**
+ * @brief Bit positions used by the driver.
+ */
+#define _TMR0_WGM01         3     // TCCR0: clear timer on compare match (CTC) mode.
+#define _TMR0_OCIE0         1     // TIMSK: output compare match interrupt enable.
+#define _TMR0_OCF0          1     // TIFR: output compare match flag.
+
+/**
+ * @brief Clock select bits (CS02:0) of each supported prescaler.
+ */
+#if TMR0_PRESCALER == 1
+#define _TMR0_CLOCK_SELECT  0x01
+#elif TMR0_PRESCALER == 8
+#define _TMR0_CLOCK_SELECT  0x02
+#elif TMR0_PRESCALER == 64
+#define _TMR0_CLOCK_SELECT  0x03
+#elif TMR0_PRESCALER == 256
+#define _TMR0_CLOCK_SELECT  0x04
+#elif TMR0_PRESCALER == 1024
+#define _TMR0_CLOCK_SELECT  0x05
+#else
+#error "TMR0_PRESCALER must be 1, 8, 64, 256 or 1024"
+#endif
+
+#ifndef F_CPU
+#error "F_CPU must be defined to compute the Timer0 compare value"
+#endif
+
+/**
+ * @brief Compare value giving one match every tick.
+ */
+#define _TMR0_COMPARE_VALUE ((F_CPU / TMR0_PRESCALER / TMR0_TICK_HZ) - 1)
+
+#if _TMR0_COMPARE_VALUE > 255
+#error "TMR0_TICK_HZ cannot be reached with this TMR0_PRESCALER and F_CPU"
+#endif
+
+/**
+ * @brief Microseconds per tick.
+ */
+#define _TMR0_TICK_US       (1000000UL / TMR0_TICK_HZ)
+
+/**
+ * @brief Timer0 compare match interrupt (vector 10 on the ATmega32).
+ */
+void __vector_10(void) __attribute__((signal, used));
+
+
+#endif /**< TMR0_PRIVATE_H_ */
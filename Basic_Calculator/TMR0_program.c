@@ -0,0 +1,78 @@
+
+
+/*****************************< LIB *****************************/
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+/*****************************< MCAL *****************************/
+#include "TMR0_interface.h"
+#include "TMR0_config.h"
+#include "TMR0_private.h"
+
+/*****************************< Private Variables *****************************/
+static volatile u32 TMR0_Ticks = 0;                    /**< Ticks since TMR0_Init */
+static volatile TMR0_Callback_t TMR0_Callback = NULL;  /**< Called on every tick */
+
+/*****************************< Function Implementations *****************************/
+void TMR0_Init(void)
+{
+    /**< Stop the timer while it is configured */
+    TMR0_TCCR0_R = 0;
+    TMR0_TCNT0_R = 0;
+    TMR0_OCR0_R = (u8)_TMR0_COMPARE_VALUE;
+    TMR0_Ticks = 0;
+
+    SET_BIT(TMR0_TIMSK_R, _TMR0_OCIE0);
+
+    /**< CTC mode, start counting with the configured prescaler */
+    TMR0_TCCR0_R = (1 << _TMR0_WGM01) | _TMR0_CLOCK_SELECT;
+}
+
+u32 TMR0_GetTicks(void)
+{
+    u32 Local_Ticks;
+    u8 Local_Sreg = TMR0_SREG_R;
+
+    /**< The 4-byte read must not be split by the tick interrupt */
+    __asm__ __volatile__ ("cli" ::: "memory");
+    Local_Ticks = TMR0_Ticks;
+    TMR0_SREG_R = Local_Sreg;
+
+    return Local_Ticks;
+}
+
+u32 TMR0_GetMicros(void)
+{
+    u32 Local_Ticks;
+    u8 Local_Count;
+    u8 Local_Sreg = TMR0_SREG_R;
+
+    /**< Tick count and counter must come from the same instant */
+    __asm__ __volatile__ ("cli" ::: "memory");
+    Local_Ticks = TMR0_Ticks;
+    Local_Count = TMR0_TCNT0_R;
+
+    /**< A compare match not serviced yet: the counter already restarted from 0 */
+    if (GET_BIT(TMR0_TIFR_R, _TMR0_OCF0) && (Local_Count < (u8)(_TMR0_COMPARE_VALUE / 2)))
+    {
+        Local_Ticks++;
+    }
+    TMR0_SREG_R = Local_Sreg;
+
+    return (Local_Ticks * _TMR0_TICK_US) + ((u32)Local_Count * _TMR0_TICK_US / (_TMR0_COMPARE_VALUE + 1));
+}
+
+void TMR0_SetCallback(TMR0_Callback_t callback)
+{
+    TMR0_Callback = callback;
+}
+
+/*****************************< Interrupt Service Routines *****************************/
+void __vector_10(void)
+{
+    TMR0_Ticks++;
+
+    if (TMR0_Callback != NULL)
+    {
+        TMR0_Callback();
+    }
+}
@@ -0,0 +1,29 @@
+
+
+#ifndef TWI_CONFIG_H_
+#define TWI_CONFIG_H_
+
+/**
+ * @brief SCL clock frequency in Hz (100 kHz standard mode, 400 kHz fast mode).
+ */
+#define TWI_SCL_HZ              100000UL
+
+/**
+ * @brief TWI bit rate prescaler: 1, 4, 16 or 64.
+ *
+ * (F_CPU / TWI_SCL_HZ - 16) / (2 * TWI_PRESCALER) must fit in TWBR (0 to 255).
+ */
+#define TWI_PRESCALER           1
+
+/**
+ * @brief Polls of the TWINT flag before a stuck bus is given up on.
+ */
+#define TWI_TIMEOUT             2000U
+
+/**
+ * @brief Transactions that can wait in the queue of the interrupt-driven driver.
+ */
+#define TWI_QUEUE_SIZE          4
+
+
+#endif /**< TWI_CONFIG_H_ */
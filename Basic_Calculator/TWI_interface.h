@@ -0,0 +1,142 @@
+
+
+#ifndef TWI_INTERFACE_H_
+#define TWI_INTERFACE_H_
+
+/**
+ * @brief Direction of a transfer, the R/W bit after the slave address.
+ */
+typedef enum {
+    TWI_WRITE = 0, /**< Master transmits */
+    TWI_READ = 1   /**< Master receives */
+} TWI_Direction_t;
+
+/**
+ * @brief State of a queued transaction.
+ */
+typedef enum {
+    TWI_PENDING = 0, /**< Queued or on the bus */
+    TWI_DONE = 1,    /**< Every byte was transferred */
+    TWI_FAILED = 2   /**< NACK, lost arbitration or bus error; the transfer was abandoned */
+} TWI_Result_t;
+
+typedef struct TWI_Transaction_s TWI_Transaction_t;
+
+/**
+ * @brief Function called from the TWI interrupt when a transaction ends.
+ */
+typedef void (*TWI_Callback_t)(TWI_Transaction_t *transaction);
+
+/**
+ * @brief A transfer for the interrupt-driven driver.
+ *
+ * Writes writeLength bytes, then, if readLength is not 0, reads readLength
+ * bytes after a repeated start (register reads of sensors and EEPROMs). The
+ * structure and its buffers belong to the driver from TWI_Submit until the
+ * result leaves TWI_PENDING; keep them alive (static or global) until then.
+ */
+struct TWI_Transaction_s {
+    u8 address;                    /**< 7-bit slave address */
+    const u8 *writeData;           /**< Bytes to send, NULL if writeLength is 0 */
+    u8 writeLength;                /**< Number of bytes to send */
+    u8 *readData;                  /**< Buffer for the received bytes, NULL if readLength is 0 */
+    u8 readLength;                 /**< Number of bytes to receive */
+    TWI_Callback_t callback;       /**< Called when the transaction ends, may be NULL */
+    volatile TWI_Result_t result;  /**< Set by the driver */
+};
+
+/**
+ * @brief Enables the TWI as a bus master at TWI_SCL_HZ (see TWI_config.h).
+ *
+ * The queue starts empty. Global interrupts must be enabled by the application
+ * (sei) for queued transactions to run.
+ */
+void TWI_Init(void);
+
+/**
+ * @brief Queues a transaction for the interrupt-driven driver.
+ *
+ * Returns at once: the transfer runs from the TWI interrupt, after the ones
+ * queued before it, and its callback is called from the interrupt when it
+ * ends. Poll transaction->result or use the callback to learn the outcome.
+ *
+ * Example usage:
+ * @code
+ * static u8 reg = 0x00, value[2];
+ * static TWI_Transaction_t readTemp = {0x48, &reg, 1, value, 2, NULL, TWI_PENDING};
+ * TWI_Submit(&readTemp);
+ * // ... other work ...
+ * if (readTemp.result == TWI_DONE) { ... }
+ * @endcode
+ *
+ * @param[in,out] transaction Pointer to the transaction.
+ * @return E_OK if it was queued, E_NOT_OK if it is invalid or the queue is full.
+ */
+Std_ReturnType TWI_Submit(TWI_Transaction_t *transaction);
+
+/**
+ * @brief Tells whether queued transactions are still running.
+ *
+ * @return 1 while a queued transaction is on the bus or waiting, 0 when idle.
+ */
+u8 TWI_IsBusy(void);
+
+/**
+ * @brief Sends a start condition, or a repeated start inside a transfer.
+ *
+ * The polled functions below drive the bus directly; TWI_Start refuses to
+ * begin while queued transactions run. Once it has begun a transfer, end it
+ * with TWI_Stop even if the start itself failed.
+ *
+ * @return E_OK if the start was sent, E_NOT_OK otherwise.
+ */
+Std_ReturnType TWI_Start(void);
+
+/**
+ * @brief Sends the 7-bit slave address and the direction.
+ *
+ * @param[in] address The 7-bit slave address.
+ * @param[in] direction TWI_WRITE or TWI_READ.
+ * @return E_OK if the slave acknowledged, E_NOT_OK otherwise or when no
+ *         polled transfer was begun with TWI_Start.
+ */
+Std_ReturnType TWI_SendAddress(u8 address, TWI_Direction_t direction);
+
+/**
+ * @brief Sends one data byte to the addressed slave.
+ *
+ * @param[in] data The byte to send.
+ * @return E_OK if the slave acknowledged, E_NOT_OK otherwise or when no
+ *         polled transfer was begun with TWI_Start.
+ */
+Std_ReturnType TWI_WriteByte(u8 data);
+
+/**
+ * @brief Receives one data byte from the addressed slave.
+ *
+ * @param[out] data Pointer to the received byte.
+ * @param[in] ack 1 to acknowledge (more bytes follow), 0 for the last byte.
+ * @return E_OK if a byte was received, E_NOT_OK otherwise or when no
+ *         polled transfer was begun with TWI_Start.
+ */
+Std_ReturnType TWI_ReadByte(u8 *data, u8 ack);
+
+/**
+ * @brief Sends a stop condition and releases the bus.
+ */
+void TWI_Stop(void);
+
+/**
+ * @brief Writes a block of bytes to a slave in a single transfer.
+ *
+ * Start, address, the bytes and a stop; the stop is sent on failure too.
+ *
+ * @param[in] address The 7-bit slave address.
+ * @param[in] data Pointer to the bytes.
+ * @param[in] length Number of bytes.
+ * @return E_OK if every byte was acknowledged, E_NOT_OK otherwise.
+ */
+Std_ReturnType TWI_Write(u8 address, const u8 *data, u8 length);
+
+
+#endif /**< TWI_INTERFACE_H_ */
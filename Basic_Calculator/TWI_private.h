@@ -0,0 +1,106 @@
+
+
+#ifndef TWI_PRIVATE_H_
+#define TWI_PRIVATE_H_
+
+/**
+ * @brief Macro definitions for the TWI registers.
+ */
+#define TWI_TWBR_R          (*((volatile u8*)0X20))
+#define TWI_TWSR_R          (*((volatile u8*)0X21))
+#define TWI_TWAR_R          (*((volatile u8*)0X22))
+#define TWI_TWDR_R          (*((volatile u8*)0X23))
+#define TWI_TWCR_R          (*((volatile u8*)0X56))
+#define TWI_SREG_R          (*((volatile u8*)0X5F))
+
+/**
+ * @brief Bit positions of TWCR used by the driver.
+ */
+#define _TWI_TWINT          7     // Job done; written 1 to start the next one.
+#define _TWI_TWEA           6     // Acknowledge received bytes.
+#define _TWI_TWSTA          5     // Send a (repeated) start condition.
+#define _TWI_TWSTO          4     // Send a stop condition.
+#define _TWI_TWEN           2     // Enable the TWI.
+#define _TWI_TWIE           0     // Interrupt on TWINT.
+
+/**
+ * @brief Master status codes (TWSR with the prescaler bits masked off).
+ */
+#define _TWI_STATUS_MASK        0xF8
+#define _TWI_START              0x08  // Start sent.
+#define _TWI_REP_START          0x10  // Repeated start sent.
+#define _TWI_MT_SLA_ACK         0x18  // SLA+W sent, ACK received.
+#define _TWI_MT_SLA_NACK        0x20  // SLA+W sent, NACK received.
+#define _TWI_MT_DATA_ACK        0x28  // Data sent, ACK received.
+#define _TWI_MT_DATA_NACK       0x30  // Data sent, NACK received.
+#define _TWI_ARB_LOST           0x38  // Arbitration lost to another master.
+#define _TWI_MR_SLA_ACK         0x40  // SLA+R sent, ACK received.
+#define _TWI_MR_SLA_NACK        0x48  // SLA+R sent, NACK received.
+#define _TWI_MR_DATA_ACK        0x50  // Data received, ACK returned.
+#define _TWI_MR_DATA_NACK       0x58  // Data received, NACK returned.
+
+/**
+ * @brief Prescaler bits (TWPS1:0) of each supported prescaler.
+ */
+#if TWI_PRESCALER == 1
+#define _TWI_PRESCALER_BITS 0x00
+#elif TWI_PRESCALER == 4
+#define _TWI_PRESCALER_BITS 0x01
+#elif TWI_PRESCALER == 16
+#define _TWI_PRESCALER_BITS 0x02
+#elif TWI_PRESCALER == 64
+#define _TWI_PRESCALER_BITS 0x03
+#else
+#error "TWI_PRESCALER must be 1, 4, 16 or 64"
+#endif
+
+#ifndef F_CPU
+#error "F_CPU must be defined to compute the TWI bit rate"
+#endif
+
+/**
+ * @brief TWBR value giving TWI_SCL_HZ.
+ */
+#define _TWI_BIT_RATE       ((F_CPU / TWI_SCL_HZ - 16) / (2 * TWI_PRESCALER))
+
+#if (F_CPU / TWI_SCL_HZ) < 16 || _TWI_BIT_RATE > 255
+#error "TWI_SCL_HZ cannot be reached with this TWI_PRESCALER and F_CPU"
+#endif
+
+#if (TWI_QUEUE_SIZE < 1) || (TWI_QUEUE_SIZE > 255)
+#error "TWI_QUEUE_SIZE must be 1 to 255"
+#endif
+
+/**
+ * @brief TWCR values of the interrupt-driven driver (TWINT written 1 starts the step).
+ */
+#define _TWI_CR_NEXT        ((1 << _TWI_TWINT) | (1 << _TWI_TWEN) | (1 << _TWI_TWIE))
+#define _TWI_CR_START       (_TWI_CR_NEXT | (1 << _TWI_TWSTA))
+#define _TWI_CR_STOP        ((1 << _TWI_TWINT) | (1 << _TWI_TWEN) | (1 << _TWI_TWSTO))
+
+/**
+ * @brief Starts the job set in TWCR and waits for TWINT.
+ *
+ * @param[in] control TWCR bits besides TWINT and TWEN.
+ * @return The status code, or 0 if TWINT did not rise within TWI_TIMEOUT polls.
+ */
+static u8 TWI_Run(u8 control);
+
+/**
+ * @brief Ends the current queued transaction and moves on to the next one.
+ *
+ * Sends a stop (or a stop followed by a start when another transaction
+ * waits), records the result and calls the completion callback.
+ * Runs inside the TWI interrupt.
+ *
+ * @param[in] result TWI_DONE or TWI_FAILED.
+ */
+static void TWI_Finish(TWI_Result_t result);
+
+/**
+ * @brief TWI interrupt (vector 19 on the ATmega32).
+ */
+void __vector_19(void) __attribute__((signal, used));
+
+
+#endif /**< TWI_PRIVATE_H_ */
@@ -0,0 +1,283 @@
+
+
+/*****************************< LIB *****************************/
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+/*****************************< MCAL *****************************/
+#include "TWI_interface.h"
+#include "TWI_config.h"
+#include "TWI_private.h"
+
+/*****************************< Private Variables *****************************/
+static TWI_Transaction_t *TWI_Queue[TWI_QUEUE_SIZE];  /**< Queued transactions, the head one is on the bus */
+static volatile u8 TWI_QueueHead = 0;                 /**< Index of the current transaction */
+static volatile u8 TWI_QueueCount = 0;                /**< Transactions queued, the current one included */
+static volatile u8 TWI_Index = 0;                     /**< Next byte of the current phase */
+static volatile u8 TWI_PolledActive = 0;              /**< Set between a polled start and its stop */
+
+/*****************************< Function Implementations *****************************/
+void TWI_Init(void)
+{
+    TWI_TWBR_R = (u8)_TWI_BIT_RATE;
+    TWI_TWSR_R = _TWI_PRESCALER_BITS;
+    TWI_TWCR_R = (1 << _TWI_TWEN);
+
+    TWI_QueueHead = 0;
+    TWI_QueueCount = 0;
+    TWI_PolledActive = 0;
+}
+
+Std_ReturnType TWI_Submit(TWI_Transaction_t *transaction)
+{
+    Std_ReturnType Local_FunctionState = E_NOT_OK;
+    u8 Local_Sreg;
+
+    if ((transaction == NULL) ||
+        ((transaction->writeLength > 0) && (transaction->writeData == NULL)) ||
+        ((transaction->readLength > 0) && (transaction->readData == NULL)))
+    {
+        return E_NOT_OK;
+    }
+
+    /**< The interrupt takes transactions off the queue */
+    Local_Sreg = TWI_SREG_R;
+    __asm__ __volatile__ ("cli" ::: "memory");
+    if (TWI_QueueCount < TWI_QUEUE_SIZE)
+    {
+        transaction->result = TWI_PENDING;
+        TWI_Queue[(u8)(TWI_QueueHead + TWI_QueueCount) % TWI_QUEUE_SIZE] = transaction;
+        TWI_QueueCount++;
+        Local_FunctionState = E_OK;
+
+        /**< Start an idle bus; otherwise the interrupt or TWI_Stop gets to it */
+        if ((TWI_QueueCount == 1) && !TWI_PolledActive)
+        {
+            TWI_TWCR_R = _TWI_CR_START;
+        }
+    }
+    TWI_SREG_R = Local_Sreg;
+
+    return Local_FunctionState;
+}
+
+u8 TWI_IsBusy(void)
+{
+    return TWI_QueueCount != 0;
+}
+
+Std_ReturnType TWI_Start(void)
+{
+    u8 Local_Status;
+    u8 Local_Sreg;
+
+    /**< A repeated start continues the polled transfer, a new one waits for the queue.
+     *   Test and set with interrupts off: a callback may submit from the TWI interrupt */
+    Local_Sreg = TWI_SREG_R;
+    __asm__ __volatile__ ("cli" ::: "memory");
+    if (!TWI_PolledActive)
+    {
+        if (TWI_QueueCount != 0)
+        {
+            TWI_SREG_R = Local_Sreg;
+            return E_NOT_OK;
+        }
+        TWI_PolledActive = 1;
+    }
+    TWI_SREG_R = Local_Sreg;
+
+    Local_Status = TWI_Run(1 << _TWI_TWSTA);
+
+    return ((Local_Status == _TWI_START) || (Local_Status == _TWI_REP_START)) ? E_OK : E_NOT_OK;
+}
+
+Std_ReturnType TWI_SendAddress(u8 address, TWI_Direction_t direction)
+{
+    /**< Without a polled start the bus may be in the middle of a queued transaction */
+    if (!TWI_PolledActive)
+    {
+        return E_NOT_OK;
+    }
+
+    TWI_TWDR_R = (u8)(address << 1) | (u8)direction;
+
+    return (TWI_Run(0) == ((direction == TWI_READ) ? _TWI_MR_SLA_ACK : _TWI_MT_SLA_ACK)) ? E_OK : E_NOT_OK;
+}
+
+Std_ReturnType TWI_WriteByte(u8 data)
+{
+    if (!TWI_PolledActive)
+    {
+        return E_NOT_OK;
+    }
+
+    TWI_TWDR_R = data;
+
+    return (TWI_Run(0) == _TWI_MT_DATA_ACK) ? E_OK : E_NOT_OK;
+}
+
+Std_ReturnType TWI_ReadByte(u8 *data, u8 ack)
+{
+    u8 Local_Status;
+
+    if ((data == NULL) || !TWI_PolledActive)
+    {
+        return E_NOT_OK;
+    }
+
+    Local_Status = TWI_Run(ack ? (1 << _TWI_TWEA) : 0);
+    if (Local_Status != (ack ? _TWI_MR_DATA_ACK : _TWI_MR_DATA_NACK))
+    {
+        return E_NOT_OK;
+    }
+
+    *data = TWI_TWDR_R;
+
+    return E_OK;
+}
+
+void TWI_Stop(void)
+{
+    u8 Local_Sreg;
+
+    /**< Only the polled transfer is ours to stop, queued ones stop themselves */
+    if (!TWI_PolledActive)
+    {
+        return;
+    }
+
+    /**< TWINT is not set after a stop, the hardware clears TWSTO when it is done */
+    TWI_TWCR_R = _TWI_CR_STOP;
+    for (u16 i = 0; (i < TWI_TIMEOUT) && GET_BIT(TWI_TWCR_R, _TWI_TWSTO); i++);
+
+    /**< Hand the bus to transactions submitted meanwhile */
+    Local_Sreg = TWI_SREG_R;
+    __asm__ __volatile__ ("cli" ::: "memory");
+    TWI_PolledActive = 0;
+    if (TWI_QueueCount != 0)
+    {
+        TWI_TWCR_R = _TWI_CR_START;
+    }
+    TWI_SREG_R = Local_Sreg;
+}
+
+Std_ReturnType TWI_Write(u8 address, const u8 *data, u8 length)
+{
+    Std_ReturnType Local_FunctionState = E_NOT_OK;
+
+    if ((data != NULL) && (TWI_Start() == E_OK) && (TWI_SendAddress(address, TWI_WRITE) == E_OK))
+    {
+        Local_FunctionState = E_OK;
+        for (u8 i = 0; (i < length) && (Local_FunctionState == E_OK); i++)
+        {
+            Local_FunctionState = TWI_WriteByte(data[i]);
+        }
+    }
+
+    TWI_Stop();
+
+    return Local_FunctionState;
+}
+
+/*****************************< Private helper functions *****************************/
+static u8 TWI_Run(u8 control)
+{
+    TWI_TWCR_R = (1 << _TWI_TWINT) | (1 << _TWI_TWEN) | control;
+
+    for (u16 i = 0; i < TWI_TIMEOUT; i++)
+    {
+        if (GET_BIT(TWI_TWCR_R, _TWI_TWINT))
+        {
+            return TWI_TWSR_R & _TWI_STATUS_MASK;
+        }
+    }
+
+    return 0;
+}
+
+static void TWI_Finish(TWI_Result_t result)
+{
+    TWI_Transaction_t *Local_Done = TWI_Queue[TWI_QueueHead];
+
+    TWI_QueueHead = (u8)(TWI_QueueHead + 1) % TWI_QUEUE_SIZE;
+    TWI_QueueCount--;
+
+    /**< Stop, and start the next transaction right after it if one is waiting */
+    TWI_TWCR_R = (TWI_QueueCount != 0) ? (_TWI_CR_STOP | _TWI_CR_START) : _TWI_CR_STOP;
+
+    Local_Done->result = result;
+    if (Local_Done->callback != NULL)
+    {
+        Local_Done->callback(Local_Done);
+    }
+}
+
+/*****************************< Interrupt Service Routines *****************************/
+void __vector_19(void)
+{
+    TWI_Transaction_t *Local_Job = TWI_Queue[TWI_QueueHead];
+
+    switch (TWI_TWSR_R & _TWI_STATUS_MASK)
+    {
+        case _TWI_START:
+            /**< A transaction with nothing to write goes straight to reading */
+            TWI_Index = 0;
+            TWI_TWDR_R = (u8)(Local_Job->address << 1) |
+                         ((Local_Job->writeLength == 0) ? TWI_READ : TWI_WRITE);
+            TWI_TWCR_R = _TWI_CR_NEXT;
+            break;
+
+        case _TWI_REP_START:
+            TWI_Index = 0;
+            TWI_TWDR_R = (u8)(Local_Job->address << 1) | TWI_READ;
+            TWI_TWCR_R = _TWI_CR_NEXT;
+            break;
+
+        case _TWI_MT_SLA_ACK:
+        case _TWI_MT_DATA_ACK:
+            if (TWI_Index < Local_Job->writeLength)
+            {
+                TWI_TWDR_R = Local_Job->writeData[TWI_Index++];
+                TWI_TWCR_R = _TWI_CR_NEXT;
+            }
+            else if (Local_Job->readLength != 0)
+            {
+                TWI_TWCR_R = _TWI_CR_START;
+            }
+            else
+            {
+                TWI_Finish(TWI_DONE);
+            }
+            break;
+
+        case _TWI_MR_SLA_ACK:
+            if (Local_Job->readLength == 0)
+            {
+                TWI_Finish(TWI_DONE);
+                break;
+            }
+            /**< ACK every byte but the last */
+            TWI_TWCR_R = (Local_Job->readLength > 1) ? (_TWI_CR_NEXT | (1 << _TWI_TWEA)) : _TWI_CR_NEXT;
+            break;
+
+        case _TWI_MR_DATA_ACK:
+            Local_Job->readData[TWI_Index++] = TWI_TWDR_R;
+            TWI_TWCR_R = ((u8)(TWI_Index + 1) < Local_Job->readLength) ?
+                         (_TWI_CR_NEXT | (1 << _TWI_TWEA)) : _TWI_CR_NEXT;
+            break;
+
+        case _TWI_MR_DATA_NACK:
+            Local_Job->readData[TWI_Index] = TWI_TWDR_R;
+            TWI_Finish(TWI_DONE);
+            break;
+
+        case _TWI_ARB_LOST:
+            /**< Another master took the bus: send no stop, start again once it is free */
+            TWI_TWCR_R = _TWI_CR_START;
+            break;
+
+        default:
+            /**< NACK from the slave or a bus error: give the transaction up */
+            TWI_Finish(TWI_FAILED);
+            break;
+    }
+}
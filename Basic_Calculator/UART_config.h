@@ -0,0 +1,27 @@
+
+
+#ifndef UART_CONFIG_H_
+#define UART_CONFIG_H_
+
+/**
+ * @brief Baud rate of the serial link (8 data bits, no parity, 1 stop bit).
+ */
+#define UART_BAUD               9600UL
+
+/**
+ * @brief Double speed mode (U2X): 1 halves the divider for rates the normal mode cannot reach.
+ */
+#define UART_DOUBLE_SPEED       0
+
+/**
+ * @brief Sizes of the transmit and receive ring buffers in bytes: a power of two, 2 to 128.
+ *
+ * The transmit buffer holds what UART_Write queued until the line sends it, the
+ * receive buffer holds what arrived until UART_Read takes it. Bytes that arrive
+ * with the receive buffer full are dropped and counted (see UART_GetRxDropped).
+ */
+#define UART_TX_BUFFER_SIZE     64
+#define UART_RX_BUFFER_SIZE     32
+
+
+#endif /**< UART_CONFIG_H_ */
@@ -0,0 +1,94 @@
+
+
+#ifndef UART_INTERFACE_H_
+#define UART_INTERFACE_H_
+
+/**
+ * @brief Starts the USART at UART_BAUD, 8N1, with interrupt-driven transmit and receive.
+ *
+ * Both ring buffers start empty. Global interrupts must be enabled by the
+ * application (sei) for bytes to move.
+ */
+void UART_Init(void);
+
+/**
+ * @brief Queues bytes for transmission without waiting for the line.
+ *
+ * Copies as many bytes as fit in the transmit buffer and returns; the data
+ * register empty interrupt sends them.
+ *
+ * @param[in] data   The bytes to send.
+ * @param[in] length Number of bytes.
+ * @return The number of bytes queued, less than length when the buffer filled up.
+ */
+u8 UART_Write(const u8 *data, u8 length);
+
+/**
+ * @brief Queues one byte for transmission.
+ *
+ * @param[in] data The byte to send.
+ * @return E_OK if it was queued, E_NOT_OK if the transmit buffer is full.
+ */
+Std_ReturnType UART_WriteByte(u8 data);
+
+/**
+ * @brief Queues a NUL-terminated string stored in flash, as far as it fits.
+ *
+ * @param[in] string The string, in program memory (PSTR).
+ * @return The number of characters queued.
+ */
+u8 UART_WriteString_P(const char *string);
+
+/**
+ * @brief Writes a NUL-terminated string stored in flash, waiting for room.
+ *
+ * Blocks until the last character is queued, so interrupts must be enabled.
+ *
+ * @param[in] string The string, in program memory (PSTR or a PROGMEM array).
+ */
+void UART_WriteStringWait_P(const char *string);
+
+/**
+ * @brief Writes a space and an unsigned decimal number, waiting for room.
+ *
+ * Blocks like UART_WriteStringWait_P. Report lines are a name followed by
+ * numbers written with this.
+ *
+ * @param[in] number The number.
+ */
+void UART_WriteNumber(u32 number);
+
+/**
+ * @brief Takes received bytes out of the receive buffer without waiting.
+ *
+ * @param[out] data   Buffer for the bytes.
+ * @param[in]  length Size of the buffer.
+ * @return The number of bytes copied, 0 when nothing has arrived.
+ */
+u8 UART_Read(u8 *data, u8 length);
+
+/**
+ * @brief Takes one received byte.
+ *
+ * @param[out] data The byte.
+ * @return E_OK if a byte was read, E_NOT_OK if the receive buffer is empty.
+ */
+Std_ReturnType UART_ReadByte(u8 *data);
+
+/**
+ * @brief Returns the number of received bytes waiting to be read.
+ */
+u8 UART_Available(void);
+
+/**
+ * @brief Returns the number of bytes UART_Write can queue right now.
+ */
+u8 UART_TxSpace(void);
+
+/**
+ * @brief Returns the number of bytes lost to a full receive buffer or a data overrun since UART_Init.
+ */
+u16 UART_GetRxDropped(void);
+
+
+#endif /**< UART_INTERFACE_H_ */
@@ -0,0 +1,86 @@
+
+
+#ifndef UART_PRIVATE_H_
+#define UART_PRIVATE_H_
+
+/**
+ * @brief Macro definitions for the USART registers.
+ *
+ * UBRRH and UCSRC share an address; writes with URSEL set go to UCSRC.
+ */
+#define UART_UDR_R          (*((volatile u8*)0X2C))
+#define UART_UCSRA_R        (*((volatile u8*)0X2B))
+#define UART_UCSRB_R        (*((volatile u8*)0X2A))
+#define UART_UBRRL_R        (*((volatile u8*)0X29))
+#define UART_UBRRH_R        (*((volatile u8*)0X40))
+#define UART_UCSRC_R        (*((volatile u8*)0X40))
+
+/**
+ * @brief Bit positions used by the driver.
+ */
+#define _UART_FE            4     // UCSRA: frame error.
+#define _UART_DOR           3     // UCSRA: data overrun, a byte was lost in hardware.
+#define _UART_U2X           1     // UCSRA: double transmission speed.
+#define _UART_RXCIE         7     // UCSRB: receive complete interrupt enable.
+#define _UART_UDRIE         5     // UCSRB: data register empty interrupt enable.
+#define _UART_RXEN          4     // UCSRB: receiver enable.
+#define _UART_TXEN          3     // UCSRB: transmitter enable.
+#define _UART_URSEL         7     // UCSRC: select UCSRC instead of UBRRH.
+#define _UART_UCSZ1         2     // UCSRC: character size, 8 bits with UCSZ0.
+#define _UART_UCSZ0         1
+
+#ifndef F_CPU
+#error "F_CPU must be defined to compute the UART baud rate"
+#endif
+
+/**
+ * @brief Clocks per bit divider and the UBRR value giving UART_BAUD, rounded to nearest.
+ */
+#if UART_DOUBLE_SPEED
+#define _UART_DIVIDER       8UL
+#else
+#define _UART_DIVIDER       16UL
+#endif
+
+#define _UART_UBRR          ((F_CPU + _UART_DIVIDER * UART_BAUD / 2) / (_UART_DIVIDER * UART_BAUD) - 1)
+#define _UART_ACTUAL_BAUD   (F_CPU / (_UART_DIVIDER * (_UART_UBRR + 1)))
+
+#if _UART_UBRR > 4095
+#error "UART_BAUD is too low for this F_CPU"
+#endif
+
+/**< Receivers tolerate about 2 % of baud rate error */
+#if (_UART_ACTUAL_BAUD * 100 > UART_BAUD * 102) || (_UART_ACTUAL_BAUD * 100 < UART_BAUD * 98)
+#error "UART_BAUD cannot be reached within 2 % at this F_CPU, try UART_DOUBLE_SPEED"
+#endif
+
+#if (UART_TX_BUFFER_SIZE < 2) || (UART_TX_BUFFER_SIZE > 128) || (UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE - 1))
+#error "UART_TX_BUFFER_SIZE must be a power of two from 2 to 128"
+#endif
+
+#if (UART_RX_BUFFER_SIZE < 2) || (UART_RX_BUFFER_SIZE > 128) || (UART_RX_BUFFER_SIZE & (UART_RX_BUFFER_SIZE - 1))
+#error "UART_RX_BUFFER_SIZE must be a power of two from 2 to 128"
+#endif
+
+/**
+ * @brief Index masks of the ring buffers.
+ *
+ * Head and tail run freely over 0 to 255 and are masked on access, so
+ * head - tail is the fill level and a full buffer is told apart from an
+ * empty one without a spare slot.
+ */
+#define _UART_TX_MASK       (UART_TX_BUFFER_SIZE - 1)
+#define _UART_RX_MASK       (UART_RX_BUFFER_SIZE - 1)
+
+/**
+ * @brief USART receive complete interrupt (vector 13 on the ATmega32).
+ */
+void __vector_13(void) __attribute__((signal, used));
+
+/**
+ * @brief USART data register empty interrupt (vector 14 on the ATmega32).
+ */
+void __vector_14(void) __attribute__((signal, used));
+
+
+#endif /**< UART_PRIVATE_H_ */
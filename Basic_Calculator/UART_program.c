@@ -0,0 +1,229 @@
+
+
+/*****************************< LIB *****************************/
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+#include <avr/pgmspace.h>
+/*****************************< MCAL *****************************/
+#include "UART_interface.h"
+#include "UART_config.h"
+#include "UART_private.h"
+
+/*****************************< Private Variables *****************************/
+/**
+ * Each index has a single writer: the application moves the TX head and the
+ * RX tail, the interrupts move the TX tail and the RX head. One-byte indices
+ * are read and written atomically, so neither side masks interrupts.
+ */
+static u8 UART_TxBuffer[UART_TX_BUFFER_SIZE];  /**< Bytes waiting for the line */
+static volatile u8 UART_TxHead = 0;            /**< Next free byte, moved by UART_Write */
+static volatile u8 UART_TxTail = 0;            /**< Next byte to send, moved by the interrupt */
+static u8 UART_RxBuffer[UART_RX_BUFFER_SIZE];  /**< Bytes waiting for UART_Read */
+static volatile u8 UART_RxHead = 0;            /**< Next free byte, moved by the interrupt */
+static volatile u8 UART_RxTail = 0;            /**< Next byte to read, moved by UART_Read */
+static volatile u16 UART_RxDropped = 0;        /**< Bytes lost since UART_Init */
+
+/*****************************< Function Implementations *****************************/
+void UART_Init(void)
+{
+    /**< Disable the USART while it is configured */
+    UART_UCSRB_R = 0;
+
+    UART_TxHead = 0;
+    UART_TxTail = 0;
+    UART_RxHead = 0;
+    UART_RxTail = 0;
+    UART_RxDropped = 0;
+
+    UART_UBRRH_R = (u8)(_UART_UBRR >> 8);  /**< URSEL clear: this write goes to UBRRH */
+    UART_UBRRL_R = (u8)_UART_UBRR;
+#if UART_DOUBLE_SPEED
+    UART_UCSRA_R = (1 << _UART_U2X);
+#else
+    UART_UCSRA_R = 0;
+#endif
+
+    /**< 8 data bits, no parity, 1 stop bit */
+    UART_UCSRC_R = (1 << _UART_URSEL) | (1 << _UART_UCSZ1) | (1 << _UART_UCSZ0);
+
+    /**< The data register empty interrupt stays off until there is something to send */
+    UART_UCSRB_R = (1 << _UART_RXCIE) | (1 << _UART_RXEN) | (1 << _UART_TXEN);
+}
+
+u8 UART_Write(const u8 *data, u8 length)
+{
+    u8 Local_Count = 0;
+
+    if (data == NULL)
+    {
+        return 0;
+    }
+
+    while ((Local_Count < length) && (UART_WriteByte(data[Local_Count]) == E_OK))
+    {
+        Local_Count++;
+    }
+
+    return Local_Count;
+}
+
+Std_ReturnType UART_WriteByte(u8 data)
+{
+    u8 Local_Head = UART_TxHead;
+
+    if ((u8)(Local_Head - UART_TxTail) >= UART_TX_BUFFER_SIZE)
+    {
+        return E_NOT_OK;
+    }
+
+    UART_TxBuffer[Local_Head & _UART_TX_MASK] = data;
+    UART_TxHead = Local_Head + 1;
+
+    /**< Publish the byte before the interrupt can look for it */
+    SET_BIT(UART_UCSRB_R, _UART_UDRIE);
+
+    return E_OK;
+}
+
+u8 UART_WriteString_P(const char *string)
+{
+    u8 Local_Count = 0;
+    u8 Local_Char;
+
+    if (string == NULL)
+    {
+        return 0;
+    }
+
+    while (((Local_Char = pgm_read_byte(string++)) != '\0') && (UART_WriteByte(Local_Char) == E_OK))
+    {
+        Local_Count++;
+    }
+
+    return Local_Count;
+}
+
+void UART_WriteStringWait_P(const char *string)
+{
+    u8 Local_Char;
+
+    while ((Local_Char = pgm_read_byte(string++)) != '\0')
+    {
+        while (UART_WriteByte(Local_Char) != E_OK);
+    }
+}
+
+void UART_WriteNumber(u32 number)
+{
+    u8 Local_Digits[10];
+    u8 Local_Count = 0;
+
+    do
+    {
+        Local_Digits[Local_Count++] = (u8)(number % 10) + '0';
+        number /= 10;
+    } while (number != 0);
+
+    while (UART_WriteByte(' ') != E_OK);
+    while (Local_Count > 0)
+    {
+        while (UART_WriteByte(Local_Digits[--Local_Count]) != E_OK);
+    }
+}
+
+u8 UART_Read(u8 *data, u8 length)
+{
+    u8 Local_Count = 0;
+
+    if (data == NULL)
+    {
+        return 0;
+    }
+
+    while ((Local_Count < length) && (UART_ReadByte(&data[Local_Count]) == E_OK))
+    {
+        Local_Count++;
+    }
+
+    return Local_Count;
+}
+
+Std_ReturnType UART_ReadByte(u8 *data)
+{
+    u8 Local_Tail = UART_RxTail;
+
+    if ((data == NULL) || (Local_Tail == UART_RxHead))
+    {
+        return E_NOT_OK;
+    }
+
+    *data = UART_RxBuffer[Local_Tail & _UART_RX_MASK];
+    UART_RxTail = Local_Tail + 1;
+
+    return E_OK;
+}
+
+u8 UART_Available(void)
+{
+    return (u8)(UART_RxHead - UART_RxTail);
+}
+
+u8 UART_TxSpace(void)
+{
+    return UART_TX_BUFFER_SIZE - (u8)(UART_TxHead - UART_TxTail);
+}
+
+u16 UART_GetRxDropped(void)
+{
+    u16 Local_Dropped;
+
+    /**< The 2-byte read must not be split by the receive interrupt */
+    CLR_BIT(UART_UCSRB_R, _UART_RXCIE);
+    Local_Dropped = UART_RxDropped;
+    SET_BIT(UART_UCSRB_R, _UART_RXCIE);
+
+    return Local_Dropped;
+}
+
+/*****************************< Interrupt Service Routines *****************************/
+void __vector_13(void)
+{
+    /**< Status first: reading UDR moves the next byte's flags in */
+    u8 Local_Status = UART_UCSRA_R;
+    u8 Local_Data = UART_UDR_R;
+    u8 Local_Head = UART_RxHead;
+
+    if (GET_BIT(Local_Status, _UART_DOR))
+    {
+        UART_RxDropped++;
+    }
+
+    if (GET_BIT(Local_Status, _UART_FE))
+    {
+        return;  /**< Noise on the line, not a byte */
+    }
+
+    if ((u8)(Local_Head - UART_RxTail) >= UART_RX_BUFFER_SIZE)
+    {
+        UART_RxDropped++;
+        return;
+    }
+
+    UART_RxBuffer[Local_Head & _UART_RX_MASK] = Local_Data;
+    UART_RxHead = Local_Head + 1;
+}
+
+void __vector_14(void)
+{
+    u8 Local_Tail = UART_TxTail;
+
+    if (Local_Tail == UART_TxHead)
+    {
+        /**< Nothing left: stop the interrupt until UART_WriteByte queues more */
+        CLR_BIT(UART_UCSRB_R, _UART_UDRIE);
+        return;
+    }
+
+    UART_UDR_R = UART_TxBuffer[Local_Tail & _UART_TX_MASK];
+    UART_TxTail = Local_Tail + 1;
+}
@@ -0,0 +1,375 @@
+
+
+#ifndef BCD_ARITHMETIC_H_
+#define BCD_ARITHMETIC_H_
+
+/*****************************< Configuration *****************************/
+/**
+ * @brief Maximum number of significant decimal digits held by a BCD number.
+ * Must be even because two digits are packed into every byte.
+ */
+#ifndef BCD_MAX_DIGITS
+#define BCD_MAX_DIGITS          24
+#endif
+
+/**
+ * @brief Number of the BCD_MAX_DIGITS digits reserved for the fractional part.
+ * Three digits matches the precision shown by LCD_SendNumber.
+ */
+#ifndef BCD_FRACTION_DIGITS
+#define BCD_FRACTION_DIGITS     3
+#endif
+
+#if (BCD_MAX_DIGITS % 2) != 0
+#error "BCD_MAX_DIGITS must be even"
+#endif
+
+#if (BCD_FRACTION_DIGITS >= BCD_MAX_DIGITS)
+#error "BCD_FRACTION_DIGITS must be smaller than BCD_MAX_DIGITS"
+#endif
+
+/**
+ * @brief Number of bytes needed to store BCD_MAX_DIGITS packed digits.
+ */
+#define BCD_BYTES               (BCD_MAX_DIGITS / 2)
+
+/*****************************< Types *****************************/
+/**
+ * @brief Signed fixed-point decimal number stored as packed BCD.
+ *
+ * The value is mantissa * 10^-BCD_FRACTION_DIGITS. Digit 0 is the low nibble
+ * of digits[0], digit 1 its high nibble, and so on.
+ */
+typedef struct {
+    u8 digits[BCD_BYTES]; /**< Packed BCD mantissa, least significant byte first */
+    u8 negative;          /**< 1 if the number is negative, 0 otherwise */
+} BCD_Number_t;
+
+/*****************************< Private Helpers *****************************/
+/**
+ * @brief Read one decimal digit from a packed BCD magnitude.
+ */
+static u8 bcd_get_digit(const u8 *mag, u8 position) {
+    u8 pair = mag[position >> 1];
+    return (position & 1) ? (pair >> 4) : (pair & 0x0F);
+}
+
+/**
+ * @brief Return the number of significant digits of a packed BCD magnitude.
+ */
+static u8 bcd_digit_count(const u8 *mag, u8 length) {
+    u8 count = length * 2;
+
+    while ((count > 0) && (bcd_get_digit(mag, count - 1) == 0)) {
+        count--;
+    }
+    return count;
+}
+
+/**
+ * @brief Add two packed BCD magnitudes of the given byte length.
+ * @return The carry out of the most significant digit.
+ */
+static u8 bcd_mag_add(u8 *result, const u8 *num1, const u8 *num2, u8 length) {
+    u8 carry = 0;
+
+    for (u8 i = 0; i < length; i++) {
+        u8 low = (num1[i] & 0x0F) + (num2[i] & 0x0F) + carry;
+        carry = (low > 9);
+        if (carry) {
+            low -= 10;
+        }
+
+        u8 high = (num1[i] >> 4) + (num2[i] >> 4) + carry;
+        carry = (high > 9);
+        if (carry) {
+            high -= 10;
+        }
+
+        result[i] = (u8)((high << 4) | low);
+    }
+    return carry;
+}
+
+/**
+ * @brief Subtract two packed BCD magnitudes of the given byte length.
+ * @return The borrow out of the most significant digit (0 when num1 >= num2).
+ */
+static u8 bcd_mag_subtract(u8 *result, const u8 *num1, const u8 *num2, u8 length) {
+    u8 borrow = 0;
+
+    for (u8 i = 0; i < length; i++) {
+        s8 low = (s8)(num1[i] & 0x0F) - (s8)(num2[i] & 0x0F) - borrow;
+        borrow = (low < 0);
+        if (borrow) {
+            low += 10;
+        }
+
+        s8 high = (s8)(num1[i] >> 4) - (s8)(num2[i] >> 4) - borrow;
+        borrow = (high < 0);
+        if (borrow) {
+            high += 10;
+        }
+
+        result[i] = (u8)((high << 4) | low);
+    }
+    return borrow;
+}
+
+/**
+ * @brief Compare two packed BCD magnitudes of the given byte length.
+ *
+ * Packed BCD orders the same way as plain binary byte by byte, so the bytes are
+ * compared directly starting from the most significant one.
+ *
+ * @return 1 if num1 > num2, -1 if num1 < num2, 0 if they are equal.
+ */
+static s8 bcd_mag_compare(const u8 *num1, const u8 *num2, u8 length) {
+    while (length > 0) {
+        length--;
+        if (num1[length] != num2[length]) {
+            return (num1[length] > num2[length]) ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Multiply a packed BCD magnitude by ten and insert a new lowest digit.
+ * @return The digit shifted out of the most significant position.
+ */
+static u8 bcd_mag_shift_in(u8 *mag, u8 length, u8 digit) {
+    for (u8 i = 0; i < length; i++) {
+        u8 out = mag[i] >> 4;
+        mag[i] = (u8)((mag[i] << 4) | digit);
+        digit = out;
+    }
+    return digit;
+}
+
+/*****************************< Function Implementations *****************************/
+/**
+ * @brief Reset a BCD number to zero.
+ *
+ * @param number The number to clear.
+ */
+void bcd_clear(BCD_Number_t *number) {
+    for (u8 i = 0; i < BCD_BYTES; i++) {
+        number->digits[i] = 0;
+    }
+    number->negative = 0;
+}
+
+/**
+ * @brief Append a keypad digit to the integer part of an operand.
+ *
+ * This is the BCD counterpart of "operand = (operand * 10) + digit" in main.c.
+ *
+ * @param number The operand being typed.
+ * @param digit The new least significant integer digit (0 to 9).
+ * @return E_OK on success, E_NOT_OK if the operand would exceed BCD_MAX_DIGITS
+ *         (the operand is left unchanged in that case).
+ */
+Std_ReturnType bcd_append_digit(BCD_Number_t *number, u8 digit) {
+    if ((digit > 9) ||
+        (bcd_digit_count(number->digits, BCD_BYTES) >= BCD_MAX_DIGITS)) {
+        return E_NOT_OK;
+    }
+
+    u8 addend[BCD_BYTES] = {0};
+    addend[BCD_FRACTION_DIGITS >> 1] = (BCD_FRACTION_DIGITS & 1) ? (u8)(digit << 4) : digit;
+
+    bcd_mag_shift_in(number->digits, BCD_BYTES, 0);
+    bcd_mag_add(number->digits, number->digits, addend, BCD_BYTES);
+
+    return E_OK;
+}
+
+/**
+ * @brief Perform addition of two BCD numbers.
+ *
+ * @param result Where the sum is stored (may alias either operand).
+ * @param num1 The first operand.
+ * @param num2 The second operand.
+ * @return E_OK on success, E_NOT_OK if the sum exceeds BCD_MAX_DIGITS.
+ */
+Std_ReturnType bcd_add(BCD_Number_t *result, const BCD_Number_t *num1, const BCD_Number_t *num2) {
+    u8 negative;
+
+    if (num1->negative == num2->negative) {
+        negative = num1->negative;
+        if (bcd_mag_add(result->digits, num1->digits, num2->digits, BCD_BYTES) != 0) {
+            return E_NOT_OK;
+        }
+    } else if (bcd_mag_compare(num1->digits, num2->digits, BCD_BYTES) >= 0) {
+        negative = num1->negative;
+        bcd_mag_subtract(result->digits, num1->digits, num2->digits, BCD_BYTES);
+    } else {
+        negative = num2->negative;
+        bcd_mag_subtract(result->digits, num2->digits, num1->digits, BCD_BYTES);
+    }
+
+    /**< Never produce a negative zero */
+    result->negative = (bcd_digit_count(result->digits, BCD_BYTES) != 0) ? negative : 0;
+
+    return E_OK;
+}
+
+/**
+ * @brief Perform subtraction of two BCD numbers.
+ *
+ * @param result Where the difference is stored (may alias either operand).
+ * @param num1 The minuend.
+ * @param num2 The subtrahend.
+ * @return E_OK on success, E_NOT_OK if the difference exceeds BCD_MAX_DIGITS.
+ */
+Std_ReturnType bcd_subtract(BCD_Number_t *result, const BCD_Number_t *num1, const BCD_Number_t *num2) {
+    BCD_Number_t negated = *num2;
+
+    negated.negative = !negated.negative;
+    return bcd_add(result, num1, &negated);
+}
+
+/**
+ * @brief Perform multiplication of two BCD numbers.
+ *
+ * Schoolbook multiplication over the significant digits only, so the cost grows
+ * with the digits actually typed rather than with BCD_MAX_DIGITS. Fractional
+ * digits beyond BCD_FRACTION_DIGITS are truncated toward zero.
+ *
+ * @param result Where the product is stored (may alias either operand).
+ * @param num1 The first operand.
+ * @param num2 The second operand.
+ * @return E_OK on success, E_NOT_OK if the product exceeds BCD_MAX_DIGITS.
+ */
+Std_ReturnType bcd_multiply(BCD_Number_t *result, const BCD_Number_t *num1, const BCD_Number_t *num2) {
+    u8 product[2 * BCD_MAX_DIGITS] = {0};
+    u8 count1 = bcd_digit_count(num1->digits, BCD_BYTES);
+    u8 count2 = bcd_digit_count(num2->digits, BCD_BYTES);
+    u8 negative = num1->negative ^ num2->negative;
+
+    for (u8 i = 0; i < count1; i++) {
+        u8 digit1 = bcd_get_digit(num1->digits, i);
+        u8 carry = 0;
+
+        if (digit1 == 0) {
+            continue;
+        }
+
+        for (u8 j = 0; j < count2; j++) {
+            u8 sum = product[i + j] + (digit1 * bcd_get_digit(num2->digits, j)) + carry;
+            product[i + j] = sum % 10;
+            carry = sum / 10;
+        }
+        product[i + count2] = carry;
+    }
+
+    /**< Anything above the kept window is an overflow */
+    for (u8 i = BCD_FRACTION_DIGITS + BCD_MAX_DIGITS; i < (2 * BCD_MAX_DIGITS); i++) {
+        if (product[i] != 0) {
+            return E_NOT_OK;
+        }
+    }
+
+    for (u8 i = 0; i < BCD_BYTES; i++) {
+        u8 position = BCD_FRACTION_DIGITS + (2 * i);
+        result->digits[i] = (u8)((product[position + 1] << 4) | product[position]);
+    }
+    result->negative = (bcd_digit_count(result->digits, BCD_BYTES) != 0) ? negative : 0;
+
+    return E_OK;
+}
+
+/**
+ * @brief Perform long division of two BCD numbers.
+ *
+ * Classic pencil-and-paper division: the remainder is shifted one digit at a
+ * time and the divisor subtracted until it no longer fits, giving one quotient
+ * digit per step. The quotient is truncated toward zero after
+ * BCD_FRACTION_DIGITS fractional digits.
+ *
+ * @param result Where the quotient is stored (may alias either operand).
+ * @param num1 The dividend.
+ * @param num2 The divisor.
+ * @return E_OK on success, E_NOT_OK on division by zero or if the quotient
+ *         exceeds BCD_MAX_DIGITS.
+ */
+Std_ReturnType bcd_divide(BCD_Number_t *result, const BCD_Number_t *num1, const BCD_Number_t *num2) {
+    /**< One spare byte so remainder * 10 + digit never overflows */
+    u8 divisor[BCD_BYTES + 1] = {0};
+    u8 remainder[BCD_BYTES + 1] = {0};
+    u8 quotient[BCD_BYTES] = {0};
+    u8 count1 = bcd_digit_count(num1->digits, BCD_BYTES);
+    u8 negative = num1->negative ^ num2->negative;
+
+    if (bcd_digit_count(num2->digits, BCD_BYTES) == 0) {
+        return E_NOT_OK; /**< Division by zero */
+    }
+
+    for (u8 i = 0; i < BCD_BYTES; i++) {
+        divisor[i] = num2->digits[i];
+    }
+
+    /**< Dividend digits followed by BCD_FRACTION_DIGITS zeros rescale the quotient */
+    for (u8 step = count1 + BCD_FRACTION_DIGITS; step > 0; step--) {
+        u8 digit = (step > BCD_FRACTION_DIGITS) ? bcd_get_digit(num1->digits, step - 1 - BCD_FRACTION_DIGITS) : 0;
+        u8 quotientDigit = 0;
+
+        bcd_mag_shift_in(remainder, BCD_BYTES + 1, digit);
+        while (bcd_mag_compare(remainder, divisor, BCD_BYTES + 1) >= 0) {
+            bcd_mag_subtract(remainder, remainder, divisor, BCD_BYTES + 1);
+            quotientDigit++;
+        }
+
+        if (bcd_mag_shift_in(quotient, BCD_BYTES, quotientDigit) != 0) {
+            return E_NOT_OK;
+        }
+    }
+
+    for (u8 i = 0; i < BCD_BYTES; i++) {
+        result->digits[i] = quotient[i];
+    }
+    result->negative = (bcd_digit_count(result->digits, BCD_BYTES) != 0) ? negative : 0;
+
+    return E_OK;
+}
+
+/**
+ * @brief Display a BCD number on the LCD.
+ *
+ * Each nibble is already a decimal digit, so it is sent straight to
+ * LCD_SendChar without any binary-to-decimal conversion. The format matches
+ * LCD_SendNumber: optional sign, integer part, '.', BCD_FRACTION_DIGITS digits.
+ *
+ * @param config Pointer to the LCD configuration structure.
+ * @param number The number to display.
+ * @return The number of characters written, which can exceed the 16 visible columns.
+ */
+u8 bcd_display(const LCD_Config_t *config, const BCD_Number_t *number) {
+    u8 position = bcd_digit_count(number->digits, BCD_BYTES);
+    u8 length = 0;
+
+    /**< Always show at least one integer digit */
+    if (position <= BCD_FRACTION_DIGITS) {
+        position = BCD_FRACTION_DIGITS + 1;
+    }
+
+    if (number->negative) {
+        LCD_SendChar(config, '-');
+        length++;
+    }
+
+    while (position > 0) {
+        position--;
+        LCD_SendChar(config, bcd_get_digit(number->digits, position) + '0');
+        length++;
+        if ((position == BCD_FRACTION_DIGITS) && (position != 0)) {
+            LCD_SendChar(config, '.');
+            length++;
+        }
+    }
+
+    return length;
+}
+
+#endif /**< BCD_ARITHMETIC_H_ */
@@ -0,0 +1,401 @@
+#ifndef CALC_SERIAL_H_
+#define CALC_SERIAL_H_
+
+/*****************************< Configuration *****************************/
+/**
+ * @brief Framing of requests and replies on the serial link.
+ *
+ * - CALC_SERIAL_NEWLINE: one expression per line, '\n' ends it ('\r' is ignored).
+ * - CALC_SERIAL_COBS: one expression per COBS-encoded frame ending in a 0x00 byte.
+ *
+ * A request is "<operand><operator><operand>" with optionally signed decimal
+ * operands and one of + - * /, e.g. "12*-7". The reply uses the same framing
+ * and holds the result with three decimals, as on the LCD, or "ERR" for a
+ * malformed request, an operand that does not fit, an overflow or a division
+ * by zero. Empty requests get no reply.
+ *
+ * With CALC_SERIAL_NEWLINE, a request holding only '?' asks for the
+ * diagnostics: the lines written by the function given to
+ * calc_serial_set_diagnostics, then an "end" line. Without such a function,
+ * or with COBS framing, '?' is a malformed request.
+ */
+#define CALC_SERIAL_NEWLINE     0
+#define CALC_SERIAL_COBS        1
+
+#ifndef CALC_SERIAL_FRAMING
+#define CALC_SERIAL_FRAMING     CALC_SERIAL_NEWLINE
+#endif
+
+/**
+ * @brief Size of the reply buffer: the longest result text plus the framing bytes.
+ */
+#define CALC_SERIAL_REPLY_SIZE  32
+
+#if CALC_BCD_MODE && ((BCD_MAX_DIGITS + 4) > CALC_SERIAL_REPLY_SIZE)
+#error "CALC_SERIAL_REPLY_SIZE is too small for BCD_MAX_DIGITS"
+#endif
+
+/*****************************< Types *****************************/
+/**
+ * @brief Parser position inside the current request.
+ */
+typedef enum {
+    CALC_SERIAL_FIRST,       /**< Sign or digits of the first operand */
+    CALC_SERIAL_SECOND,      /**< Sign or digits of the second operand */
+    CALC_SERIAL_DIAGNOSTICS, /**< '?' read, nothing may follow it */
+    CALC_SERIAL_INVALID      /**< Malformed, skipped up to the end of the request */
+} CalcSerial_State_t;
+
+/**
+ * @brief State of the serial evaluation service.
+ *
+ * Requests are decoded and parsed byte by byte as they arrive, so the next
+ * request is taken in while the UART interrupt still sends the previous
+ * reply; once its terminator arrives only the arithmetic is left to do.
+ */
+typedef struct {
+    CalcSerial_State_t state;           /**< Parser position */
+    char operator;                      /**< Operator of the current request */
+    u8 digits;                          /**< Digits read of the current operand */
+    u8 negative;                        /**< The current operand had a '-' sign */
+    u8 empty;                           /**< Nothing but framing read since the last request */
+#if CALC_BCD_MODE
+    BCD_Number_t operands[2];           /**< First and second operand */
+#else
+    s32 operands[2];                    /**< Operands, magnitudes kept within INT16_MAX */
+#endif
+    u8 requestReady;                    /**< A complete request waits for the reply buffer */
+#if CALC_SERIAL_FRAMING == CALC_SERIAL_COBS
+    u8 cobsRemaining;                   /**< Data bytes left in the current COBS block */
+    u8 cobsZeroPending;                 /**< The current block ends with a zero byte */
+#endif
+    u8 reply[CALC_SERIAL_REPLY_SIZE];   /**< Framed reply being sent */
+    u8 replyLength;                     /**< Bytes in reply, 0 when the buffer is free */
+    u8 replySent;                       /**< Bytes of reply already in the UART buffer */
+    void (*diagnostics)(void);          /**< Writes the reply to '?', NULL when there is none */
+} CalcSerial_t;
+
+static CalcSerial_t calc_serial;
+
+/*****************************< Private Helpers *****************************/
+/**
+ * @brief Start parsing a new request.
+ */
+static void calc_serial_reset_request(void) {
+    calc_serial.state = CALC_SERIAL_FIRST;
+    calc_serial.operator = '\0';
+    calc_serial.digits = 0;
+    calc_serial.negative = 0;
+    calc_serial.empty = 1;
+#if CALC_BCD_MODE
+    bcd_clear(&calc_serial.operands[0]);
+    bcd_clear(&calc_serial.operands[1]);
+#else
+    calc_serial.operands[0] = 0;
+    calc_serial.operands[1] = 0;
+#endif
+}
+
+/**
+ * @brief Feed one decoded request character to the parser.
+ *
+ * @param c The character.
+ */
+static void calc_serial_parse(u8 c) {
+    u8 operand = (calc_serial.state == CALC_SERIAL_SECOND) ? 1 : 0;
+
+    if ((c == ' ') || (c == '\r') || (calc_serial.state == CALC_SERIAL_INVALID)) {
+        return;
+    }
+    calc_serial.empty = 0;
+
+    if (calc_serial.state == CALC_SERIAL_DIAGNOSTICS) {
+        calc_serial.state = CALC_SERIAL_INVALID;
+        return;
+    }
+
+    if ((c >= '0') && (c <= '9')) {
+#if CALC_BCD_MODE
+        if (bcd_append_digit(&calc_serial.operands[operand], c - '0') != E_OK) {
+            calc_serial.state = CALC_SERIAL_INVALID;
+            return;
+        }
+        calc_serial.operands[operand].negative = calc_serial.negative;
+#else
+        /**< Operands are a 16-bit int, as on the keypad */
+        if (calc_serial.operands[operand] > ((INT16_MAX - (c - '0')) / 10)) {
+            calc_serial.state = CALC_SERIAL_INVALID;
+            return;
+        }
+        calc_serial.operands[operand] = (calc_serial.operands[operand] * 10) + (c - '0');
+#endif
+        calc_serial.digits++;
+    } else if ((c == '-') && (calc_serial.digits == 0) && !calc_serial.negative) {
+        calc_serial.negative = 1;
+    } else if ((operand == 0) && (calc_serial.digits != 0) &&
+               ((c == '+') || (c == '-') || (c == '*') || (c == '/'))) {
+#if !CALC_BCD_MODE
+        if (calc_serial.negative) {
+            calc_serial.operands[0] = -calc_serial.operands[0];
+        }
+#endif
+        calc_serial.operator = (char)c;
+        calc_serial.state = CALC_SERIAL_SECOND;
+        calc_serial.digits = 0;
+        calc_serial.negative = 0;
+#if CALC_SERIAL_FRAMING == CALC_SERIAL_NEWLINE
+    } else if ((c == '?') && (operand == 0) && (calc_serial.digits == 0) && !calc_serial.negative &&
+               (calc_serial.diagnostics != NULL)) {
+        calc_serial.state = CALC_SERIAL_DIAGNOSTICS;
+#endif
+    } else {
+        calc_serial.state = CALC_SERIAL_INVALID;
+    }
+}
+
+/**
+ * @brief Evaluate the parsed request and write the result text.
+ *
+ * A diagnostics request writes its lines straight to the UART, waiting for
+ * room, and gets "end" as the text. The previous reply is already in the UART
+ * buffer then, so nothing interleaves.
+ *
+ * @param text Buffer for the text, CALC_SERIAL_REPLY_SIZE - 2 bytes.
+ * @return The length of the text.
+ */
+static u8 calc_serial_evaluate(u8 *text) {
+    u8 length = 0;
+
+    if (calc_serial.state == CALC_SERIAL_DIAGNOSTICS) {
+        calc_serial.diagnostics();
+        text[0] = 'e';
+        text[1] = 'n';
+        text[2] = 'd';
+        return 3;
+    }
+
+    if ((calc_serial.state == CALC_SERIAL_SECOND) && (calc_serial.digits != 0)) {
+#if CALC_BCD_MODE
+        BCD_Number_t result;
+        Std_ReturnType state;
+        u8 position;
+
+        switch (calc_serial.operator) {
+            case '+':
+                state = bcd_add(&result, &calc_serial.operands[0], &calc_serial.operands[1]);
+                break;
+            case '-':
+                state = bcd_subtract(&result, &calc_serial.operands[0], &calc_serial.operands[1]);
+                break;
+            case '*':
+                state = bcd_multiply(&result, &calc_serial.operands[0], &calc_serial.operands[1]);
+                break;
+            default:
+                state = bcd_divide(&result, &calc_serial.operands[0], &calc_serial.operands[1]);
+                break;
+        }
+
+        if (state == E_OK) {
+            /**< Same digits as bcd_display */
+            position = bcd_digit_count(result.digits, BCD_BYTES);
+            if (position <= BCD_FRACTION_DIGITS) {
+                position = BCD_FRACTION_DIGITS + 1;
+            }
+            if (result.negative) {
+                text[length++] = '-';
+            }
+            while (position > 0) {
+                position--;
+                text[length++] = bcd_get_digit(result.digits, position) + '0';
+                if ((position == BCD_FRACTION_DIGITS) && (position != 0)) {
+                    text[length++] = '.';
+                }
+            }
+            return length;
+        }
+#else
+        s32 second = calc_serial.negative ? -calc_serial.operands[1] : calc_serial.operands[1];
+        s32 first = calc_serial.operands[0];
+        double result;
+        u8 valid = 1;
+
+        /**< add(), subtract() and multiply() wrap around in the 16-bit int of the keypad
+         *   engine; in s32 nothing wraps, so a result out of the int range is an error */
+        switch (calc_serial.operator) {
+            case '+':
+                result = first + second;
+                break;
+            case '-':
+                result = first - second;
+                break;
+            case '*':
+                result = first * second;
+                break;
+            default:
+                /**< divide() returns -1 for a zero divisor, which is a valid quotient here */
+                valid = (second != 0);
+                result = valid ? divide((int)first, (int)second) : 0;
+                break;
+        }
+        if ((result < INT16_MIN) || (result > INT16_MAX)) {
+            valid = 0;
+        }
+
+        if (valid) {
+            u8 integer[10];
+            u8 count = 0;
+            u32 integerPart;
+            double fraction;
+
+            if (result < 0) {
+                text[length++] = '-';
+                result = -result;
+            }
+            integerPart = (u32)result;
+            fraction = result - integerPart;
+
+            do {
+                integer[count++] = integerPart % 10;
+                integerPart /= 10;
+            } while (integerPart != 0);
+            while (count > 0) {
+                text[length++] = integer[--count] + '0';
+            }
+
+            /**< Three truncated decimals, as LCD_SendNumber shows them */
+            text[length++] = '.';
+            for (u8 i = 0; i < 3; i++) {
+                fraction *= 10;
+                text[length] = (u8)fraction;
+                fraction -= text[length];
+                text[length++] += '0';
+            }
+            return length;
+        }
+#endif
+    }
+
+    text[0] = 'E';
+    text[1] = 'R';
+    text[2] = 'R';
+
+    return 3;
+}
+
+/**
+ * @brief Answer the request that just ended, if the reply buffer is free.
+ */
+static void calc_serial_finish_request(void) {
+    if (calc_serial.replyLength != 0) {
+        /**< Still sending the previous reply; answered from calc_serial_poll */
+        calc_serial.requestReady = 1;
+        return;
+    }
+
+    calc_serial.requestReady = 0;
+    if (!calc_serial.empty) {
+#if CALC_SERIAL_FRAMING == CALC_SERIAL_COBS
+        /**< Result text never holds a zero byte, so it is a single COBS block */
+        u8 length = calc_serial_evaluate(&calc_serial.reply[1]);
+        calc_serial.reply[0] = length + 1;
+        calc_serial.reply[length + 1] = 0x00;
+        calc_serial.replyLength = length + 2;
+#else
+        u8 length = calc_serial_evaluate(&calc_serial.reply[0]);
+        calc_serial.reply[length] = '\n';
+        calc_serial.replyLength = length + 1;
+#endif
+        calc_serial.replySent = 0;
+    }
+    calc_serial_reset_request();
+}
+
+/**
+ * @brief Feed one received byte through the framing layer.
+ *
+ * @param byte The byte.
+ */
+static void calc_serial_receive(u8 byte) {
+#if CALC_SERIAL_FRAMING == CALC_SERIAL_COBS
+    if (byte == 0x00) {
+        /**< End of frame; a block cut short means a corrupted frame */
+        if (calc_serial.cobsRemaining != 0) {
+            calc_serial_parse(0x00);
+        }
+        calc_serial.cobsRemaining = 0;
+        calc_serial.cobsZeroPending = 0;
+        calc_serial_finish_request();
+    } else if (calc_serial.cobsRemaining == 0) {
+        /**< Code byte: the previous block's zero, if any, then byte - 1 data bytes */
+        if (calc_serial.cobsZeroPending) {
+            calc_serial_parse(0x00);
+        }
+        calc_serial.cobsRemaining = byte - 1;
+        calc_serial.cobsZeroPending = (byte != 0xFF);
+    } else {
+        calc_serial_parse(byte);
+        calc_serial.cobsRemaining--;
+    }
+#else
+    if (byte == '\n') {
+        calc_serial_finish_request();
+    } else {
+        calc_serial_parse(byte);
+    }
+#endif
+}
+
+/*****************************< Function Implementations *****************************/
+/**
+ * @brief Start the serial evaluation service; UART_Init must have been called.
+ */
+void calc_serial_init(void) {
+    calc_serial.replyLength = 0;
+    calc_serial.requestReady = 0;
+#if CALC_SERIAL_FRAMING == CALC_SERIAL_COBS
+    calc_serial.cobsRemaining = 0;
+    calc_serial.cobsZeroPending = 0;
+#endif
+    calc_serial_reset_request();
+}
+
+/**
+ * @brief Set the function that answers a '?' request.
+ *
+ * It writes whole lines to the UART and may wait for room to do so; the
+ * diagnostics dumps (PROF_DumpUart, LAT_DumpUart, ...) are such functions.
+ *
+ * @param dump The function, or NULL to answer '?' with "ERR".
+ */
+void calc_serial_set_diagnostics(void (*dump)(void)) {
+    calc_serial.diagnostics = dump;
+}
+
+/**
+ * @brief Move the service forward; call it from the main loop.
+ *
+ * Never waits: it hands as much of the pending reply to the UART as fits,
+ * then parses whatever arrived, stopping at a complete request while the
+ * previous reply is still being handed over.
+ */
+void calc_serial_poll(void) {
+    u8 byte;
+
+    if (calc_serial.replyLength != 0) {
+        calc_serial.replySent += UART_Write(&calc_serial.reply[calc_serial.replySent],
+                                            calc_serial.replyLength - calc_serial.replySent);
+        if (calc_serial.replySent == calc_serial.replyLength) {
+            calc_serial.replyLength = 0;
+        }
+    }
+
+    if (calc_serial.requestReady) {
+        calc_serial_finish_request();
+    }
+
+    while (!calc_serial.requestReady && (UART_ReadByte(&byte) == E_OK)) {
+        calc_serial_receive(byte);
+    }
+}
+
+#endif /**< CALC_SERIAL_H_ */
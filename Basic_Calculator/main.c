@@ -5,60 +5,129 @@
 #include "STD_TYPES.h"
 #include "BIT_MATH.h"
 #include "util/delay.h"
+#include <avr/pgmspace.h>
+#include <avr/interrupt.h>
 /*****************************< MCAL *****************************/
 #include "DIO_interface.h"
+#include "TMR0_interface.h"
+#include "UART_interface.h"
+#include "EEPROM_interface.h"
 /*****************************< HAL *****************************/
 #include "CLCD_interface.h"
 #include "KPD_interface.h"
+#include "ANIM_interface.h"
+#include "PROF_interface.h"
+#include "LAT_interface.h"
+#include "MEM_interface.h"
+#include "HIST_interface.h"
+#include "BOOT_interface.h"
 /*****************************< APP *****************************/
 #include "main.h"
 #include "arithmetic_operations.h"
+#if CALC_BCD_MODE
+#include "bcd_arithmetic.h"
+#endif
+#if CALC_SERIAL_SERVICE
+#include "calc_serial.h"
+#endif
+/*****************************< Private Types *****************************/
+/**< Where the boot is, as seen from the main loop */
+typedef enum {
+    CALC_BOOT_LCD_INIT = 0,  /**< The LCD initialization is playing */
+    CALC_BOOT_SPLASH,        /**< The welcome screen is up */
+    CALC_BOOT_DONE           /**< Calculating */
+} CALC_BootStage_t;
+
+/**< One calculation as kept in the EEPROM history */
+typedef struct {
+#if CALC_BCD_MODE
+    BCD_Number_t firstOperand;
+    BCD_Number_t secondOperand;
+    BCD_Number_t result;
+#else
+    int firstOperand;
+    int secondOperand;
+    double result;
+#endif
+    char operator;
+} CALC_HistoryEntry_t;
+
+/*****************************< Private Variables *****************************/
+/**< Busy spinner: one glyph, four frames */
+static const uint8_t spinnerFrames[4][1][8] PROGMEM = {
+    {{0x00, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00}},
+    {{0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00, 0x00}},
+    {{0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x00}},
+    {{0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00}}
+};
+
+/**< Welcome screen: first row, then the cursor on the second */
+static const uint8_t welcomeScript[] PROGMEM = {
+    LCD_SCRIPT_GOTO, 0, 0,
+    LCD_SCRIPT_DATA(13), 'W', 'e', 'l', 'c', 'o', 'm', 'e', ' ', 't', 'o', ' ', 'm', 'y',
+    LCD_SCRIPT_GOTO, 0, 1,
+    LCD_SCRIPT_END
+};
+
 /*****************************< Business Logic *****************************/
 int main(void) {
 
 	/*****************************< Init Sector *****************************/
+	/**<--------------------< System tick --------------------*/
+	// 1 ms tick used to pace the LCD animations and the LCD initialization
+	TMR0_Init();
+	// The tick must run for the LCD waits to end, so interrupts come first
+	sei();
+	BOOT_Mark(BOOT_TIMER_STARTED);
+
 	/**<--------------------< LCD Configuration --------------------*/
-	// Declare an instance of LCD configuration structure.
-	LCD_Config_t lcd1;
+	// Declare the data bus; more displays can share it, each with its own enable pin.
+	LCD_Bus_t lcdBus;
 
 	// Set the mode of operation to 4-bit mode.
-	lcd1.mode = LCD_4BitMode;
+	lcdBus.mode = LCD_4BitMode;
 
 	// Configure data pins for 4-bit mode operation.
 	for (u8 i = 0; i < 4; i++) {
 	    // Set the port ID for data pin i to DIO_PORTA.
-	    lcd1.dataPins[i].LCD_PortId = DIO_PORTA;
-	    // Set the pin ID for data pin i using DIO_PIN3 - i.
-	    lcd1.dataPins[i].LCD_PinId = DIO_PIN3 + i;
+	    lcdBus.dataPins[i].LCD_PortId = DIO_PORTA;
+	    // Set the pin ID for data pin i using DIO_PIN3 + i.
+	    lcdBus.dataPins[i].LCD_PinId = DIO_PIN3 + i;
 	}
 
-	// Configure enable pin.
-	// Set the port ID for the enable pin to DIO_PORTA.
-	lcd1.enablePin.LCD_PortId = DIO_PORTA;
-	// Set the pin ID for the enable pin to DIO_PIN4.
-	lcd1.enablePin.LCD_PinId = DIO_PIN2;
-
 	// Configure rs pin.
 	// Set the port ID for the rs pin to DIO_PORTA.
-	lcd1.rsPin.LCD_PortId = DIO_PORTA;
-	// Set the pin ID for the rs pin to DIO_PIN5.
-	lcd1.rsPin.LCD_PinId = DIO_PIN1;
+	lcdBus.rsPin.LCD_PortId = DIO_PORTA;
+	// Set the pin ID for the rs pin to DIO_PIN1.
+	lcdBus.rsPin.LCD_PinId = DIO_PIN1;
 
-	// Initialize the LCD module with the configured settings.
-	LCD_Init(&lcd1);
-	LCD_Clear(&lcd1);
+	// Configure rw pin, held low since the driver only writes.
+	lcdBus.rwPin.LCD_PortId = DIO_PORTA;
+	lcdBus.rwPin.LCD_PinId = DIO_PIN0;
 
-	/**< Display a welcome message */
-	LCD_SendString(&lcd1, (uint8_t *)"Welcome to my");
-	LCD_GoToXYPos(&lcd1, 0, 1);
-	LCD_SendString(&lcd1, (uint8_t *)"Basic Calculator");
+	// Drive the shared lines once for every display on the bus.
+	LCD_BusInit(&lcdBus);
 
-	// Add a short delay (e.g., 5 milliseconds)
-	_delay_ms(1000);
+	// Declare an instance of LCD configuration structure on that bus.
+	LCD_Config_t lcd1;
+	lcd1.bus = &lcdBus;
 
-	// Clear the LCD display
-	LCD_Clear(&lcd1);
+	// Configure enable pin.
+	// Set the port ID for the enable pin to DIO_PORTA.
+	lcd1.enablePins[0].LCD_PortId = DIO_PORTA;
+	// Set the pin ID for the enable pin to DIO_PIN2.
+	lcd1.enablePins[0].LCD_PinId = DIO_PIN2;
+	lcd1.enableCount = 1;
 
+	// Start initializing the LCD module; its power-on and reset waits run from
+	// the main loop while the rest of the system comes up.
+	LCD_InitStart(&lcd1, NULL);
+	BOOT_Mark(BOOT_LCD_STARTED);
+
+	// Visible size of the panel; longer expressions and results stay in the
+	// LCD's 40-character line and are brought into view with display shifts
+	LCD_Geometry_t screen;
+	LCD_GetGeometry(&screen);
 
 	/**<--------------------< KPD Configuration --------------------*/
 	// Configure data pins for rows and columns
@@ -68,49 +137,219 @@ int main(void) {
 	    // Set the direction of the pin corresponding to the column to INPUT
 	    DIO_SetPinDirection(DIO_PORTD, DIO_PIN2 + i, DIO_INPUT); // Columns
 	}
+	BOOT_Mark(BOOT_KEYPAD_READY);
+
+	/**<--------------------< Services --------------------*/
+#if PROF_ENABLE
+	// Cycle counter for the marked functions, dumped with the 'c' key
+	PROF_Init();
+#endif
+	// Serial link for the host: expression service and diagnostics dumps
+	UART_Init();
+#if CALC_SERIAL_SERVICE
+	// Expressions from the host are answered from the main loop, diagnostics on '?'
+	calc_serial_init();
+	calc_serial_set_diagnostics(dump_diagnostics);
+#endif
+	// Background EEPROM writes for the calculation history
+	EEPROM_Init();
+
+	// Spinner animation, advancing every 100 ticks
+	ANIM_Animation_t spinner = {&spinnerFrames[0][0][0], 4, 1, 100};
+
+	/**< Find the newest calculation kept in EEPROM */
+	HIST_Init();
+	CALC_HistoryEntry_t historyEntry;
+	BOOT_Mark(BOOT_SERVICES_READY);
+
+	// Boot progress: LCD initialization, then the welcome screen until a key or a second passes
+	CALC_BootStage_t bootStage = CALC_BOOT_LCD_INIT;
+	u32 splashStart = 0;
+
+	// A key pressed before the LCD is ready, handled once it is
+	uint8_t heldKey = '\0';
 
 	// Variable to store the currently pressed key on the keypad
 	uint8_t pressedKey = '\0';
 
+#if !CALC_BCD_MODE
     // Variable to store the result of the operation
     double result = 0;
+#endif
+
+    // Set once the stack headroom warning has been given
+    u8 memoryWarned = 0;
+
+    // Set while historyEntry waits for the EEPROM to finish the previous record
+    u8 historyQueued = 0;
+
+    // Set while a big-digit or scrolling result is on the screen
+    u8 clearOnNextKey = 0;
+
+    // Characters echoed on the first row; past the last column the display shifts to follow
+    u8 echoLength = 0;
 
     // Variable to store the operator
     char operator;
 
+#if CALC_BCD_MODE
+    // BCD operands and result; the operator is held in 'operator' as above
+    BCD_Number_t firstOperand, secondOperand, result;
+    Std_ReturnType bcdState;
+
+    bcd_clear(&firstOperand);
+    bcd_clear(&secondOperand);
+#else
     // Variable to store the first and second operands
     int firstOperand = 0, secondOperand = 0;
+#endif
 
     /*****************************< Loop indefinitely *****************************/
     while (1) {
-        // Check if a key is pressed
-        if (KPD_GetKeyState(&pressedKey) == E_OK) {
+#if CALC_SERIAL_SERVICE
+        // Answer the host without waiting for the line
+        calc_serial_poll();
+#endif
+
+        // Hand the history the calculation it could not take while writing the one before
+        if (historyQueued && (HIST_Append(&historyEntry, sizeof(historyEntry)) == E_OK)) {
+            historyQueued = 0;
+        }
+
+        // Warn once if the stack came close to the variables
+        if ((MEM_Check() != E_OK) && !memoryWarned) {
+#if CALC_SERIAL_SERVICE
+            // The UART carries replies only: warn on the second row between two calculations,
+            // the numbers are in the reply to '?'
+            if ((bootStage == CALC_BOOT_DONE) && (echoLength == 0) && !clearOnNextKey) {
+                LCD_GoToXYPos(&lcd1, 0, 1);
+                LCD_SendString_P(&lcd1, (const uint8_t *)PSTR("RAM low"));
+                clearOnNextKey = 1;
+                memoryWarned = 1;
+            }
+#else
+            UART_WriteString_P(PSTR("RAM low\n"));
+            MEM_DumpUart();
+            memoryWarned = 1;
+#endif
+        }
+
+        // Scroll a long result, one display shift per step
+        LCD_MarqueeUpdate(&lcd1);
+
+        if (bootStage == CALC_BOOT_LCD_INIT) {
+            // Play the LCD initialization a few steps at a time
+            LCD_ScriptUpdate();
+            if (!LCD_ScriptIsRunning()) {
+                BOOT_Mark(BOOT_LCD_READY);
+
+                /**< Display a welcome message, with the last result of the previous session if there is one */
+                LCD_ScriptRun(&lcd1, welcomeScript);
+                if (HIST_Get(0, &historyEntry, sizeof(historyEntry)) == sizeof(historyEntry)) {
+                    LCD_SendString_P(&lcd1, (const uint8_t *)PSTR("Ans "));
+#if CALC_BCD_MODE
+                    bcd_display(&lcd1, &historyEntry.result);
+#else
+                    LCD_SendNumber(&lcd1, historyEntry.result);
+#endif
+                } else {
+                    LCD_SendString_P(&lcd1, (const uint8_t *)PSTR("Basic Calculator"));
+                }
+                BOOT_Mark(BOOT_SPLASH_SHOWN);
+
+                splashStart = TMR0_GetTicks();
+                bootStage = CALC_BOOT_SPLASH;
+            }
+        } else if ((bootStage == CALC_BOOT_SPLASH) && ((TMR0_GetTicks() - splashStart) >= CALC_SPLASH_MS)) {
+            // Nobody dismissed the welcome screen
+            LCD_Clear(&lcd1);
+            bootStage = CALC_BOOT_DONE;
+        }
+
+        // Keys are read from the start; one pressed during the LCD initialization waits for it
+        if ((heldKey == '\0') && (KPD_GetKeyState(&pressedKey) == E_OK)) {
+            heldKey = pressedKey;
+        }
+
+        // Handle the key once it can be shown
+        if ((heldKey != '\0') && (bootStage != CALC_BOOT_LCD_INIT)) {
+            LAT_MARK(LAT_DISPATCH);
+            pressedKey = heldKey;
+            heldKey = '\0';
+
+            // A key dismisses the welcome screen
+            if (bootStage == CALC_BOOT_SPLASH) {
+                LCD_Clear(&lcd1);
+                bootStage = CALC_BOOT_DONE;
+            }
+
+            // Start the next expression on a clean, unshifted screen
+            if (clearOnNextKey) {
+                LCD_Clear(&lcd1);
+                clearOnNextKey = 0;
+                echoLength = 0;
+            }
+
             // If a key is pressed, send its value to the LCD module
-            LCD_SendString(&lcd1, (uint8_t *)&pressedKey);
+            LCD_SendChar(&lcd1, pressedKey);
+            LAT_MARK(LAT_DISPLAYED);
+            echoLength++;
+
+            // Keep the cursor in view once the expression is wider than the screen
+            if (echoLength > screen.columns) {
+                LCD_ShiftDisplay(&lcd1, LCD_SHIFT_LEFT);
+            }
 
             // Check if the pressed key is 'c' (clear)
             if (pressedKey == 'c') {
+#if !CALC_SERIAL_SERVICE
+               // Diagnostics for the host; the expression service sends them on '?' instead
+               dump_diagnostics();
+#endif
+
                // Clear the LCD display
                LCD_Clear(&lcd1);
 
                // Write new content to the LCD
-               LCD_SendString(&lcd1, (uint8_t *)"Clearing...");
-               // Add a short delay (e.g., 5 milliseconds)
-			  _delay_ms(1000);
+               LCD_SendString_P(&lcd1, (const uint8_t *)PSTR("Clearing..."));
+
+               // Spin next to the message for one second
+               ANIM_Start(&lcd1, &spinner);
+               ANIM_AddCell(12, 0, 0);
+               LCD_Flush(&lcd1);
+               u32 clearStart = TMR0_GetTicks();
+               while ((TMR0_GetTicks() - clearStart) < 1000) {
+                   ANIM_Update();
+               }
+               ANIM_Stop();
+#if CALC_BIG_DIGITS
+               // The animation used CGRAM, bring the big-digit segments back
+               LCD_LoadBigDigitFont(&lcd1);
+#endif
 
                // Clear the LCD display
                LCD_Clear(&lcd1);
 
                // Reset the operands and operator for the next calculation
+#if CALC_BCD_MODE
+			   bcd_clear(&firstOperand);
+			   bcd_clear(&secondOperand);
+#else
 			   firstOperand = 0;
 			   secondOperand = 0;
+#endif
 			   operator = '\0';
+			   echoLength = 0;
             } else if (pressedKey >= '0' && pressedKey <= '9') {
                 /**< If the pressed key is a numeric digit, handle it as before */
                 // Convert the ASCII character to its numeric value
                 int numericValue = ascii_to_numeric(pressedKey);
 
                 // Update the operands based on the entered digits
+#if CALC_BCD_MODE
+                // Digits beyond BCD_MAX_DIGITS are ignored
+                bcd_append_digit((operator == '\0') ? &firstOperand : &secondOperand, numericValue);
+#else
                 if (operator == '\0') {
                     // If no operator is entered yet, update the first operand
                     firstOperand = (firstOperand * 10) + numericValue;
@@ -118,23 +357,85 @@ int main(void) {
                     // If an operator is entered, update the second operand
                     secondOperand = (secondOperand * 10) + numericValue;
                 }
+#endif
             } else if (pressedKey == '+' || pressedKey == '-' || pressedKey == '*' || pressedKey == '/') {
                 // If the pressed key is an operator (+, -, *, /), update the operator
                 operator = pressedKey;
             } else if (pressedKey == '=') {
                 // If the pressed key is '=', perform the calculation based on the operator
+#if CALC_BCD_MODE
                 switch (operator) {
                     case '+':
+                        PROF_ENTER(PROF_CALC_ADD);
+                        bcdState = bcd_add(&result, &firstOperand, &secondOperand);
+                        PROF_EXIT(PROF_CALC_ADD);
+                        break;
+                    case '-':
+                        PROF_ENTER(PROF_CALC_SUBTRACT);
+                        bcdState = bcd_subtract(&result, &firstOperand, &secondOperand);
+                        PROF_EXIT(PROF_CALC_SUBTRACT);
+                        break;
+                    case '*':
+                        PROF_ENTER(PROF_CALC_MULTIPLY);
+                        bcdState = bcd_multiply(&result, &firstOperand, &secondOperand);
+                        PROF_EXIT(PROF_CALC_MULTIPLY);
+                        break;
+                    case '/':
+                        PROF_ENTER(PROF_CALC_DIVIDE);
+                        bcdState = bcd_divide(&result, &firstOperand, &secondOperand);
+                        PROF_EXIT(PROF_CALC_DIVIDE);
+                        break;
+                    default:
+                        // Handle invalid operator
+                        bcdState = E_NOT_OK;
+                        break;
+                }
+                // Display the result digit by digit, or an error on overflow / division by zero
+                LCD_Clear(&lcd1);
+                echoLength = 0;
+                if (bcdState == E_OK) {
+                    // Results wider than the screen are already in DDRAM, scroll them into view
+                    if (bcd_display(&lcd1, &result) > screen.columns) {
+                        LCD_MarqueeStart(&lcd1, CALC_SCROLL_PERIOD);
+                        clearOnNextKey = 1;
+                    }
+                    // Keep it across power cycles; written in the background, from the loop if the EEPROM is busy.
+                    // A calculation still waiting from before goes first, so none is lost
+                    while (historyQueued && (HIST_Append(&historyEntry, sizeof(historyEntry)) != E_OK));
+                    historyEntry.firstOperand = firstOperand;
+                    historyEntry.secondOperand = secondOperand;
+                    historyEntry.result = result;
+                    historyEntry.operator = operator;
+                    historyQueued = (HIST_Append(&historyEntry, sizeof(historyEntry)) != E_OK);
+                } else {
+                    LCD_SendString_P(&lcd1, (const uint8_t *)PSTR("Error"));
+                }
+
+                // Reset the operands and operator for the next calculation
+                bcd_clear(&firstOperand);
+                bcd_clear(&secondOperand);
+                operator = '\0';
+#else
+                switch (operator) {
+                    case '+':
+                        PROF_ENTER(PROF_CALC_ADD);
                         result = add(firstOperand, secondOperand);
+                        PROF_EXIT(PROF_CALC_ADD);
                         break;
                     case '-':
+                        PROF_ENTER(PROF_CALC_SUBTRACT);
                         result = subtract(firstOperand, secondOperand);
+                        PROF_EXIT(PROF_CALC_SUBTRACT);
                         break;
                     case '*':
+                        PROF_ENTER(PROF_CALC_MULTIPLY);
                         result = multiply(firstOperand, secondOperand);
+                        PROF_EXIT(PROF_CALC_MULTIPLY);
                         break;
                     case '/':
+                        PROF_ENTER(PROF_CALC_DIVIDE);
                         result = divide(firstOperand, secondOperand);
+                        PROF_EXIT(PROF_CALC_DIVIDE);
                         break;
                     default:
                         // Handle invalid operator
@@ -143,12 +444,34 @@ int main(void) {
                 }
                 // Display the result on the LCD using the appropriate function
                 LCD_Clear(&lcd1);
+                echoLength = 0;
+#if CALC_BIG_DIGITS
+                // Whole results that fit are drawn with big digits through the frame buffer
+                if ((result > -1000) && (result < 10000) && (result == (s32)result) &&
+                    (LCD_BufferPutBigNumber((s32)result) == E_OK)) {
+                    LCD_Flush(&lcd1);
+                    clearOnNextKey = 1;
+                } else {
+                    LCD_SendNumber(&lcd1, result);
+                }
+#else
                 LCD_SendNumber(&lcd1, result); // Or LCD_SendIntegerNumber(&lcd1, result) for int result
+#endif
+
+                // Keep it across power cycles; written in the background, from the loop if the EEPROM is busy.
+                // A calculation still waiting from before goes first, so none is lost
+                while (historyQueued && (HIST_Append(&historyEntry, sizeof(historyEntry)) != E_OK));
+                historyEntry.firstOperand = firstOperand;
+                historyEntry.secondOperand = secondOperand;
+                historyEntry.result = result;
+                historyEntry.operator = operator;
+                historyQueued = (HIST_Append(&historyEntry, sizeof(historyEntry)) != E_OK);
 
                 // Reset the operands and operator for the next calculation
                 firstOperand = 0;
                 secondOperand = 0;
                 operator = '\0';
+#endif
             }
         }
     }
@@ -163,3 +486,18 @@ int ascii_to_numeric(char ascii_char) {
         return -1; // Return a suitable error value
     }
 }
+
+void dump_diagnostics(void) {
+#if PROF_ENABLE
+    // Profile of everything so far
+    PROF_DumpUart();
+#endif
+#if LAT_ENABLE
+    // Keypress-to-pixel latency of the presses so far
+    LAT_DumpUart();
+#endif
+    // SRAM headroom
+    MEM_DumpUart();
+    // Time from reset to ready for input
+    BOOT_DumpUart();
+}
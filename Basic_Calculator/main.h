@@ -3,6 +3,50 @@
 #ifndef MAIN_H_
 #define MAIN_H_
 
+/**
+ * @brief Select the arithmetic engine used by the calculator.
+ *
+ * - 0: int operands with a double result (about 9 significant digits).
+ * - 1: packed-BCD operands and results with BCD_MAX_DIGITS digits (see bcd_arithmetic.h).
+ */
+#ifndef CALC_BCD_MODE
+#define CALC_BCD_MODE           0
+#endif
+
+/**
+ * @brief Show whole results that fit on the screen with big two-row digits.
+ *
+ * Needs LCD_BIG_DIGITS set in CLCD_config.h. Other results use LCD_SendNumber.
+ * The segment glyphs share CGRAM with the animations; main.c loads them again
+ * when an animation stops.
+ */
+#ifndef CALC_BIG_DIGITS
+#define CALC_BIG_DIGITS         1
+#endif
+
+/**
+ * @brief Evaluate expressions sent over the UART next to the keypad (see calc_serial.h).
+ *
+ * The UART then carries requests and replies only, since a host reading
+ * replies would take other lines for answers: the diagnostics dumps (PROF,
+ * LAT, MEM, BOOT) are the reply to a '?' request instead of coming with the
+ * 'c' key, and the "RAM low" warning of the stack check goes to the second
+ * LCD row between two calculations.
+ */
+#ifndef CALC_SERIAL_SERVICE
+#define CALC_SERIAL_SERVICE     1
+#endif
+
+/**
+ * @brief Timer0 ticks (ms) between two marquee steps of a long result.
+ */
+#define CALC_SCROLL_PERIOD      400
+
+/**
+ * @brief Timer0 ticks (ms) the welcome screen stays up unless a key is pressed.
+ */
+#define CALC_SPLASH_MS          1000
+
 /**
  * @brief Convert ASCII character to numeric digit.
  *
@@ -11,6 +55,15 @@
  */
 int ascii_to_numeric(char ascii_char);
 
+/**
+ * @brief Send the diagnostics dumps to the UART, waiting for room.
+ *
+ * The profile (PROF_ENABLE), the keypress latency (LAT_ENABLE), the SRAM
+ * headroom and the boot times, one line each as their dump functions write
+ * them. Sent on the 'c' key, or as the reply to '?' with CALC_SERIAL_SERVICE.
+ */
+void dump_diagnostics(void);
+
 
 
 #endif /**< MAIN_H_ */
@@ -0,0 +1,148 @@
+/**
+ * Arabic_name: glyph uploads while the LCD writes right to left.
+ *
+ * ARABIC_DisplayString puts the controller in decrement entry mode and loads
+ * glyphs into CGRAM on demand. Runs the real CLCD, CGRAM and ARABIC modules on
+ * an HD44780 model and checks after every string that each slot holds the
+ * glyph the cache says it holds, and that every cell shows the right slot.
+ */
+#include "STD_TYPES.h"
+#include <stdio.h>
+#include <string.h>
+#include "../Arabic_name/DIO_interface.h"
+
+/*****************************< HD44780 model, 8-bit bus *****************************/
+static u8 Pins[4][8];
+static u8 Ddram[128];
+static u8 Cgram[64];
+static u8 Address;
+static u8 InCgram;
+static u8 Increment = 1;
+
+static void model_write(u8 value, u8 data)
+{
+    if (!data) {
+        if (value & 0x80) {
+            InCgram = 0;
+            Address = value & 0x7F;
+        } else if (value & 0x40) {
+            InCgram = 1;
+            Address = value & 0x3F;
+        } else if ((value & 0xFC) == 0x04) {
+            Increment = (value >> 1) & 1;
+        } else if (value == 0x01) {
+            memset(Ddram, ' ', sizeof(Ddram));
+            InCgram = 0;
+            Address = 0;
+            Increment = 1;
+        } else if ((value & 0xFE) == 0x02) {
+            InCgram = 0;
+            Address = 0;
+        }
+        return;
+    }
+
+    if (InCgram) {
+        Cgram[Address & 0x3F] = value;
+        Address = (Address + (Increment ? 1 : -1)) & 0x3F;
+    } else {
+        Ddram[Address & 0x7F] = value;
+        Address = (Address + (Increment ? 1 : -1)) & 0x7F;
+    }
+}
+
+Std_ReturnType DIO_SetPinDirection(u8 PortId, u8 PinId, u8 PinDirection)
+{
+    return E_OK;
+}
+
+Std_ReturnType DIO_SetPinValue(u8 PortId, u8 PinId, u8 PinValue)
+{
+    /**< The controller latches on the falling edge of E (port A pin 2) */
+    if ((PortId == DIO_PORTA) && (PinId == DIO_PIN2) && Pins[DIO_PORTA][DIO_PIN2] && !PinValue) {
+        u8 value = 0;
+
+        for (u8 i = 0; i < 8; i++) {
+            value |= Pins[DIO_PORTC][i] << i;
+        }
+        model_write(value, Pins[DIO_PORTA][DIO_PIN1]);
+    }
+    Pins[PortId][PinId] = PinValue;
+    return E_OK;
+}
+
+Std_ReturnType DIO_GetPinValue(u8 Copy_PortId, u8 Copy_PinId, u8 *Copy_ReturnedPinValue)
+{
+    *Copy_ReturnedPinValue = Pins[Copy_PortId][Copy_PinId];
+    return E_OK;
+}
+
+#include "../Arabic_name/CLCD_program.c"
+#include "../Arabic_name/CGRAM_program.c"
+#include "../Arabic_name/ARABIC_program.c"
+
+/*****************************< Checks *****************************/
+static int Failures = 0;
+
+static void check(const char *text, u8 row)
+{
+    memset(Ddram, ' ', sizeof(Ddram));
+    ARABIC_DisplayString(row, LCD_COLUMN_16, (const uint8_t *)text);
+
+    for (u8 slot = 0; slot < _CGRAM_SLOTS; slot++) {
+        uint8_t expected[8];
+
+        if (CGRAM_SlotGlyph[slot] == CGRAM_NO_GLYPH) {
+            continue;
+        }
+        ARABIC_GlyphLoader(CGRAM_SlotGlyph[slot], expected);
+        if (memcmp(&Cgram[slot * 8], expected, 8) != 0) {
+            printf("FAIL \"%s\": slot %u does not hold glyph %u\n", text, slot, CGRAM_SlotGlyph[slot]);
+            Failures++;
+        }
+    }
+
+    for (u8 column = 0; column < 16; column++) {
+        u8 cell = Ddram[(row ? 0x40 : 0x00) + column];
+
+        if ((cell < _CGRAM_SLOTS) && (CGRAM_SlotGlyph[cell] == CGRAM_NO_GLYPH)) {
+            printf("FAIL \"%s\": column %u shows empty slot %u\n", text, column, cell);
+            Failures++;
+        }
+    }
+    if (!Increment) {
+        printf("FAIL \"%s\": left in decrement entry mode\n", text);
+        Failures++;
+    }
+}
+
+int main(void)
+{
+    static const char *const texts[] = {
+        "سهيلة", "بيت", "مدرسة ١٢", "سلام عليكم", "abc 12", "كتب محمد", "سهيلة"
+    };
+    LCD_Config_t lcd;
+
+    lcd.mode = LCD_8BitMode;
+    for (u8 i = 0; i < 8; i++) {
+        lcd.dataPins[i].LCD_PortId = DIO_PORTC;
+        lcd.dataPins[i].LCD_PinId = i;
+    }
+    lcd.rsPin.LCD_PortId = DIO_PORTA;
+    lcd.rsPin.LCD_PinId = DIO_PIN1;
+    lcd.rwPin.LCD_PortId = DIO_PORTA;
+    lcd.rwPin.LCD_PinId = DIO_PIN0;
+    lcd.enablePin.LCD_PortId = DIO_PORTA;
+    lcd.enablePin.LCD_PinId = DIO_PIN2;
+
+    LCD_Init(&lcd);
+    ARABIC_Init(&lcd);
+    for (u8 round = 0; round < 2; round++) {
+        for (u8 i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+            check(texts[i], round);
+        }
+    }
+
+    printf("%s: %d failures\n", Failures ? "FAIL" : "ok", Failures);
+    return Failures != 0;
+}
@@ -0,0 +1,346 @@
+/**
+ * BCD engine against the int engine (bcd_arithmetic.h, arithmetic_operations.h).
+ *
+ * Checks that both engines agree on operands both can hold, then times each
+ * operator in both. Then checks the BCD engine alone at every width up to
+ * BCD_MAX_DIGITS against 128-bit integers, overflows included, and times each
+ * operator per digit count. Host nanoseconds only rank the engines; for AVR cycles
+ * build the firmware with -DPROF_ENABLE=1 once per CALC_BCD_MODE, work some
+ * operations on the keypad, send "?" over the UART and read the
+ * add/subtract/multiply/divide lines of the reply (PROF_CALC_* marks in
+ * main.c).
+ */
+#include "STD_TYPES.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef int LCD_Config_t;
+static void LCD_SendChar(const LCD_Config_t *config, u8 character) { (void)config; (void)character; }
+
+#include "arithmetic_operations.h"
+#include "bcd_arithmetic.h"
+
+#define OPERANDS    1000
+#define ROUNDS      200
+#define WIDE_CHECKS 20000        /**< Random full-width operations per operator */
+#define SWEEP_ROUNDS 20000       /**< Timed operations per operator and digit count */
+
+typedef __int128 Wide_t;         /**< Mantissa reference, in thousandths like BCD_Number_t */
+
+static int Operands[OPERANDS][2];
+static BCD_Number_t BcdOperands[OPERANDS][2];
+static volatile double Sink;
+
+static void to_bcd(BCD_Number_t *number, int value)
+{
+    char text[16];
+    char *digit = text;
+
+    bcd_clear(number);
+    snprintf(text, sizeof(text), "%d", abs(value));
+    while (*digit != '\0') {
+        bcd_append_digit(number, (u8)(*digit++ - '0'));
+    }
+    number->negative = (value < 0);
+}
+
+/**< Mantissa in thousandths, the value LCD_SendNumber and bcd_display show */
+static long long from_bcd(const BCD_Number_t *number)
+{
+    long long value = 0;
+
+    for (int i = BCD_MAX_DIGITS - 1; i >= 0; i--) {
+        value = value * 10 + bcd_get_digit(number->digits, (u8)i);
+    }
+    return number->negative ? -value : value;
+}
+
+static Std_ReturnType bcd_run(char operator, BCD_Number_t *result, const BCD_Number_t *num1, const BCD_Number_t *num2);
+
+/**< Exact mantissa of a BCD number, sign included */
+static Wide_t wide_from_bcd(const BCD_Number_t *number)
+{
+    Wide_t value = 0;
+
+    for (int i = BCD_MAX_DIGITS - 1; i >= 0; i--) {
+        value = value * 10 + bcd_get_digit(number->digits, (u8)i);
+    }
+    return number->negative ? -value : value;
+}
+
+static void wide_to_bcd(BCD_Number_t *number, Wide_t value)
+{
+    bcd_clear(number);
+    number->negative = (value < 0);
+    if (value < 0) {
+        value = -value;
+    }
+    for (u8 i = 0; i < BCD_MAX_DIGITS; i++) {
+        number->digits[i >> 1] |= (u8)((value % 10) << ((i & 1) ? 4 : 0));
+        value /= 10;
+    }
+}
+
+static const char *wide_text(Wide_t value, char *text)
+{
+    char digits[48];
+    int length = 0;
+    int negative = (value < 0);
+
+    do {
+        int digit = (int)(value % 10);
+        digits[length++] = (char)('0' + (digit < 0 ? -digit : digit));
+        value /= 10;
+    } while (value != 0);
+    *text = '-';
+    for (int i = 0; i < length; i++) {
+        text[negative + i] = digits[length - 1 - i];
+    }
+    text[negative + length] = '\0';
+    return text;
+}
+
+/**< Random mantissa of exactly the given number of digits, random sign */
+static Wide_t wide_random(int digits)
+{
+    Wide_t value = 1 + rand() % 9;
+
+    for (int i = 1; i < digits; i++) {
+        value = value * 10 + rand() % 10;
+    }
+    return (rand() & 1) ? -value : value;
+}
+
+static Wide_t wide_power10(int exponent)
+{
+    Wide_t value = 1;
+
+    while (exponent-- > 0) {
+        value *= 10;
+    }
+    return value;
+}
+
+/**
+ * Runs one BCD operation and compares it with the 128-bit result: E_NOT_OK
+ * exactly when the magnitude needs more than BCD_MAX_DIGITS, else the same
+ * mantissa. Returns 1 on a mismatch.
+ */
+static int wide_check(char operator, Wide_t num1, Wide_t num2)
+{
+    static const Wide_t fraction = 1000;    /**< 10^BCD_FRACTION_DIGITS */
+    BCD_Number_t bcd1;
+    BCD_Number_t bcd2;
+    BCD_Number_t result;
+    Std_ReturnType status;
+    Wide_t expected;
+    int overflow;
+    char text[3][50];
+
+    wide_to_bcd(&bcd1, num1);
+    wide_to_bcd(&bcd2, num2);
+    switch (operator) {
+        case '+': expected = num1 + num2; break;
+        case '-': expected = num1 - num2; break;
+        case '*': expected = num1 * num2 / fraction; break;
+        default:  expected = (num2 != 0) ? num1 * fraction / num2 : 0; break;
+    }
+    overflow = ((operator == '/') && (num2 == 0)) ||
+               (expected >= wide_power10(BCD_MAX_DIGITS)) || (expected <= -wide_power10(BCD_MAX_DIGITS));
+
+    status = bcd_run(operator, &result, &bcd1, &bcd2);
+    if (overflow ? (status != E_NOT_OK) :
+                   ((status != E_OK) || (wide_from_bcd(&result) != expected) || (result.negative && (expected == 0)))) {
+        printf("FAIL %s %c %s (thousandths): BCD %s, expected %s\n", wide_text(num1, text[0]), operator,
+               wide_text(num2, text[1]), (status == E_OK) ? wide_text(wide_from_bcd(&result), text[2]) : "E_NOT_OK",
+               overflow ? "E_NOT_OK" : wide_text(expected, text[2]));
+        return 1;
+    }
+    return 0;
+}
+
+/**< Called through pointers so neither engine is inlined into the timing loop */
+static Std_ReturnType (*volatile const BcdOperations[4])(BCD_Number_t *, const BCD_Number_t *, const BCD_Number_t *) = {
+    bcd_add, bcd_subtract, bcd_multiply, bcd_divide
+};
+
+static double int_add(int num1, int num2) { return add(num1, num2); }
+static double int_subtract(int num1, int num2) { return subtract(num1, num2); }
+static double int_multiply(int num1, int num2) { return multiply(num1, num2); }
+
+static double (*volatile const IntOperations[4])(int, int) = {
+    int_add, int_subtract, int_multiply, divide
+};
+
+static Std_ReturnType bcd_run(char operator, BCD_Number_t *result, const BCD_Number_t *num1, const BCD_Number_t *num2)
+{
+    switch (operator) {
+        case '+': return bcd_add(result, num1, num2);
+        case '-': return bcd_subtract(result, num1, num2);
+        case '*': return bcd_multiply(result, num1, num2);
+        default:  return bcd_divide(result, num1, num2);
+    }
+}
+
+static double int_run(char operator, int num1, int num2)
+{
+    switch (operator) {
+        case '+': return add(num1, num2);
+        case '-': return subtract(num1, num2);
+        case '*': return multiply(num1, num2);
+        default:  return divide(num1, num2);
+    }
+}
+
+static double now_ns(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * 1e9 + time.tv_nsec;
+}
+
+int main(void)
+{
+    static const char operators[] = "+-*/";
+    int failures = 0;
+
+    srand(1);
+    for (int i = 0; i < OPERANDS; i++) {
+        /**< Within a 16-bit AVR int, products included */
+        Operands[i][0] = rand() % 361 - 180;
+        Operands[i][1] = rand() % 361 - 180;
+        if (Operands[i][1] == 0) {
+            Operands[i][1] = 1;
+        }
+        to_bcd(&BcdOperands[i][0], Operands[i][0]);
+        to_bcd(&BcdOperands[i][1], Operands[i][1]);
+    }
+
+    for (int o = 0; o < 4; o++) {
+        char operator = operators[o];
+
+        for (int i = 0; i < OPERANDS; i++) {
+            BCD_Number_t result;
+            long long expected;
+            long long actual;
+
+            if (bcd_run(operator, &result, &BcdOperands[i][0], &BcdOperands[i][1]) != E_OK) {
+                printf("FAIL %d %c %d: BCD error\n", Operands[i][0], operator, Operands[i][1]);
+                failures++;
+                continue;
+            }
+            /**< Both engines truncate to three decimals */
+            expected = (long long)(int_run(operator, Operands[i][0], Operands[i][1]) * 1000.0);
+            if (operator == '/') {
+                expected = (long long)Operands[i][0] * 1000 / Operands[i][1];
+            }
+            actual = from_bcd(&result);
+            if (actual != expected) {
+                printf("FAIL %d %c %d: BCD %lld, int %lld (thousandths)\n",
+                       Operands[i][0], operator, Operands[i][1], actual, expected);
+                failures++;
+            }
+        }
+    }
+
+    printf("%-9s %10s %10s %7s\n", "operator", "int ns", "BCD ns", "ratio");
+    for (int o = 0; o < 4; o++) {
+        char operator = operators[o];
+        BCD_Number_t result;
+        double start;
+        double intNs;
+        double bcdNs;
+
+        start = now_ns();
+        for (int r = 0; r < ROUNDS; r++) {
+            for (int i = 0; i < OPERANDS; i++) {
+                Sink = IntOperations[o](Operands[i][0], Operands[i][1]);
+            }
+        }
+        intNs = (now_ns() - start) / (ROUNDS * OPERANDS);
+
+        start = now_ns();
+        for (int r = 0; r < ROUNDS; r++) {
+            for (int i = 0; i < OPERANDS; i++) {
+                BcdOperations[o](&result, &BcdOperands[i][0], &BcdOperands[i][1]);
+                Sink = result.digits[0];
+            }
+        }
+        bcdNs = (now_ns() - start) / (ROUNDS * OPERANDS);
+
+        printf("%-9c %10.1f %10.1f %6.1fx\n", operator, intNs, bcdNs, bcdNs / intNs);
+    }
+
+    /**< Every width up to BCD_MAX_DIGITS: products and quotients that still fit, and the ones that do not */
+    for (int o = 0; o < 4; o++) {
+        for (int i = 0; i < WIDE_CHECKS; i++) {
+            int digits1 = 1 + rand() % BCD_MAX_DIGITS;
+            int digits2 = 1 + rand() % BCD_MAX_DIGITS;
+
+            if ((operators[o] == '*') && (digits1 + digits2 > 38)) {
+                digits2 = 38 - digits1;    /**< Keeps the reference product inside 128 bits */
+            }
+            failures += wide_check(operators[o], wide_random(digits1), wide_random(digits2));
+        }
+    }
+    {
+        Wide_t largest = wide_power10(BCD_MAX_DIGITS) - 1;
+        BCD_Number_t typed;
+        int before = failures;
+
+        /**< Full-width edges: the largest number, one past it, and division by zero */
+        failures += wide_check('+', largest - 1, 1);
+        failures += wide_check('+', largest, 1);
+        failures += wide_check('-', -largest, 1);
+        failures += wide_check('*', largest, 1000);
+        failures += wide_check('*', largest, 1001);
+        failures += wide_check('*', wide_power10(13) + 1, wide_power10(14) - 1);
+        failures += wide_check('/', largest, 1000);
+        failures += wide_check('/', largest, 999);
+        failures += wide_check('/', largest, largest);
+        failures += wide_check('/', 1, largest);
+        failures += wide_check('/', largest, 0);
+
+        /**< The keypad stops at BCD_MAX_DIGITS - BCD_FRACTION_DIGITS integer digits */
+        bcd_clear(&typed);
+        for (int i = 0; i < BCD_MAX_DIGITS - BCD_FRACTION_DIGITS; i++) {
+            failures += (bcd_append_digit(&typed, 9) != E_OK);
+        }
+        failures += (bcd_append_digit(&typed, 9) != E_NOT_OK);
+        failures += (wide_from_bcd(&typed) != (wide_power10(BCD_MAX_DIGITS - BCD_FRACTION_DIGITS) - 1) * 1000);
+        if (failures != before) {
+            printf("FAIL full-width edges\n");
+        }
+    }
+
+    /**< Cost per operation for both operands of the same digit count */
+    printf("\n%-6s %9s %9s %9s %9s   (BCD ns per operation)\n", "digits", "+", "-", "*", "/");
+    for (int digits = 1; digits <= BCD_MAX_DIGITS; digits++) {
+        static BCD_Number_t sweep[OPERANDS][2];
+
+        for (int i = 0; i < OPERANDS; i++) {
+            wide_to_bcd(&sweep[i][0], wide_random(digits));
+            wide_to_bcd(&sweep[i][1], wide_random(digits));
+        }
+        printf("%-6d", digits);
+        for (int o = 0; o < 4; o++) {
+            BCD_Number_t result;
+            double start = now_ns();
+
+            for (int r = 0; r < SWEEP_ROUNDS; r++) {
+                int i = r % OPERANDS;
+
+                BcdOperations[o](&result, &sweep[i][0], &sweep[i][1]);
+                Sink = result.digits[0];
+            }
+            printf(" %9.1f", (now_ns() - start) / SWEEP_ROUNDS);
+        }
+        printf("\n");
+    }
+
+    printf("%s: %d mismatches in %d operations\n", failures ? "FAIL" : "ok", failures,
+           4 * (OPERANDS + WIDE_CHECKS) + 11);
+    return failures != 0;
+}
@@ -0,0 +1,101 @@
+/**
+ * Serial evaluation service on the int engine (calc_serial.h).
+ *
+ * Feeds requests through a stand-in UART and checks the replies, in
+ * particular that results outside the 16-bit int of the keypad engine come
+ * back as ERR instead of wrapping around, and that '?' is answered with the
+ * diagnostics lines and an "end" line.
+ */
+#include "STD_TYPES.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef int LCD_Config_t;
+static void LCD_SendChar(const LCD_Config_t *config, u8 character) { (void)config; (void)character; }
+
+#include "main.h"
+#include "arithmetic_operations.h"
+
+/*****************************< UART *****************************/
+static const char *Input;
+static char Output[64];
+static u8 OutputLength;
+
+u8 UART_Write(const u8 *data, u8 length)
+{
+    memcpy(&Output[OutputLength], data, length);
+    OutputLength += length;
+    return length;
+}
+
+Std_ReturnType UART_ReadByte(u8 *data)
+{
+    if (*Input == '\0') {
+        return E_NOT_OK;
+    }
+    *data = (u8)*Input++;
+    return E_OK;
+}
+
+#include "calc_serial.h"
+
+static void diagnostics(void)
+{
+    UART_Write((const u8 *)"mem 1 2\nboot 3\n", 15);
+}
+
+/*****************************< Checks *****************************/
+static int Failures = 0;
+
+static void check(const char *request, const char *reply)
+{
+    char line[32];
+    char expected[32];
+
+    snprintf(line, sizeof(line), "%s\n", request);
+    snprintf(expected, sizeof(expected), "%s\n", reply);
+    Input = line;
+    OutputLength = 0;
+    calc_serial_poll();  /**< Parses the request */
+    calc_serial_poll();  /**< Hands the reply to the UART */
+    Output[OutputLength] = '\0';
+    if (strcmp(Output, expected) != 0) {
+        printf("FAIL %s: got \"%s\", expected \"%s\"\n", request, Output, reply);
+        Failures++;
+    }
+}
+
+int main(void)
+{
+    calc_serial_init();
+
+    check("12*-7", "-84.000");
+    check("7/2", "3.500");
+    check("181*181", "32761.000");
+    check("-32767-1", "-32768.000");
+    check("32767+0", "32767.000");
+
+    /**< Beyond the 16-bit int: ERR rather than the wrapped value */
+    check("300*300", "ERR");
+    check("182*181", "ERR");
+    check("32767+1", "ERR");
+    check("-32767-2", "ERR");
+    check("-300*300", "ERR");
+    check("32768+0", "ERR");
+    check("1/0", "ERR");
+    check("1+", "ERR");
+
+    /**< Diagnostics only once a dump is set, and only as the whole request */
+    check("?", "ERR");
+    calc_serial_set_diagnostics(diagnostics);
+    check("?", "mem 1 2\nboot 3\nend");
+    check(" ? ", "mem 1 2\nboot 3\nend");
+    check("??", "ERR");
+    check("?1", "ERR");
+    check("1?", "ERR");
+    check("-?", "ERR");
+    check("2*3", "6.000");
+
+    printf("%s: %d failures\n", Failures ? "FAIL" : "ok", Failures);
+    return Failures != 0;
+}
@@ -0,0 +1,149 @@
+/**
+ * Accuracy sweep and timing of the Q16.16 functions in arithmetic_operations.h.
+ *
+ * Every function is compared with the host libm over its range and checked
+ * against the bound its documentation states; the worst error found is
+ * printed next to the bound. Host nanoseconds per call follow; on the AVR
+ * time the same calls with PROF_ENTER/PROF_EXIT.
+ */
+#include "STD_TYPES.h"
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include "arithmetic_operations.h"
+
+static int Failures = 0;
+static volatile fixed_t Sink;
+
+static double to_double(fixed_t value)
+{
+    return value / 65536.0;
+}
+
+static void report(const char *name, double worst, double at, double bound)
+{
+    int failed = !(worst <= bound);
+
+    printf("%-28s worst %.3g at %.6f, bound %.3g%s\n", name, worst, at, bound, failed ? "  FAIL" : "");
+    Failures += failed;
+}
+
+static void sweep_sin_cos(const char *name, long long from, long long to, long long step, double bound)
+{
+    double worst = 0;
+    double at = 0;
+
+    for (long long x = from; x <= to; x += step) {
+        double angle = to_double((fixed_t)x);
+        double sinError = fabs(to_double(fixed_sin((fixed_t)x)) - sin(angle));
+        double cosError = fabs(to_double(fixed_cos((fixed_t)x)) - cos(angle));
+
+        if (sinError > worst) {
+            worst = sinError;
+            at = angle;
+        }
+        if (cosError > worst) {
+            worst = cosError;
+            at = angle;
+        }
+    }
+    report(name, worst, at, bound);
+}
+
+static double now_ns(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * 1e9 + time.tv_nsec;
+}
+
+/**< Arguments step through [from, to] and wrap around, so none takes an early exit */
+static void time_function(const char *name, fixed_t (*volatile function)(fixed_t), fixed_t from, fixed_t to, fixed_t step)
+{
+    const long calls = 2000000;
+    double start = now_ns();
+    fixed_t x = from;
+
+    for (long i = 0; i < calls; i++) {
+        Sink = function(x);
+        x = (x > to - step) ? from : (x + step);
+    }
+    printf("%-10s %6.1f ns/call\n", name, (now_ns() - start) / calls);
+}
+
+int main(void)
+{
+    double worst = 0;
+    double worstSmall = 0;
+    double at = 0;
+    double atSmall = 0;
+
+    /**< sqrt: rounded to nearest, 1 LSB */
+    for (long long x = 0; x <= 0x7FFFFFFFLL; x += (x < 0x100000) ? 1 : 613) {
+        double error = fabs(to_double(fixed_sqrt((fixed_t)x)) - sqrt(to_double((fixed_t)x))) * 65536.0;
+
+        if (error > worst) {
+            worst = error;
+            at = to_double((fixed_t)x);
+        }
+    }
+    report("sqrt (LSB)", worst, at, 1.0);
+    if ((fixed_sqrt(-1) != FIXED_ERROR) || (fixed_sqrt(FIXED_ONE) != FIXED_ONE)) {
+        printf("sqrt edge cases  FAIL\n");
+        Failures++;
+    }
+
+    /**< sin and cos: every angle of one turn, then up to 100 rad, then samples of the whole range */
+    sweep_sin_cos("sin/cos |x| <= 2 pi", -411775, 411775, 1, 1e-4);
+    sweep_sin_cos("sin/cos |x| <= 100", -6553600, 6553600, 1, 1e-4);
+    sweep_sin_cos("sin/cos whole range", -0x7FFFFFFFLL, 0x7FFFFFFFLL, 4099, 1e-4);
+
+    /**< log: every value below 2, then samples */
+    worst = 0;
+    for (long long x = 1; x <= 0x7FFFFFFFLL; x += (x < 0x20000) ? 1 : (x / 20000 + 1)) {
+        double error = fabs(to_double(fixed_log((fixed_t)x)) - log(to_double((fixed_t)x)));
+
+        if (error > worst) {
+            worst = error;
+            at = to_double((fixed_t)x);
+        }
+    }
+    report("log", worst, at, 1e-4);
+    if ((fixed_log(0) != FIXED_ERROR) || (fixed_log(-FIXED_ONE) != FIXED_ERROR)) {
+        printf("log edge cases  FAIL\n");
+        Failures++;
+    }
+
+    /**< exp: relative error for results >= 1, absolute below */
+    worst = 0;
+    for (long long x = -17 * FIXED_LN2; x <= FIXED_EXP_MAX_INPUT; x++) {
+        double exact = exp(to_double((fixed_t)x));
+        double error = fabs(to_double(fixed_exp((fixed_t)x)) - exact);
+
+        if (exact >= 1.0) {
+            if (error / exact > worst) {
+                worst = error / exact;
+                at = to_double((fixed_t)x);
+            }
+        } else if (error * 65536.0 > worstSmall) {
+            worstSmall = error * 65536.0;
+            atSmall = to_double((fixed_t)x);
+        }
+    }
+    report("exp relative, results >= 1", worst, at, 5e-5);
+    report("exp LSB, results < 1", worstSmall, atSmall, 3.0);
+    if ((fixed_exp(FIXED_EXP_MAX_INPUT + 1) != FIXED_MAX) || (fixed_exp(-FIXED_FROM_INT(20)) != 0)) {
+        printf("exp edge cases  FAIL\n");
+        Failures++;
+    }
+
+    time_function("sqrt", fixed_sqrt, 0, FIXED_MAX, 977);
+    time_function("sin", fixed_sin, -FIXED_FROM_INT(100), FIXED_FROM_INT(100), 97);
+    time_function("cos", fixed_cos, -FIXED_FROM_INT(100), FIXED_FROM_INT(100), 97);
+    time_function("log", fixed_log, 1, FIXED_MAX, 977);
+    time_function("exp", fixed_exp, -FIXED_FROM_INT(11), FIXED_EXP_MAX_INPUT, 7);
+
+    printf("%s\n", Failures ? "FAIL" : "ok");
+    return Failures != 0;
+}
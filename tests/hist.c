@@ -0,0 +1,178 @@
+/**
+ * EEPROM calculation history (HIST_program.c).
+ *
+ * Runs the log on a RAM copy of the EEPROM and checks that HIST_Init finds
+ * the newest record and the entry count after every number of appends over
+ * three passes of the ring: an empty log, before and after the wrap-around,
+ * a write cut by a power loss in the slot after the head (slot 0 included,
+ * once the log has wrapped) and the 16-bit sequence number rolling over.
+ * Also checks that HIST_Append refuses an entry while the previous one is
+ * still being written.
+ */
+#include "STD_TYPES.h"
+#include <stdio.h>
+#include <string.h>
+
+#include "EEPROM_interface.h"
+#include "HIST_interface.h"
+#include "HIST_config.h"
+#include "HIST_private.h"
+
+static u8 SimSreg = 0x80;
+#undef HIST_SREG_R
+#define HIST_SREG_R         SimSreg
+
+/**< __asm__ __volatile__ ("cli" ::: "memory") becomes a write of the interrupt enable */
+#define __asm__
+#define __volatile__(...)   (SimSreg &= (u8)~0x80)
+
+/*****************************< EEPROM in RAM *****************************/
+static u8 Eeprom[EEPROM_SIZE];
+static EEPROM_Request_t *Writing;   /**< Submitted write, NULL when idle */
+
+Std_ReturnType EEPROM_Read(u16 address, u8 *data, u8 length)
+{
+    memcpy(data, &Eeprom[address], length);
+    return E_OK;
+}
+
+Std_ReturnType EEPROM_Submit(EEPROM_Request_t *request)
+{
+    if (Writing != NULL) {
+        return E_NOT_OK;
+    }
+    request->result = EEPROM_PENDING;
+    Writing = request;
+    return E_OK;
+}
+
+/**< Programs the first bytes of the submitted write; all of them ends it as the interrupt would */
+static void eeprom_program(u8 bytes)
+{
+    EEPROM_Request_t *request = Writing;
+
+    if (bytes >= request->length) {
+        memcpy(&Eeprom[request->address], request->data, request->length);
+        Writing = NULL;
+        request->result = EEPROM_DONE;
+        request->callback(request);
+    } else {
+        /**< Power lost: the rest of the slot keeps its old bytes and the driver starts over */
+        memcpy(&Eeprom[request->address], request->data, bytes);
+        Writing = NULL;
+        request->result = EEPROM_DONE;
+    }
+}
+
+#include "HIST_program.c"
+
+/*****************************< Checks *****************************/
+static int Failures = 0;
+
+static void expect(int condition, const char *what, int appends, int cut)
+{
+    if (!condition) {
+        printf("FAIL %s after %d appends%s\n", what, appends, cut ? " and a cut write" : "");
+        Failures++;
+    }
+}
+
+/**
+ * An entry: its number, little endian, and the low byte once more. Its first
+ * and last bytes then differ from those of a blank slot or of the entry
+ * HIST_SLOTS before, so a write cut at any byte leaves a broken record.
+ */
+#define ENTRY_SIZE          3
+
+static Std_ReturnType submit(u16 value)
+{
+    u8 entry[ENTRY_SIZE] = {(u8)value, (u8)(value >> 8), (u8)value};
+
+    return HIST_Append(entry, sizeof(entry));
+}
+
+static void append(u16 value)
+{
+    if (submit(value) == E_OK) {
+        eeprom_program(0xFF);
+    }
+}
+
+/**< The log holds values first .. last, newest last */
+static void check_log(u16 first, u16 last, int appends, int cut)
+{
+    u8 entry[ENTRY_SIZE];
+    u8 count = (u8)(last - first + 1);
+
+    expect(HIST_Count() == count, "entry count", appends, cut);
+    for (u8 age = 0; age < count; age++) {
+        expect((HIST_Get(age, entry, sizeof(entry)) == sizeof(entry)) &&
+               ((entry[0] | (entry[1] << 8)) == (u16)(last - age)), "entry value", appends, cut);
+    }
+    expect(HIST_Get(count, entry, sizeof(entry)) == 0, "nothing past the oldest entry", appends, cut);
+}
+
+int main(void)
+{
+    static const u8 cuts[] = {1, 2, 3, _HIST_PAYLOAD, _HIST_PAYLOAD + ENTRY_SIZE - 1};
+    u8 entry[ENTRY_SIZE];
+
+    /**< Blank EEPROM */
+    memset(Eeprom, 0xFF, sizeof(Eeprom));
+    HIST_Init();
+    expect((HIST_Count() == 0) && (HIST_Get(0, entry, sizeof(entry)) == 0), "empty log", 0, 0);
+
+    /**< Every head position over three passes, each followed by a power loss in the next write */
+    for (int appends = 0; appends <= 3 * HIST_SLOTS; appends++) {
+        for (u8 c = 0; c < sizeof(cuts); c++) {
+            u16 first = (appends > HIST_SLOTS) ? (u16)(appends - HIST_SLOTS) : 0;
+
+            memset(Eeprom, 0xFF, sizeof(Eeprom));
+            HIST_Init();
+            for (int i = 0; i < appends; i++) {
+                append((u16)i);
+            }
+            HIST_Init();
+            if (appends > 0) {
+                check_log(first, (u16)(appends - 1), appends, 0);
+            }
+
+            expect(submit((u16)appends) == E_OK, "append", appends, 0);
+            eeprom_program(cuts[c]);
+            HIST_Init();
+            if (appends >= HIST_SLOTS) {
+                /**< The cut slot held the oldest entry */
+                check_log((u16)(first + 1), (u16)(appends - 1), appends, 1);
+            } else if (appends > 0) {
+                check_log(0, (u16)(appends - 1), appends, 1);
+            } else {
+                expect(HIST_Count() == 0, "empty log", appends, 1);
+            }
+
+            /**< The log goes on from there */
+            append((u16)appends);
+            HIST_Init();
+            check_log((appends >= HIST_SLOTS) ? (u16)(first + 1) : 0, (u16)appends, appends + 1, 1);
+        }
+    }
+
+    /**< Sequence numbers roll over from 0xFFFF to 0 */
+    memset(Eeprom, 0xFF, sizeof(Eeprom));
+    HIST_Init();
+    HIST_NextSeq = 0xFFF9;
+    for (u16 i = 0; i < HIST_SLOTS + 3; i++) {
+        append(i);
+    }
+    HIST_Init();
+    check_log(3, HIST_SLOTS + 2, HIST_SLOTS + 3, 0);
+
+    /**< One record at a time: the next entry waits for the write before it */
+    expect(submit(1) == E_OK, "append", 0, 0);
+    expect(submit(2) == E_NOT_OK, "append while writing", 0, 0);
+    eeprom_program(0xFF);
+    expect(submit(2) == E_OK, "append once the write is done", 0, 0);
+    eeprom_program(0xFF);
+
+    printf("%s: %d failures\n", Failures ? "FAIL" : "ok", Failures);
+    return Failures != 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * CLCD over the PCF8574 I2C backpack.
+ *
+ * Builds the driver for LCD_TRANSPORT_PCF8574 on the TWI model, decodes the
+ * expander outputs back into HD44780 nibbles and bytes, and checks the text
+ * that reaches DDRAM. Then checks that a backpack which does not acknowledge
+ * its address, or a queued TWI transaction holding the bus, makes the writes
+ * fail instead of disappearing or interleaving, and that a background script
+ * waits out its full delay at a tick rate other than 1 kHz. Prints the I2C bytes each
+ * character costs with the SCL time they take.
+ */
+#include "STD_TYPES.h"
+#include <stdio.h>
+#include <string.h>
+#include "twi_model.h"
+
+#include "CLCD_config.h"
+#undef LCD_TRANSPORT
+#define LCD_TRANSPORT       LCD_TRANSPORT_PCF8574
+#include "CLCD_interface.h"
+#include "CLCD_private.h"
+#undef _LCD_SREG_R
+#define _LCD_SREG_R         SimSreg
+#include "TMR0_config.h"
+#undef TMR0_TICK_HZ
+#define TMR0_TICK_HZ        4000UL   /**< Script delays must not assume a 1 ms tick */
+
+#define ENABLE_BIT          2    /**< Expander output of the enable line */
+
+/*****************************< HD44780 behind the expander *****************************/
+static u8 Ddram[128];
+static u8 Address;
+static u8 FourBit;
+static u8 HighNibble = 0xFF;     /**< First nibble of a 4-bit transfer, 0xFF when none */
+static u8 Port;
+
+static void hd44780_byte(u8 value, u8 data)
+{
+    if (data) {
+        Ddram[Address & 0x7F] = value;
+        Address = (Address + 1) & 0x7F;
+    } else if (value & 0x80) {
+        Address = value & 0x7F;
+    } else if ((value & 0xE0) == 0x20) {
+        FourBit = !(value & 0x10);
+    } else if (value == 0x01) {
+        memset(Ddram, ' ', sizeof(Ddram));
+        Address = 0;
+    } else if ((value & 0xFE) == 0x02) {
+        Address = 0;
+    }
+}
+
+static void pcf8574_write(u8 value)
+{
+    /**< The controller latches on the falling edge of E, D0-D3 are not wired */
+    if (((Port >> ENABLE_BIT) & 1) && !((value >> ENABLE_BIT) & 1) && !((Port >> LCD_EXPANDER_RW_BIT) & 1)) {
+        u8 data = (Port >> LCD_EXPANDER_RS_BIT) & 1;
+
+        if (!FourBit) {
+            hd44780_byte(Port & 0xF0, data);
+        } else if (HighNibble == 0xFF) {
+            HighNibble = Port & 0xF0;
+        } else {
+            hd44780_byte(HighNibble | (Port >> 4), data);
+            HighNibble = 0xFF;
+        }
+    }
+    Port = value;
+}
+
+/*****************************< Hardware below the driver *****************************/
+Std_ReturnType DIO_SetPinDirection(u8 PortId, u8 PinId, u8 PinDirection)
+{
+    return E_OK;
+}
+
+Std_ReturnType DIO_SetPinValue(u8 PortId, u8 PinId, u8 PinValue)
+{
+    return E_OK;
+}
+
+Std_ReturnType DIO_GetPinValue(u8 Copy_PortId, u8 Copy_PinId, u8 *Copy_ReturnedPinValue)
+{
+    *Copy_ReturnedPinValue = 0;
+    return E_OK;
+}
+
+static u32 Ticks;
+
+u32 TMR0_GetTicks(void)
+{
+    return Ticks;
+}
+
+#include "CLCD_program.c"
+
+/*****************************< Checks *****************************/
+static int Failures = 0;
+
+static void expect(int condition, const char *what)
+{
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        Failures++;
+    }
+}
+
+int main(void)
+{
+    static LCD_Bus_t bus;
+    LCD_Config_t lcd = {&bus, {{0, ENABLE_BIT}}, 1};
+    static u8 inputs;
+    static TWI_Transaction_t query = {0x27, NULL, 0, &inputs, 1, NULL, TWI_PENDING};
+    static const uint8_t script[] = {LCD_SCRIPT_DELAY_MS, 5, LCD_SCRIPT_DATA(1), 'w', LCD_SCRIPT_END};
+    u8 waited;
+    u16 bytes;
+
+    TwiModel.slaveWrite = pcf8574_write;
+    bus.mode = LCD_4BitMode;
+    bus.address = TwiModel.slaveAddress;
+    LCD_BusInit(&bus);
+    LCD_Init(&lcd);
+    expect(FourBit, "LCD_Init leaves the controller in 4-bit mode");
+
+    LCD_GoToXYPos(&lcd, 2, 1);
+    expect(LCD_SendString(&lcd, (const uint8_t *)"Hello") == E_OK, "LCD_SendString succeeds");
+    expect(memcmp(&Ddram[0x42], "Hello", 5) == 0, "the text lands at column 2 of row 1");
+
+    /**< One transaction for the string, four bytes per character */
+    bytes = TwiModel.bytes;
+    LCD_SendString(&lcd, (const uint8_t *)"0123456789ABCDEF");
+    bytes = TwiModel.bytes - bytes;
+    printf("16-character string: %u I2C bytes, %.2f per character\n", bytes, bytes / 16.0);
+    printf("SCL time per character: %.0f us at 100 kHz, %.1f us at 400 kHz\n",
+           bytes * 9 / 16.0 * 10.0, bytes * 9 / 16.0 * 2.5);
+    bytes = TwiModel.bytes;
+    LCD_SendChar(&lcd, 'x');
+    printf("LCD_SendChar on its own: %u I2C bytes\n", TwiModel.bytes - bytes);
+
+    /**< No backpack at the address: the writes report it and leave nothing open */
+    TwiModel.slavePresent = 0;
+    bytes = TwiModel.bytes;
+    Address = 0;
+    expect(LCD_SendChar(&lcd, 'y') == E_NOT_OK, "LCD_SendChar fails when the address is not acknowledged");
+    expect(LCD_SendString(&lcd, (const uint8_t *)"lost") == E_NOT_OK, "LCD_SendString fails too");
+    expect(TwiModel.bytes - bytes == 2, "only the two address bytes went out");
+    expect(TwiModel.state == TWI_MODEL_IDLE, "the transaction was stopped");
+    expect(bus.owner == NULL, "the bus was released");
+    expect(bus.batchDepth == 0, "no batch was left open");
+
+    TwiModel.slavePresent = 1;
+
+    /**< A queued transaction on the bus: the start is refused and nothing interleaves with it */
+    expect(TWI_Submit(&query) == E_OK, "a read of the backpack is queued");
+    expect(LCD_SendChar(&lcd, 'y') == E_NOT_OK, "LCD_SendChar fails while the queue runs");
+    expect((bus.owner == NULL) && (bus.batchDepth == 0), "and leaves the bus free");
+    twi_model_interrupts();
+    expect(query.result == TWI_DONE, "the queued read completes");
+
+    LCD_GoToXYPos(&lcd, 0, 0);
+    expect(LCD_SendChar(&lcd, 'z') == E_OK, "writes work again once the backpack answers");
+    expect(Ddram[0x00] == 'z', "and reach the display");
+    /**< 5 ms are 20 ticks of 250 us; the wait may begin just before a tick, so it ends after 21 */
+    LCD_ScriptStart(&lcd, script);
+    LCD_ScriptUpdate();
+    for (waited = 0; (Ddram[0x01] != 'w') && (waited < 40); waited++) {
+        Ticks++;
+        LCD_ScriptUpdate();
+    }
+    expect(waited == 21, "the script delay lasts its milliseconds plus one tick");
+    expect(!LCD_ScriptIsRunning(), "and the script then runs to its end");
+
+    expect(TwiModel.errors == 0, "no I2C protocol errors");
+
+    printf("%s: %d failures\n", Failures ? "FAIL" : "ok", Failures);
+    return Failures != 0;
+}
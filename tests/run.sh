@@ -0,0 +1,29 @@
+#!/bin/sh
+# Host tests and benchmarks for the firmware modules that do not need the board.
+#
+# Every tests/*.c is a standalone program: it includes the module under test
+# from Basic_Calculator/, replaces the hardware below it, and exits non-zero on
+# a failure. Built with the host gcc against the stand-ins in tests/stub/.
+#
+# usage: tests/run.sh [test ...]      (default: every test)
+
+cd "$(dirname "$0")" || exit 1
+BUILD=${BUILD:-/tmp/calc-tests}
+mkdir -p "$BUILD" || exit 1
+
+if [ $# -eq 0 ]; then
+    set -- *.c
+fi
+
+status=0
+for source in "$@"; do
+    name=$(basename "$source" .c)
+    echo "== $name"
+    if ! gcc -std=gnu99 -O2 -Wall -Wno-unused-function -Wno-attributes -funsigned-char -DF_CPU=16000000UL \
+            -Istub -I../Basic_Calculator -o "$BUILD/$name" "$name.c" -lm; then
+        status=1
+        continue
+    fi
+    "$BUILD/$name" || status=1
+done
+exit $status
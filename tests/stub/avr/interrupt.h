@@ -0,0 +1,10 @@
+/**
+ * Host stand-in for avr-libc's <avr/interrupt.h>: tests call the handlers directly.
+ */
+#ifndef STUB_INTERRUPT_H_
+#define STUB_INTERRUPT_H_
+
+#define sei()
+#define cli()
+
+#endif /**< STUB_INTERRUPT_H_ */
@@ -0,0 +1,18 @@
+/**
+ * Host stand-in for avr-libc's <avr/pgmspace.h>: flash is ordinary memory.
+ */
+#ifndef STUB_PGMSPACE_H_
+#define STUB_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s)                 ((const char *)(s))
+#define pgm_read_byte(p)        (*(const uint8_t *)(p))
+#define pgm_read_word(p)        (*(const uint16_t *)(p))
+#define pgm_read_dword(p)       (*(const uint32_t *)(p))
+#define pgm_read_ptr(p)         (*(void *const *)(p))
+#define memcpy_P                memcpy
+
+#endif /**< STUB_PGMSPACE_H_ */
@@ -0,0 +1,10 @@
+/**
+ * Host stand-in for avr-libc's <util/delay.h>: busy waits take no time.
+ */
+#ifndef STUB_DELAY_H_
+#define STUB_DELAY_H_
+
+static inline void _delay_ms(double ms) { (void)ms; }
+static inline void _delay_us(double us) { (void)us; }
+
+#endif /**< STUB_DELAY_H_ */
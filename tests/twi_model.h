@@ -0,0 +1,160 @@
+/**
+ * Software model of the ATmega32 TWI master and of one I2C slave on its bus.
+ *
+ * Include it after STD_TYPES.h and the system headers: it builds the real
+ * TWI_program.c against model registers. The model reacts to every TWCR
+ * job the driver starts, answers with the status codes of the datasheet and
+ * hands the bytes to the slave callbacks. It also counts protocol errors:
+ * a job with no start condition before it, or a polled job on the bus in the
+ * middle of a transaction the interrupt driver owns (and the other way round).
+ *
+ * The queued driver runs when the test calls twi_model_interrupts().
+ */
+#ifndef TWI_MODEL_H_
+#define TWI_MODEL_H_
+
+#include "TWI_interface.h"
+#include "TWI_config.h"
+#include "TWI_private.h"
+
+/*****************************< Registers *****************************/
+static u8 SimSreg = 0x80;           /**< Status register, bit 7 is the global interrupt enable */
+static u8 TwiTwbr, TwiTwsr, TwiTwdr;
+static u8 TwiTwcr;                  /**< TWCR as the hardware holds it */
+static u8 TwiTwcrPort;              /**< Byte the driver reads and writes TWCR through */
+static u8 TwiTwcrShown;             /**< Value TwiTwcrPort held when handed out */
+
+static volatile u8 *twi_model_twcr(void);
+
+#undef TWI_TWBR_R
+#undef TWI_TWSR_R
+#undef TWI_TWDR_R
+#undef TWI_TWCR_R
+#undef TWI_SREG_R
+#define TWI_TWBR_R          TwiTwbr
+#define TWI_TWSR_R          TwiTwsr
+#define TWI_TWDR_R          TwiTwdr
+#define TWI_TWCR_R          (*twi_model_twcr())
+#define TWI_SREG_R          SimSreg
+
+/**< __asm__ __volatile__ ("cli" ::: "memory") becomes a write of the interrupt enable */
+#define __asm__
+#define __volatile__(...)   (SimSreg &= (u8)~0x80)
+
+/*****************************< Bus and slave *****************************/
+typedef enum {
+    TWI_MODEL_IDLE = 0,  /**< Stop sent, or nothing yet */
+    TWI_MODEL_STARTED,   /**< Start sent, the address is next */
+    TWI_MODEL_TRANSMIT,  /**< Slave addressed for writing */
+    TWI_MODEL_RECEIVE,   /**< Slave addressed for reading */
+    TWI_MODEL_NACKED     /**< Address not acknowledged, only a stop or start may follow */
+} TwiModelState_t;
+
+static struct {
+    TwiModelState_t state;
+    u8 queued;                 /**< 1 if the interrupt driver started the current transaction */
+    u8 slaveAddress;           /**< 7-bit address the slave answers to */
+    u8 slavePresent;           /**< 0: nobody acknowledges */
+    void (*slaveWrite)(u8 data);
+    u8 (*slaveRead)(void);
+    u16 starts;                /**< Start and repeated start conditions */
+    u16 stops;
+    u16 bytes;                 /**< Bytes on the bus, addresses included */
+    u16 errors;                /**< Protocol errors, see the top of the file */
+} TwiModel = {TWI_MODEL_IDLE, 0, 0x27, 1, NULL, NULL, 0, 0, 0, 0};
+
+#define TWI_MODEL_TWWC      3    /**< Write collision flag: read only, the driver never writes it */
+
+static void twi_model_job(u8 control)
+{
+    u8 Local_Queued = (control >> _TWI_TWIE) & 1;
+    u8 Local_Status = 0;
+
+    if (!((control >> _TWI_TWINT) & 1)) {
+        /**< Writing TWINT as 0 starts nothing */
+        TwiTwcr = (TwiTwcr & (1 << _TWI_TWINT)) | control;
+        return;
+    }
+    TwiTwcr = control & (u8)~((1 << _TWI_TWINT) | (1 << _TWI_TWSTA) | (1 << _TWI_TWSTO));
+
+    if ((control >> _TWI_TWSTO) & 1) {
+        if (TwiModel.state != TWI_MODEL_IDLE) {
+            TwiModel.stops++;
+        }
+        TwiModel.state = TWI_MODEL_IDLE;
+        if (!((control >> _TWI_TWSTA) & 1)) {
+            return;  /**< TWINT stays low after a stop */
+        }
+    }
+
+    if ((control >> _TWI_TWSTA) & 1) {
+        if (TwiModel.state == TWI_MODEL_IDLE) {
+            Local_Status = _TWI_START;
+        } else {
+            Local_Status = _TWI_REP_START;
+            TwiModel.errors += (Local_Queued != TwiModel.queued);
+        }
+        TwiModel.queued = Local_Queued;
+        TwiModel.state = TWI_MODEL_STARTED;
+        TwiModel.starts++;
+    } else {
+        if ((TwiModel.state == TWI_MODEL_IDLE) || (TwiModel.state == TWI_MODEL_NACKED) ||
+            (Local_Queued != TwiModel.queued)) {
+            TwiModel.errors++;
+            return;  /**< The job never completes, the driver times out */
+        }
+        TwiModel.bytes++;
+        switch (TwiModel.state) {
+            case TWI_MODEL_STARTED:
+                if (TwiModel.slavePresent && ((TwiTwdr >> 1) == TwiModel.slaveAddress)) {
+                    TwiModel.state = (TwiTwdr & 1) ? TWI_MODEL_RECEIVE : TWI_MODEL_TRANSMIT;
+                    Local_Status = (TwiTwdr & 1) ? _TWI_MR_SLA_ACK : _TWI_MT_SLA_ACK;
+                } else {
+                    TwiModel.state = TWI_MODEL_NACKED;
+                    Local_Status = (TwiTwdr & 1) ? _TWI_MR_SLA_NACK : _TWI_MT_SLA_NACK;
+                }
+                break;
+            case TWI_MODEL_TRANSMIT:
+                if (TwiModel.slaveWrite != NULL) {
+                    TwiModel.slaveWrite(TwiTwdr);
+                }
+                Local_Status = _TWI_MT_DATA_ACK;
+                break;
+            default:
+                TwiTwdr = (TwiModel.slaveRead != NULL) ? TwiModel.slaveRead() : 0xFF;
+                Local_Status = ((control >> _TWI_TWEA) & 1) ? _TWI_MR_DATA_ACK : _TWI_MR_DATA_NACK;
+                break;
+        }
+    }
+
+    TwiTwsr = Local_Status | (TwiTwsr & (u8)~_TWI_STATUS_MASK);
+    TwiTwcr |= 1 << _TWI_TWINT;
+}
+
+/**< Every access first carries out the write of the previous one, if there was a write */
+static volatile u8 *twi_model_twcr(void)
+{
+    if (TwiTwcrPort != TwiTwcrShown) {
+        twi_model_job(TwiTwcrPort);
+    }
+    TwiTwcrPort = TwiTwcr | (1 << TWI_MODEL_TWWC);
+    TwiTwcrShown = TwiTwcrPort;
+
+    return &TwiTwcrPort;
+}
+
+#include "TWI_program.c"
+
+/**< Runs the TWI interrupt for as long as it is enabled and pending */
+static void twi_model_interrupts(void)
+{
+    for (;;) {
+        (void)*twi_model_twcr();
+        if (!(SimSreg & 0x80) || !((TwiTwcr >> _TWI_TWIE) & 1) || !((TwiTwcr >> _TWI_TWINT) & 1)) {
+            return;
+        }
+        __vector_19();
+    }
+}
+
+#endif /**< TWI_MODEL_H_ */
@@ -0,0 +1,105 @@
+/**
+ * TWI: polled transfers next to the interrupt-driven queue.
+ *
+ * Runs the real driver on the TWI model. The polled byte functions must not
+ * touch the bus outside a polled transfer, in particular while a queued
+ * transaction is on it, and the two kinds of transfer must take turns.
+ */
+#include "STD_TYPES.h"
+#include <stdio.h>
+#include <string.h>
+#include "twi_model.h"
+
+static u8 Received[32];
+static u8 ReceivedCount;
+static u8 NextRead = 0xA0;
+
+static void slave_write(u8 data)
+{
+    if (ReceivedCount < sizeof(Received)) {
+        Received[ReceivedCount] = data;
+    }
+    ReceivedCount++;
+}
+
+static u8 slave_read(void)
+{
+    return NextRead++;
+}
+
+/*****************************< Checks *****************************/
+static int Failures = 0;
+
+static void expect(int condition, const char *what)
+{
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        Failures++;
+    }
+}
+
+int main(void)
+{
+    static const u8 polled[3] = {0x11, 0x22, 0x33};
+    static const u8 queued[2] = {0x44, 0x55};
+    static u8 readBack[2];
+    static TWI_Transaction_t write = {0x27, queued, 2, NULL, 0, NULL, TWI_PENDING};
+    static TWI_Transaction_t read = {0x27, NULL, 0, readBack, 2, NULL, TWI_PENDING};
+    u8 value = 0;
+    u16 bytes;
+
+    TwiModel.slaveWrite = slave_write;
+    TwiModel.slaveRead = slave_read;
+    TWI_Init();
+
+    /**< Polled write and read */
+    expect(TWI_Write(0x27, polled, 3) == E_OK, "TWI_Write succeeds");
+    expect((ReceivedCount == 3) && (memcmp(Received, polled, 3) == 0), "the slave got the three bytes");
+    expect((TWI_Start() == E_OK) && (TWI_SendAddress(0x27, TWI_READ) == E_OK) &&
+           (TWI_ReadByte(&value, 0) == E_OK) && (value == 0xA0), "a polled read returns the slave byte");
+    TWI_Stop();
+    expect(SimSreg == 0x80, "TWI_Start and TWI_Stop give interrupts back");
+
+    /**< Byte functions without a start */
+    bytes = TwiModel.bytes;
+    expect(TWI_SendAddress(0x27, TWI_WRITE) == E_NOT_OK, "TWI_SendAddress fails without a start");
+    expect(TWI_WriteByte(0x99) == E_NOT_OK, "TWI_WriteByte fails without a start");
+    expect(TWI_ReadByte(&value, 0) == E_NOT_OK, "TWI_ReadByte fails without a start");
+    expect(TwiModel.bytes == bytes, "and nothing went on the bus");
+
+    /**< A queued transaction owns the bus: the polled calls are refused and stay off it */
+    ReceivedCount = 0;
+    expect(TWI_Submit(&write) == E_OK, "TWI_Submit queues a write");
+    expect(TWI_Start() == E_NOT_OK, "TWI_Start is refused while the queue runs");
+    expect(TWI_SendAddress(0x27, TWI_WRITE) == E_NOT_OK, "TWI_SendAddress after the refused start fails");
+    expect(TWI_WriteByte(0x99) == E_NOT_OK, "TWI_WriteByte after the refused start fails");
+    TWI_Stop();
+    twi_model_interrupts();
+    expect(write.result == TWI_DONE, "the queued write completes");
+    expect((ReceivedCount == 2) && (memcmp(Received, queued, 2) == 0), "with only its own bytes");
+
+    /**< A transaction submitted during a polled transfer waits for its stop */
+    ReceivedCount = 0;
+    expect((TWI_Start() == E_OK) && (TWI_SendAddress(0x27, TWI_WRITE) == E_OK), "a polled transfer begins");
+    expect(TWI_Submit(&read) == E_OK, "TWI_Submit queues a read meanwhile");
+    twi_model_interrupts();
+    expect(read.result == TWI_PENDING, "the read waits");
+    expect(TWI_WriteByte(0x66) == E_OK, "the polled transfer carries on");
+    TWI_Stop();
+    twi_model_interrupts();
+    expect((ReceivedCount == 1) && (Received[0] == 0x66), "the polled byte went out");
+    expect((read.result == TWI_DONE) && (readBack[0] == 0xA1) && (readBack[1] == 0xA2), "then the read ran");
+    expect(!TWI_IsBusy(), "the queue is empty");
+
+    /**< Interrupts stay off when TWI_Start was called with them off */
+    SimSreg = 0x00;
+    TWI_Start();
+    expect(SimSreg == 0x00, "TWI_Start restores the interrupt flag it found");
+    TWI_Stop();
+    SimSreg = 0x80;
+
+    expect(TwiModel.errors == 0, "no I2C protocol errors");
+    printf("%u starts, %u stops, %u bytes\n", TwiModel.starts, TwiModel.stops, TwiModel.bytes);
+    printf("%s: %d failures\n", Failures ? "FAIL" : "ok", Failures);
+    return Failures != 0;
+}
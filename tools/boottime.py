@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""Boot-time reader for the calculator firmware (BOOT_interface.h).
+
+Sends the '?' diagnostics request of the expression service (calc_serial.h),
+waits for the "boot" and "ready" lines of the reply and prints when each point
+of the boot was reached. Nothing is sent unasked, so start this once the board
+is up. On a build with CALC_SERIAL_SERVICE 0 the firmware ignores the request:
+press 'c' on the board instead, which sends the same lines.
+
+The times are microseconds since Timer0 started, early in main; the C startup
+before it is not included. Exits with 1 when the time to ready, the later of
+the keypad and the LCD being ready, is over BOOT_READY_BUDGET_MS.
+"""
+
+import argparse
+import os
+import select
+import sys
+import time
+
+from calcload import open_port
+
+PHASES = ("timer started", "lcd started", "keypad ready", "services ready", "lcd ready", "splash shown")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter,
+                                     epilog="\n".join(__doc__.splitlines()[2:]))
+    parser.add_argument("port", help="serial device or simulator pty")
+    parser.add_argument("--baud", type=int, default=9600, help="UART_BAUD of the firmware")
+    parser.add_argument("--timeout", type=float, default=30.0,
+                        help="seconds to wait for the boot report")
+    args = parser.parse_args()
+
+    fd = open_port(args.port, args.baud)
+    os.write(fd, b"?\n")
+    received, lines = bytearray(), {}
+    deadline = time.monotonic() + args.timeout
+
+    while "ready" not in lines:
+        remaining = deadline - time.monotonic()
+        if remaining <= 0:
+            sys.exit(f"no boot report within {args.timeout} s (without CALC_SERIAL_SERVICE, press 'c')")
+        ready, _, _ = select.select([fd], [], [], remaining)
+        if ready:
+            received += os.read(fd, 256)
+        while b"\n" in received:
+            line, _, rest = bytes(received).partition(b"\n")
+            received = bytearray(rest)
+            words = line.decode("ascii", "replace").split()
+            if words and words[0] == "boot":
+                lines = {"boot": [int(word) for word in words[1:]]}
+            elif words and words[0] == "ready" and "boot" in lines:
+                lines["ready"] = [int(word) for word in words[1:]]
+    os.close(fd)
+
+    for name, microseconds in zip(PHASES, lines["boot"]):
+        print(f"{name:16} {microseconds / 1000:8.2f} ms")
+    to_ready, budget = lines["ready"]
+    print(f"ready for input  {to_ready / 1000:8.2f} ms (budget {budget / 1000:.0f} ms)")
+    sys.exit(1 if to_ready > budget else 0)
+
+
+if __name__ == "__main__":
+    main()
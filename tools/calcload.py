@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""Load generator for the calculator's serial evaluation service (calc_serial.h).
+
+Streams random expressions to the firmware over a serial device, keeping up to
+--window requests in flight so the firmware parses the next request while it
+still sends the previous reply, and checks every reply against the exact result.
+
+The device is anything that carries the UART: a USB-serial adapter wired to the
+board, or the pseudo-terminal an AVR simulator attaches to the USART (for
+example simavr's uart_pty, which prints the /dev/pts path it creates). Baud rate
+and framing must match UART_BAUD and CALC_SERIAL_FRAMING of the firmware.
+
+Reported:
+
+  expressions/s         replies received per second of wall time
+  latency               time from the request's last byte leaving the host to
+                        its reply's last byte arriving, as p50, p90, p99 and max
+  overflows             requests whose result is beyond --max-result, which the
+                        firmware must answer with "ERR"
+  errors                "ERR" replies to requests that have a result
+  mismatches            results more than --tolerance away from the exact value
+                        (the firmware shows three truncated decimals, and in the
+                        int engine divides in single-precision float), and
+                        overflows answered with a number
+"""
+
+import argparse
+import os
+import random
+import select
+import sys
+import termios
+import time
+import tty
+from fractions import Fraction
+
+BAUD_RATES = {rate: getattr(termios, f"B{rate}") for rate in
+              (2400, 4800, 9600, 19200, 38400, 57600, 115200) if hasattr(termios, f"B{rate}")}
+OPERATORS = "+-*/"
+
+
+def cobs_encode(payload):
+    encoded, block = bytearray(), bytearray()
+    for byte in payload:
+        if byte == 0:
+            encoded += bytes([len(block) + 1]) + block
+            block = bytearray()
+            continue
+        block.append(byte)
+        if len(block) == 254:
+            encoded += bytes([255]) + block
+            block = bytearray()
+    return bytes(encoded + bytes([len(block) + 1]) + block + b"\x00")
+
+
+def cobs_decode(frame):
+    decoded, position = bytearray(), 0
+    while position < len(frame):
+        code = frame[position]
+        if code == 0 or position + code > len(frame) + (code == 1):
+            raise ValueError(f"malformed COBS frame {frame!r}")
+        decoded += frame[position + 1:position + code]
+        position += code
+        if code != 255 and position < len(frame):
+            decoded.append(0)
+    return bytes(decoded)
+
+
+def open_port(path, baud):
+    if baud not in BAUD_RATES:
+        sys.exit(f"unsupported baud rate {baud}, use one of {sorted(BAUD_RATES)}")
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+    tty.setraw(fd)
+    attributes = termios.tcgetattr(fd)
+    attributes[4] = attributes[5] = BAUD_RATES[baud]
+    termios.tcsetattr(fd, termios.TCSANOW, attributes)
+    termios.tcflush(fd, termios.TCIOFLUSH)
+    return fd
+
+
+def make_expression(rng, limit):
+    first = rng.randint(-limit, limit)
+    second = rng.randint(-limit, limit)
+    operator = rng.choice(OPERATORS)
+    if operator == "/" and second == 0:
+        second = 1
+    if operator == "+":
+        exact = Fraction(first + second)
+    elif operator == "-":
+        exact = Fraction(first - second)
+    elif operator == "*":
+        exact = Fraction(first * second)
+    else:
+        exact = Fraction(first, second)
+    return f"{first}{operator}{second}", exact
+
+
+def percentile(values, fraction):
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(fraction * len(ordered)))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter,
+                                     epilog="\n".join(__doc__.splitlines()[2:]))
+    parser.add_argument("port", help="serial device or simulator pty")
+    parser.add_argument("--baud", type=int, default=9600, help="UART_BAUD of the firmware")
+    parser.add_argument("--framing", choices=("newline", "cobs"), default="newline",
+                        help="CALC_SERIAL_FRAMING of the firmware")
+    parser.add_argument("--count", type=int, default=1000, help="expressions to send")
+    parser.add_argument("--window", type=int, default=4,
+                        help="requests in flight (1 waits for every reply)")
+    parser.add_argument("--limit", type=int, default=32767,
+                        help="operands are drawn from -limit to limit")
+    parser.add_argument("--max-result", type=int, default=32767,
+                        help="largest result magnitude the engine holds, beyond it the reply "
+                             "must be ERR (32767 for the int engine, 10**(BCD_MAX_DIGITS - "
+                             "BCD_FRACTION_DIGITS) - 1 for the BCD engine)")
+    parser.add_argument("--tolerance", type=float, default=0.002)
+    parser.add_argument("--timeout", type=float, default=2.0,
+                        help="seconds without a reply before giving up")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    delimiter = b"\x00" if args.framing == "cobs" else b"\n"
+    fd = open_port(args.port, args.baud)
+
+    in_flight = []          # (expression, exact, time its last byte was written)
+    latencies, overflows, errors, mismatches = [], 0, 0, 0
+    received, sent = bytearray(), 0
+    start = last_progress = time.monotonic()
+
+    while len(latencies) < args.count:
+        while sent < args.count and len(in_flight) < args.window:
+            expression, exact = make_expression(rng, args.limit)
+            payload = expression.encode()
+            frame = cobs_encode(payload) if args.framing == "cobs" else payload + delimiter
+            view = memoryview(frame)
+            while view:
+                select.select([], [fd], [])
+                view = view[os.write(fd, view):]
+            termios.tcdrain(fd)
+            in_flight.append((expression, exact, time.monotonic()))
+            sent += 1
+
+        ready, _, _ = select.select([fd], [], [], 0.05)
+        now = time.monotonic()
+        if ready:
+            received += os.read(fd, 256)
+        elif now - last_progress > args.timeout:
+            sys.exit(f"no reply for {args.timeout} s after {len(latencies)} of {args.count}, "
+                     f"{len(in_flight)} in flight (is the firmware running and the framing right?)")
+
+        while delimiter in received:
+            frame, _, rest = bytes(received).partition(delimiter)
+            received = bytearray(rest)
+            if not in_flight:
+                sys.exit(f"unexpected reply {frame!r}")
+            expression, exact, sent_at = in_flight.pop(0)
+            latencies.append(now - sent_at)
+            last_progress = now
+            reply = (cobs_decode(frame) if args.framing == "cobs" else frame).decode("ascii", "replace")
+            if abs(exact) > args.max_result:
+                overflows += 1
+                if reply != "ERR":
+                    mismatches += 1
+                    print(f"{expression} = {reply}, expected ERR", file=sys.stderr)
+            elif reply == "ERR":
+                errors += 1
+                print(f"{expression} = ERR", file=sys.stderr)
+            else:
+                try:
+                    value = float(reply)
+                except ValueError:
+                    value = None
+                if value is None or abs(value - float(exact)) > args.tolerance:
+                    mismatches += 1
+                    print(f"{expression} = {reply}, expected {float(exact):.3f}", file=sys.stderr)
+
+    elapsed = time.monotonic() - start
+    os.close(fd)
+
+    milliseconds = [latency * 1000 for latency in latencies]
+    print(f"{len(latencies)} expressions in {elapsed:.2f} s: {len(latencies) / elapsed:.1f} expressions/s "
+          f"(window {args.window}, {args.framing} framing, {args.baud} baud)")
+    print(f"latency ms: p50 {percentile(milliseconds, 0.50):.2f}  p90 {percentile(milliseconds, 0.90):.2f}  "
+          f"p99 {percentile(milliseconds, 0.99):.2f}  max {max(milliseconds):.2f}")
+    print(f"overflows {overflows}, errors {errors}, mismatches {mismatches}")
+    sys.exit(1 if errors or mismatches else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,433 @@
+#!/usr/bin/env python3
+"""Compiles 5x8 LCD glyphs from fonts or bitmap images into a C header.
+
+Inputs (by file extension):
+
+  .txt                  ASCII-art font. Lines starting with ";" are comments,
+                        "glyph <label>" starts a glyph and the next 8 non-empty
+                        lines are its rows, 5 characters each, "#" for a set
+                        pixel and "." for a clear one.
+  .bdf                  BDF bitmap font. Glyphs are placed in the 5x8 cell from
+                        FONT_ASCENT/FONT_DESCENT and their BBX. Encodings in
+                        Arabic Presentation Forms-B (U+FE80 to U+FEF4) become
+                        the contextual forms of their base letters, other
+                        glyphs carry no shaping metadata.
+  .pbm .pgm .ppm        Netpbm image holding a sheet of glyph cells, read left
+                        to right and top to bottom (convert JPEG or PNG scans
+                        with any image tool first). Dark pixels are set. Cell
+                        labels come from --labels, one label per line.
+
+A label is "<name> [: <metadata>]" where the metadata tokens are a code point
+("U+0628"), the shaping forms the glyph serves ("isolated", "final", "initial",
+"medial") and "advance=<pixels>". The advance defaults to the glyph's ink width
+(or DWIDTH for BDF fonts). Glyph IDs follow input order.
+
+Outputs:
+
+  --format packed       (default) one byte array decoded by CGRAM_UnpackGlyph:
+                          byte 0   number of glyphs
+                          byte 1   flags, bit 0 set when glyphs carry a row mask
+                          index    (masked only) one little-endian u16 per block
+                                   of 8 glyphs, the offset of the block's first
+                                   glyph from the start of the array
+                          glyphs   back to back
+                        Each glyph is its 5-bit rows packed MSB first into a bit
+                        stream padded to a whole byte. Unmasked glyphs hold all
+                        8 rows (40 bits). Masked glyphs start with a byte whose
+                        bit r is set when row r is not blank, followed by the
+                        non-blank rows only.
+  --format custom       a CustomChar_t array for LCD_DefineCustomChar_P, with
+                        charIndex cycling through the 8 CGRAM slots.
+  --letters SYMBOL      also emit the shaping table: for every code point from
+                        the lowest to the highest one in the metadata, its
+                        joining class and the glyph IDs of its isolated, final,
+                        initial and medial forms. Missing forms fall back to
+                        isolated (final, initial) and final (medial). A letter
+                        with an initial or medial form joins on both sides, one
+                        with a final form joins to the right only.
+"""
+
+import argparse
+import os
+import sys
+
+ROWS = 8
+COLUMNS = 5
+BLOCK = 8
+FLAG_MASKED = 0x01
+NO_GLYPH = 255
+FORMS = ("isolated", "final", "initial", "medial")
+
+# Arabic Presentation Forms-B: base letter and number of forms, from U+FE80 on.
+PRESENTATION_FORMS = (
+    [(0x0621, 1)] + [(cp, 2) for cp in range(0x0622, 0x0626)] + [(0x0626, 4), (0x0627, 2),
+    (0x0628, 4), (0x0629, 2)] + [(cp, 4) for cp in range(0x062A, 0x062F)] +
+    [(cp, 2) for cp in range(0x062F, 0x0633)] + [(cp, 4) for cp in range(0x0633, 0x063B)] +
+    [(cp, 4) for cp in range(0x0641, 0x0648)] + [(0x0648, 2), (0x0649, 2), (0x064A, 4)]
+)
+
+
+class Glyph:
+    def __init__(self, label, rows, advance=None):
+        self.rows = rows
+        self.code_point = None
+        self.forms = []
+        self.advance = advance
+        name, _, metadata = label.partition(":")
+        self.name = name.strip()
+        for token in metadata.split():
+            if token.upper().startswith("U+"):
+                self.code_point = int(token[2:], 16)
+            elif token in FORMS:
+                self.forms.append(token)
+            elif token.startswith("advance="):
+                self.advance = int(token[8:])
+            else:
+                sys.exit(f"glyph '{self.name}': unknown metadata '{token}'")
+        if self.forms and self.code_point is None:
+            sys.exit(f"glyph '{self.name}': shaping forms need a code point")
+        if self.advance is None:
+            ink = 0
+            for row in rows:
+                ink |= row
+            self.advance = ink.bit_length() - (ink & -ink).bit_length() + 1 if ink else 0
+
+
+def parse_text(path):
+    glyphs = []
+    rows = None
+    with open(path, encoding="utf-8") as source:
+        for number, line in enumerate(source, 1):
+            line = line.rstrip()
+            if not line or line.startswith(";"):
+                continue
+            if line.startswith("glyph"):
+                label, rows = line[5:].strip(), []
+                glyphs.append((label, rows))
+                continue
+            if rows is None or len(rows) == ROWS:
+                sys.exit(f"{path}:{number}: row outside of a glyph")
+            if len(line) != COLUMNS or set(line) - set("#."):
+                sys.exit(f"{path}:{number}: expected {COLUMNS} of '#' or '.'")
+            row = 0
+            for pixel in line:
+                row = (row << 1) | (pixel == "#")
+            rows.append(row)
+    for label, rows in glyphs:
+        if len(rows) != ROWS:
+            sys.exit(f"{path}: glyph '{label}' has {len(rows)} rows")
+    return [Glyph(label, rows) for label, rows in glyphs]
+
+
+def parse_bdf(path):
+    ascent = descent = None
+    glyphs = []
+    with open(path, encoding="latin-1") as source:
+        lines = iter(source.read().splitlines())
+    for line in lines:
+        words = line.split()
+        if not words:
+            continue
+        if words[0] == "FONT_ASCENT":
+            ascent = int(words[1])
+        elif words[0] == "FONT_DESCENT":
+            descent = int(words[1])
+        elif words[0] == "STARTCHAR":
+            name, encoding, advance, bbx, bitmap = " ".join(words[1:]), -1, None, None, []
+            for line in lines:
+                words = line.split() or [""]
+                if words[0] == "ENCODING":
+                    encoding = int(words[1])
+                elif words[0] == "DWIDTH":
+                    advance = int(words[1])
+                elif words[0] == "BBX":
+                    bbx = [int(word) for word in words[1:5]]
+                elif words[0] == "BITMAP":
+                    for line in lines:
+                        if line.strip() == "ENDCHAR":
+                            break
+                        bitmap.append(int(line, 16))
+                    break
+            if encoding >= 0 and bbx is not None:
+                glyphs.append((name, encoding, advance, bbx, bitmap))
+    if ascent is None or descent is None or ascent + descent > ROWS:
+        sys.exit(f"{path}: FONT_ASCENT + FONT_DESCENT must fit in {ROWS} rows")
+
+    forms = {}
+    code = 0xFE80
+    for base, count in PRESENTATION_FORMS:
+        for form in range(count):
+            forms[code] = (base, FORMS[form])
+            code += 1
+
+    result = []
+    for name, encoding, advance, (width, height, x_offset, y_offset), bitmap in glyphs:
+        rows = [0] * ROWS
+        bytes_per_row = (width + 7) // 8
+        for index, bits in enumerate(bitmap):
+            y = y_offset + height - 1 - index      # 0 is the row on the baseline
+            row = ascent - 1 - y
+            for x in range(width):
+                if bits >> (bytes_per_row * 8 - 1 - x) & 1:
+                    column = x_offset + x
+                    if not (0 <= row < ROWS and 0 <= column < COLUMNS):
+                        sys.exit(f"{path}: glyph '{name}' does not fit in the 5x8 cell")
+                    rows[row] |= 1 << (COLUMNS - 1 - column)
+        if encoding in forms:
+            base, form = forms[encoding]
+            name = f"{name} : U+{base:04X} {form}"
+        result.append(Glyph(name, rows, advance))
+    return result
+
+
+def parse_netpbm(path, labels, cell, scale):
+    with open(path, "rb") as source:
+        data = source.read()
+    fields, position = [], 0
+    while len(fields) < (3 if data[:2] in (b"P1", b"P4") else 4):
+        while data[position:position + 1].isspace():
+            position += 1
+        if data[position:position + 1] == b"#":
+            position = data.index(b"\n", position)
+            continue
+        start = position
+        while not data[position:position + 1].isspace():
+            position += 1
+        fields.append(data[start:position].decode())
+    kind, width, height = fields[0], int(fields[1]), int(fields[2])
+    maximum = int(fields[3]) if len(fields) > 3 else 1
+    position += 1
+    channels = 3 if kind in ("P3", "P6") else 1
+
+    if kind in ("P1", "P2", "P3"):
+        values = [int(value) for value in data[position:].split()]
+        if kind == "P1" and len(values) < width * height:
+            values = [int(bit) for bit in data[position:].decode() if bit in "01"]
+    elif kind == "P4":
+        stride = (width + 7) // 8
+        values = [data[position + y * stride + x // 8] >> (7 - x % 8) & 1
+                  for y in range(height) for x in range(width)]
+    elif kind in ("P5", "P6"):
+        size = 2 if maximum > 255 else 1
+        values = [int.from_bytes(data[position + i * size:position + (i + 1) * size], "big")
+                  for i in range(width * height * channels)]
+    else:
+        sys.exit(f"{path}: unsupported netpbm type {kind}")
+
+    def dark(x, y):
+        index = (y * width + x) * channels
+        level = sum(values[index:index + channels]) / channels
+        return level == 1 if kind in ("P1", "P4") else level < maximum / 2
+
+    cell_width, cell_height = cell
+    glyphs = []
+    for top in range(0, height - cell_height * scale + 1, cell_height * scale):
+        for left in range(0, width - cell_width * scale + 1, cell_width * scale):
+            rows = []
+            for row in range(ROWS):
+                bits = 0
+                for column in range(COLUMNS):
+                    x = left + column * scale + scale // 2
+                    y = top + row * scale + scale // 2
+                    bits = (bits << 1) | dark(x, y)
+                rows.append(bits)
+            glyphs.append(rows)
+
+    if labels:
+        if len(labels) > len(glyphs):
+            sys.exit(f"{path}: {len(labels)} labels for {len(glyphs)} cells")
+        glyphs = glyphs[:len(labels)]
+    else:
+        while glyphs and not any(glyphs[-1]):
+            glyphs.pop()                       # trailing empty cells of the sheet
+        labels = [f"cell {index}" for index in range(len(glyphs))]
+    return [Glyph(label, rows) for label, rows in zip(labels, glyphs)]
+
+
+def pack_rows(rows):
+    bits = 0
+    for row in rows:
+        bits = (bits << COLUMNS) | row
+    length = (len(rows) * COLUMNS + 7) // 8
+    bits <<= length * 8 - len(rows) * COLUMNS
+    return list(bits.to_bytes(length, "big")) if length else []
+
+
+def pack_glyph(rows, masked):
+    if not masked:
+        return pack_rows(rows)
+    mask = 0
+    for index, row in enumerate(rows):
+        if row:
+            mask |= 1 << index
+    return [mask] + pack_rows([row for row in rows if row])
+
+
+def compile_font(glyphs, masked):
+    records = [pack_glyph(glyph.rows, masked) for glyph in glyphs]
+    header = [len(glyphs), FLAG_MASKED if masked else 0]
+    index = []
+    if masked:
+        offset = len(header) + 2 * ((len(glyphs) + BLOCK - 1) // BLOCK)
+        for first in range(0, len(glyphs), BLOCK):
+            index += [offset & 0xFF, offset >> 8]
+            offset += sum(len(record) for record in records[first:first + BLOCK])
+        if offset > 0xFFFF:
+            sys.exit("font does not fit in 64 KiB")
+    return header, index, records
+
+
+def describe(glyph_id, glyph):
+    return f"{glyph_id:3d}: {glyph.name}, advance {glyph.advance}"
+
+
+def emit_packed(symbol, glyphs, masked):
+    header, index, records = compile_font(glyphs, masked)
+    size = len(header) + len(index) + sum(len(record) for record in records)
+    lines = [
+        "/**",
+        f" * @brief {len(glyphs)} packed 5x8 glyphs ({size} bytes, "
+        f"{len(glyphs) * ROWS} unpacked), decoded by CGRAM_UnpackGlyph.",
+        " */",
+        f"static const uint8_t {symbol}[{size}] PROGMEM = {{",
+        f"    {header[0]:3d}, 0x{header[1]:02X}, /**< Glyph count, flags */",
+    ]
+    pairs = [f"0x{index[i]:02X}, 0x{index[i + 1]:02X}" for i in range(0, len(index), 2)]
+    for first in range(0, len(pairs), 4):
+        note = " /**< Offsets of every 8th glyph */" if first == 0 else ""
+        lines.append("    " + ", ".join(pairs[first:first + 4]) + "," + note)
+    for glyph_id, (glyph, record) in enumerate(zip(glyphs, records)):
+        data = ", ".join(f"0x{byte:02X}" for byte in record)
+        comma = "," if glyph_id < len(glyphs) - 1 else ""
+        lines.append(f"    {data}{comma} /**< {describe(glyph_id, glyph)} */")
+    lines.append("};")
+    return lines, size
+
+
+def emit_custom(symbol, glyphs):
+    lines = [
+        "/**",
+        f" * @brief {len(glyphs)} 5x8 glyphs for LCD_DefineCustomChar_P.",
+        " */",
+        f"static const CustomChar_t {symbol}[{len(glyphs)}] PROGMEM = {{",
+    ]
+    for glyph_id, glyph in enumerate(glyphs):
+        data = ", ".join(f"0x{row:02X}" for row in glyph.rows)
+        comma = "," if glyph_id < len(glyphs) - 1 else ""
+        lines.append(f"    {{{{{data}}}, {glyph_id % BLOCK}}}{comma} /**< {describe(glyph_id, glyph)} */")
+    lines.append("};")
+    return lines, len(glyphs) * (ROWS + 1)
+
+
+def emit_letters(symbol, letter_type, join_prefix, glyphs):
+    letters = {}
+    for glyph_id, glyph in enumerate(glyphs):
+        if glyph.code_point is None:
+            continue
+        name = glyph.name
+        if name.rsplit(" ", 1)[-1] in FORMS:
+            name = name.rsplit(" ", 1)[0]
+        letter = letters.setdefault(glyph.code_point, {"name": name})
+        for form in glyph.forms or ["isolated"]:
+            if form in letter:
+                sys.exit(f"U+{glyph.code_point:04X}: two glyphs for the {form} form")
+            letter[form] = glyph_id
+    if not letters:
+        sys.exit("--letters needs glyphs with a code point")
+
+    first, last = min(letters), max(letters)
+    lines = [
+        "/**",
+        f" * @brief Joining class and glyph IDs of U+{first:04X} to U+{last:04X}, indexed by",
+        f" *        (code point - 0x{first:04X}).",
+        " */",
+        f"static const {letter_type} {symbol}[{last - first + 1}] PROGMEM = {{",
+    ]
+    width = len(join_prefix) + len("RIGHT,")
+    for code_point in range(first, last + 1):
+        letter = letters.get(code_point)
+        comma = "," if code_point < last else " "
+        if letter is None or "isolated" not in letter:
+            join, ids, name = "NONE", [NO_GLYPH] * 4, "(not supported)"
+        else:
+            isolated = letter["isolated"]
+            final = letter.get("final", isolated)
+            ids = [isolated, final, letter.get("initial", isolated), letter.get("medial", final)]
+            if "initial" in letter or "medial" in letter:
+                join = "DUAL"
+            elif "final" in letter:
+                join = "RIGHT"
+            else:
+                join = "NONE"
+            name = letter["name"]
+        forms = ", ".join(f"{glyph_id:3d}" for glyph_id in ids)
+        lines.append(f"    {{{(join_prefix + join + ','):<{width}} {{{forms}}}}}{comma}"
+                     f" /**< U+{code_point:04X} {name} */")
+    lines.append("};")
+    return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter,
+                                     epilog="\n".join(__doc__.splitlines()[2:]))
+    parser.add_argument("font", help="glyph source (.txt, .bdf, .pbm, .pgm or .ppm)")
+    parser.add_argument("-o", "--output", required=True, help="header to write")
+    parser.add_argument("--symbol", required=True, help="name of the glyph array")
+    parser.add_argument("--format", choices=("packed", "custom"), default="packed")
+    parser.add_argument("--fixed", action="store_true",
+                        help="packed: always store 40 bits per glyph, no row mask")
+    parser.add_argument("--letters", metavar="SYMBOL", help="also emit the shaping table")
+    parser.add_argument("--letter-type", default="ARABIC_Letter_t")
+    parser.add_argument("--join-prefix", default="ARABIC_JOIN_")
+    parser.add_argument("--labels", help="image input: file with one cell label per line")
+    parser.add_argument("--cell", default="5x8",
+                        help="image input: cell pitch in image pixels before scaling (default 5x8)")
+    parser.add_argument("--scale", type=int, default=1,
+                        help="image input: image pixels per glyph pixel")
+    parser.add_argument("--guard", help="include guard (default: from the output name)")
+    args = parser.parse_args()
+
+    extension = os.path.splitext(args.font)[1].lower()
+    if extension == ".txt":
+        glyphs = parse_text(args.font)
+    elif extension == ".bdf":
+        glyphs = parse_bdf(args.font)
+    elif extension in (".pbm", ".pgm", ".ppm"):
+        labels = []
+        if args.labels:
+            with open(args.labels, encoding="utf-8") as source:
+                labels = [line.strip() for line in source
+                          if line.strip() and not line.startswith(";")]
+        cell = tuple(int(size) for size in args.cell.lower().split("x"))
+        if cell[0] < COLUMNS or cell[1] < ROWS:
+            sys.exit("--cell must be at least 5x8")
+        glyphs = parse_netpbm(args.font, labels, cell, args.scale)
+    else:
+        sys.exit(f"{args.font}: unknown input type")
+    if not 0 < len(glyphs) < 256:
+        sys.exit(f"{args.font}: a font holds 1 to 255 glyphs")
+
+    guard = args.guard
+    if guard is None:
+        name = os.path.basename(args.output)
+        guard = "".join(c if c.isalnum() else "_" for c in name).upper()
+
+    if args.format == "packed":
+        body, size = emit_packed(args.symbol, glyphs, not args.fixed)
+    else:
+        body, size = emit_custom(args.symbol, glyphs)
+    if args.letters:
+        body += [""] + emit_letters(args.letters, args.letter_type, args.join_prefix, glyphs)
+
+    source = os.path.relpath(args.font, os.path.dirname(os.path.abspath(args.output)))
+    lines = ["", "", f"#ifndef {guard}", f"#define {guard}", "",
+             f"/**< Generated by tools/glyphc.py from {source.replace(os.sep, '/')}, do not edit. */",
+             ""] + body + ["", f"#endif /**< {guard} */", ""]
+    with open(args.output, "w", encoding="utf-8", newline="\n") as output:
+        output.write("\n".join(lines))
+    print(f"{args.output}: {len(glyphs)} glyphs, {size} bytes ({len(glyphs) * ROWS} unpacked)")
+
+
+if __name__ == "__main__":
+    main()